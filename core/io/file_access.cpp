@@ -39,6 +39,7 @@
 #include "core/os/os.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
+FileAccess::CreateFunc FileAccess::create_mapped_func = nullptr;
 
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
@@ -158,6 +159,34 @@ Ref<FileAccess> FileAccess::open_encrypted_pass(const String &p_path, ModeFlags
 	return fae;
 }
 
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	if (!create_mapped_func) {
+		if (r_error) {
+			*r_error = ERR_UNAVAILABLE;
+		}
+		return Ref<FileAccess>();
+	}
+
+	Ref<FileAccess> ret = create_mapped_func();
+	if (p_path.begins_with("res://")) {
+		ret->_set_access_type(ACCESS_RESOURCES);
+	} else if (p_path.begins_with("user://")) {
+		ret->_set_access_type(ACCESS_USERDATA);
+	} else {
+		ret->_set_access_type(ACCESS_FILESYSTEM);
+	}
+
+	Error err = ret->open_internal(p_path, READ);
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		ret.unref();
+	}
+
+	return ret;
+}
+
 Ref<FileAccess> FileAccess::open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode) {
 	Ref<FileAccessCompressed> fac;
 	fac.instantiate();
@@ -115,6 +115,7 @@ private:
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static CreateFunc create_mapped_func; /** read-only memory-mapped file access creation function, if the platform has one */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
 		return memnew(T);
@@ -150,6 +151,13 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	/**
+	 * Get a read-only pointer to the next p_length bytes without copying them, and advance the position.
+	 * Returns nullptr (without moving) if the implementation can't provide zero-copy access or the range
+	 * is not fully available, in which case get_buffer() should be used instead.
+	 * The pointer is only valid while this file stays open.
+	 */
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -201,6 +209,7 @@ public:
 
 	static Ref<FileAccess> open_encrypted(const String &p_path, ModeFlags p_mode_flags, const Vector<uint8_t> &p_key);
 	static Ref<FileAccess> open_encrypted_pass(const String &p_path, ModeFlags p_mode_flags, const String &p_pass);
+	static Ref<FileAccess> open_mapped(const String &p_path, Error *r_error = nullptr); /// Open a file read-only through a memory mapping, fails with ERR_UNAVAILABLE if the platform doesn't support it.
 	static Ref<FileAccess> open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode = COMPRESSION_FASTLZ);
 	static Error get_open_error();
 
@@ -233,6 +242,11 @@ public:
 		create_func[p_access] = _create_builtin<T>;
 	}
 
+	template <typename T>
+	static void make_mapped_default() {
+		create_mapped_func = _create_builtin<T>;
+	}
+
 	FileAccess() {}
 	virtual ~FileAccess() {}
 };
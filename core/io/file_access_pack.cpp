@@ -102,6 +102,33 @@ void PackedData::add_pack_source(PackSource *p_source) {
 	}
 }
 
+const PackedData::MappedPack &PackedData::_get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+
+	HashMap<String, MappedPack>::Iterator E = mapped_packs.find(p_pack);
+	if (E) {
+		return E->value;
+	}
+
+	// Map the whole pack once; failures are remembered too, so we don't retry on every open.
+	MappedPack mp;
+	Ref<FileAccess> fm = FileAccess::open_mapped(p_pack);
+	if (fm.is_valid()) {
+		uint64_t length = fm->get_length();
+		const uint8_t *data = fm->get_buffer_view(length);
+		if (data) {
+			mp.file = fm;
+			mp.data = data;
+			mp.length = length;
+		}
+	}
+	if (mp.file.is_null()) {
+		print_verbose("Can't memory-map pack '" + p_pack + "', falling back to buffered reads.");
+	}
+
+	return mapped_packs.insert(p_pack, mp)->value;
+}
+
 PackedData *PackedData::singleton = nullptr;
 
 PackedData::PackedData() {
@@ -273,7 +300,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped_data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -281,7 +310,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped_data, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -289,7 +318,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -310,18 +341,67 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped_data, 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (mapped_data) {
+		return mapped_data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
 
+uint16_t FileAccessPack::get_16() const {
+	if (!mapped_data) {
+		return FileAccess::get_16();
+	}
+
+	uint16_t b = 0;
+	get_buffer((uint8_t *)&b, 2);
+
+	if (big_endian) {
+		b = BSWAP16(b);
+	}
+
+	return b;
+}
+
+uint32_t FileAccessPack::get_32() const {
+	if (!mapped_data) {
+		return FileAccess::get_32();
+	}
+
+	uint32_t b = 0;
+	get_buffer((uint8_t *)&b, 4);
+
+	if (big_endian) {
+		b = BSWAP32(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessPack::get_64() const {
+	if (!mapped_data) {
+		return FileAccess::get_64();
+	}
+
+	uint64_t b = 0;
+	get_buffer((uint8_t *)&b, 8);
+
+	if (big_endian) {
+		b = BSWAP64(b);
+	}
+
+	return b;
+}
+
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped_data, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -339,16 +419,33 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (mapped_data) {
+		memcpy(p_dst, mapped_data + pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	if (!mapped_data || eof || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = mapped_data + pos;
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped_data, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -376,15 +473,30 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = Ref<FileAccess>();
+	mapped_data = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	// Encrypted files are decrypted into memory as a whole anyway, so only plain files benefit from the mapping.
+	if (!pf.encrypted && PackedData::get_singleton()->is_using_mmap()) {
+		const PackedData::MappedPack &mp = PackedData::get_singleton()->_get_mapped_pack(pf.pack);
+		if (mp.data && pf.offset <= mp.length && pf.size <= mp.length - pf.offset) {
+			mapped = mp.file;
+			mapped_data = mp.data + pf.offset;
+			return;
+		}
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -402,8 +514,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -97,6 +98,13 @@ private:
 		}
 	};
 
+	// A pack file mapped into memory once and shared by all the files read from it.
+	struct MappedPack {
+		Ref<FileAccess> file; // Keeps the mapping alive, null if the pack couldn't be mapped.
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+	};
+
 	HashMap<PathMD5, PackedFile, PathMD5> files;
 
 	Vector<PackSource *> sources;
@@ -106,7 +114,12 @@ private:
 	static PackedData *singleton;
 	bool disabled = false;
 
+	bool use_mmap = true;
+	HashMap<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
 	void _free_packed_dirs(PackedDir *p_dir);
+	const MappedPack &_get_mapped_pack(const String &p_pack);
 
 public:
 	void add_pack_source(PackSource *p_source);
@@ -115,6 +128,9 @@ public:
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	void set_use_mmap(bool p_enable) { use_mmap = p_enable; }
+	_FORCE_INLINE_ bool is_using_mmap() const { return use_mmap; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -149,6 +165,11 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+
+	// When the pack is memory-mapped, reads are served straight from the mapping and `f` stays null.
+	Ref<FileAccess> mapped;
+	const uint8_t *mapped_data = nullptr;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -170,8 +191,12 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint8_t get_8() const override;
+	virtual uint16_t get_16() const override;
+	virtual uint32_t get_32() const override;
+	virtual uint64_t get_64() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
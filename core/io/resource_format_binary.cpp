@@ -163,8 +163,13 @@ StringName ResourceLoaderBinary::_get_string() {
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
 		String s;
+		const uint8_t *view = f->get_buffer_view(len);
+		if (view) {
+			s.parse_utf8((const char *)view, len);
+			return s;
+		}
+		f->get_buffer((uint8_t *)&str_buf[0], len);
 		s.parse_utf8(&str_buf[0]);
 		return s;
 	}
@@ -910,8 +915,14 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
+	const uint8_t *view = f->get_buffer_view(len);
+	if (view) {
+		// Parse in place when the file is memory-mapped.
+		s.parse_utf8((const char *)view, len);
+		return s;
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], len);
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  bvh_leaf_cull.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BVH_LEAF_CULL_H
+#define BVH_LEAF_CULL_H
+
+// Tests a query box against every item of a BVH leaf at once.
+// The leaf keeps a structure of arrays copy of its item bounds (one array per axis for the
+// mins, and one for the negated maxs), so the test can run 4 or 8 items wide.
+// The instruction set is chosen at build time from what the compiler targets:
+// AVX (8 wide), SSE2 or NEON (4 wide), otherwise a scalar loop.
+// Define BVH_LEAF_CULL_NO_SIMD to force the scalar loop.
+// Results match BVH_ABB::intersects_swizzled() exactly, including for NaN bounds.
+
+#include "core/math/math_defs.h"
+#include "core/typedefs.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && !defined(BVH_LEAF_CULL_NO_SIMD)
+#if defined(__AVX__)
+#define BVH_LEAF_CULL_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BVH_LEAF_CULL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define BVH_LEAF_CULL_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+// Items in the structure of arrays are padded to a multiple of this,
+// so the widest loop never reads past the end of the arrays.
+#define BVH_LEAF_CULL_PADDING 8
+
+template <int AXIS_COUNT>
+struct BVH_LeafCull {
+	// Number of items tested per iteration by cull().
+	static constexpr int get_width() {
+#if defined(BVH_LEAF_CULL_AVX)
+		return 8;
+#elif defined(BVH_LEAF_CULL_SSE2) || defined(BVH_LEAF_CULL_NEON)
+		return 4;
+#else
+		return 1;
+#endif
+	}
+
+	// p_mins and p_neg_maxs point to AXIS_COUNT arrays of p_stride reals each.
+	// p_query_max and p_query_neg_min are the query box, swizzled like in intersects_swizzled().
+	// Writes the indices of the overlapping items to r_hits, in increasing order, and returns their count.
+	static uint32_t cull_scalar(const real_t *p_mins, const real_t *p_neg_maxs, uint32_t p_stride, uint32_t p_count, const real_t *p_query_max, const real_t *p_query_neg_min, uint32_t *r_hits) {
+		uint32_t num_hits = 0;
+		for (uint32_t n = 0; n < p_count; n++) {
+			bool miss = false;
+			for (int axis = 0; axis < AXIS_COUNT; axis++) {
+				miss |= p_query_max[axis] < p_mins[axis * p_stride + n];
+				miss |= p_query_neg_min[axis] < p_neg_maxs[axis * p_stride + n];
+			}
+			if (!miss) {
+				r_hits[num_hits++] = n;
+			}
+		}
+		return num_hits;
+	}
+
+	static uint32_t cull(const real_t *p_mins, const real_t *p_neg_maxs, uint32_t p_stride, uint32_t p_count, const real_t *p_query_max, const real_t *p_query_neg_min, uint32_t *r_hits) {
+#if defined(BVH_LEAF_CULL_AVX)
+		__m256 query_max[AXIS_COUNT];
+		__m256 query_neg_min[AXIS_COUNT];
+		for (int axis = 0; axis < AXIS_COUNT; axis++) {
+			query_max[axis] = _mm256_set1_ps(p_query_max[axis]);
+			query_neg_min[axis] = _mm256_set1_ps(p_query_neg_min[axis]);
+		}
+
+		uint32_t num_hits = 0;
+		for (uint32_t base = 0; base < p_count; base += 8) {
+			__m256 miss = _mm256_setzero_ps();
+			for (int axis = 0; axis < AXIS_COUNT; axis++) {
+				miss = _mm256_or_ps(miss, _mm256_cmp_ps(query_max[axis], _mm256_loadu_ps(p_mins + axis * p_stride + base), _CMP_LT_OQ));
+				miss = _mm256_or_ps(miss, _mm256_cmp_ps(query_neg_min[axis], _mm256_loadu_ps(p_neg_maxs + axis * p_stride + base), _CMP_LT_OQ));
+			}
+			uint32_t hit_bits = ~uint32_t(_mm256_movemask_ps(miss)) & _lane_mask(p_count - base, 8);
+			num_hits = _append_hits(hit_bits, base, 8, r_hits, num_hits);
+		}
+		return num_hits;
+#elif defined(BVH_LEAF_CULL_SSE2)
+		__m128 query_max[AXIS_COUNT];
+		__m128 query_neg_min[AXIS_COUNT];
+		for (int axis = 0; axis < AXIS_COUNT; axis++) {
+			query_max[axis] = _mm_set1_ps(p_query_max[axis]);
+			query_neg_min[axis] = _mm_set1_ps(p_query_neg_min[axis]);
+		}
+
+		uint32_t num_hits = 0;
+		for (uint32_t base = 0; base < p_count; base += 4) {
+			__m128 miss = _mm_setzero_ps();
+			for (int axis = 0; axis < AXIS_COUNT; axis++) {
+				miss = _mm_or_ps(miss, _mm_cmplt_ps(query_max[axis], _mm_loadu_ps(p_mins + axis * p_stride + base)));
+				miss = _mm_or_ps(miss, _mm_cmplt_ps(query_neg_min[axis], _mm_loadu_ps(p_neg_maxs + axis * p_stride + base)));
+			}
+			uint32_t hit_bits = ~uint32_t(_mm_movemask_ps(miss)) & _lane_mask(p_count - base, 4);
+			num_hits = _append_hits(hit_bits, base, 4, r_hits, num_hits);
+		}
+		return num_hits;
+#elif defined(BVH_LEAF_CULL_NEON)
+		float32x4_t query_max[AXIS_COUNT];
+		float32x4_t query_neg_min[AXIS_COUNT];
+		for (int axis = 0; axis < AXIS_COUNT; axis++) {
+			query_max[axis] = vdupq_n_f32(p_query_max[axis]);
+			query_neg_min[axis] = vdupq_n_f32(p_query_neg_min[axis]);
+		}
+		static const uint32_t lane_bit_values[4] = { 1, 2, 4, 8 };
+		const uint32x4_t lane_bits = vld1q_u32(lane_bit_values);
+
+		uint32_t num_hits = 0;
+		for (uint32_t base = 0; base < p_count; base += 4) {
+			uint32x4_t miss = vdupq_n_u32(0);
+			for (int axis = 0; axis < AXIS_COUNT; axis++) {
+				miss = vorrq_u32(miss, vcltq_f32(query_max[axis], vld1q_f32(p_mins + axis * p_stride + base)));
+				miss = vorrq_u32(miss, vcltq_f32(query_neg_min[axis], vld1q_f32(p_neg_maxs + axis * p_stride + base)));
+			}
+			// Gather one bit per lane, like movemask.
+			uint32x4_t bits = vandq_u32(miss, lane_bits);
+			uint32x2_t pair_sums = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+			uint32_t miss_bits = vget_lane_u32(vpadd_u32(pair_sums, pair_sums), 0);
+			uint32_t hit_bits = ~miss_bits & _lane_mask(p_count - base, 4);
+			num_hits = _append_hits(hit_bits, base, 4, r_hits, num_hits);
+		}
+		return num_hits;
+#else
+		return cull_scalar(p_mins, p_neg_maxs, p_stride, p_count, p_query_max, p_query_neg_min, r_hits);
+#endif
+	}
+
+private:
+	static _FORCE_INLINE_ uint32_t _lane_mask(uint32_t p_remaining, uint32_t p_width) {
+		return p_remaining >= p_width ? (1u << p_width) - 1 : (1u << p_remaining) - 1;
+	}
+
+	static _FORCE_INLINE_ uint32_t _append_hits(uint32_t p_hit_bits, uint32_t p_base, uint32_t p_width, uint32_t *r_hits, uint32_t p_num_hits) {
+		for (uint32_t lane = 0; p_hit_bits && lane < p_width; lane++, p_hit_bits >>= 1) {
+			if (p_hit_bits & 1) {
+				r_hits[p_num_hits++] = p_base + lane;
+			}
+		}
+		return p_num_hits;
+	}
+};
+
+#endif // BVH_LEAF_CULL_H
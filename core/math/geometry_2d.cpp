@@ -71,6 +71,87 @@ Vector<Vector<Vector2>> Geometry2D::decompose_polygon_in_convex(const Vector<Poi
 	return decomp;
 }
 
+static void _polytree_to_tppl_polys(const Clipper2Lib::PolyPathD *p_polypath, List<TPPLPoly> &r_polys) {
+	using namespace Clipper2Lib;
+
+	const PathD &path = p_polypath->Polygon();
+	TPPLPoly tp;
+	tp.Init(path.size());
+	for (PathD::size_type i = 0; i < path.size(); ++i) {
+		tp.GetPoint(i) = Point2(static_cast<real_t>(path[i].x), static_cast<real_t>(path[i].y));
+	}
+	if (p_polypath->IsHole()) {
+		tp.SetOrientation(TPPL_ORIENTATION_CW);
+		tp.SetHole(true);
+	} else {
+		tp.SetOrientation(TPPL_ORIENTATION_CCW);
+	}
+	r_polys.push_back(tp);
+
+	for (size_t i = 0; i < p_polypath->Count(); i++) {
+		_polytree_to_tppl_polys(p_polypath->Child(i), r_polys);
+	}
+}
+
+Vector<Vector<Vector2>> Geometry2D::merge_and_decompose_polygons_in_convex(const Vector<Vector<Point2>> &p_polygons) {
+	using namespace Clipper2Lib;
+
+	Vector<Vector<Vector2>> decomp;
+
+	PathsD paths;
+	paths.reserve(p_polygons.size());
+	for (const Vector<Point2> &polygon : p_polygons) {
+		if (polygon.size() < 3) {
+			continue;
+		}
+		PathD path(polygon.size());
+		for (int i = 0; i != polygon.size(); ++i) {
+			path[i] = PointD(polygon[i].x, polygon[i].y);
+		}
+		if (!IsPositive(path)) {
+			std::reverse(path.begin(), path.end());
+		}
+		paths.push_back(path);
+	}
+	if (paths.empty()) {
+		return decomp;
+	}
+
+	ClipperD clp(PRECISION); // Scale points up internally to attain the desired precision.
+	clp.PreserveCollinear(false); // Remove redundant vertices, so that adjacent polygons merge into a single outline.
+	clp.AddSubject(paths);
+
+	PolyTreeD tree; // Needed to know which outlines are holes.
+	clp.Execute(ClipType::Union, FillRule::NonZero, tree);
+
+	List<TPPLPoly> in_poly, out_poly;
+	for (size_t i = 0; i < tree.Count(); i++) {
+		_polytree_to_tppl_polys(tree[i], in_poly);
+	}
+
+	TPPLPartition tpart;
+	if (tpart.ConvexPartition_HM(&in_poly, &out_poly) == 0) { // Failed.
+		ERR_PRINT("Convex decomposing failed!");
+		return decomp;
+	}
+
+	decomp.resize(out_poly.size());
+	int idx = 0;
+	for (List<TPPLPoly>::Element *I = out_poly.front(); I; I = I->next()) {
+		TPPLPoly &tp = I->get();
+
+		decomp.write[idx].resize(tp.GetNumPoints());
+
+		for (int64_t i = 0; i < tp.GetNumPoints(); i++) {
+			decomp.write[idx].write[i] = tp.GetPoint(i);
+		}
+
+		idx++;
+	}
+
+	return decomp;
+}
+
 struct _AtlasWorkRect {
 	Size2i s;
 	Point2i p;
@@ -490,6 +490,8 @@ public:
 	}
 
 	static Vector<Vector<Vector2>> decompose_polygon_in_convex(const Vector<Point2> &polygon);
+	// Unions all the given polygons (holes included), then decomposes the result in convex polygons.
+	static Vector<Vector<Vector2>> merge_and_decompose_polygons_in_convex(const Vector<Vector<Point2>> &p_polygons);
 
 	static void make_atlas(const Vector<Size2i> &p_rects, Vector<Point2i> &r_result, Size2i &r_size);
 	static Vector<Vector3i> partial_pack_rects(const Vector<Vector2i> &p_sizes, const Size2i &p_atlas_size);
@@ -542,6 +542,21 @@ Object *ClassDB::instantiate_no_placeholders(const StringName &p_class) {
 	return _instantiate_internal(p_class, true);
 }
 
+ClassDB::CreationFunc ClassDB::get_native_creation_func(const StringName &p_class) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || ti->gdextension || ti->is_runtime) {
+		return nullptr;
+	}
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR || ti->api == API_EDITOR_EXTENSION) {
+		return nullptr;
+	}
+#endif
+	return ti->creation_func;
+}
+
 #ifdef TOOLS_ENABLED
 ObjectGDExtension *ClassDB::get_placeholder_extension(const StringName &p_class) {
 	ObjectGDExtension *placeholder_extension = placeholder_extensions.getptr(p_class);
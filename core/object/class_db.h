@@ -290,6 +290,9 @@ public:
 	static bool is_virtual(const StringName &p_class);
 	static Object *instantiate(const StringName &p_class);
 	static Object *instantiate_no_placeholders(const StringName &p_class);
+	// Native constructor instantiate() would end up calling, or nullptr when it needs more than that (extensions, placeholders, disabled or editor-only classes).
+	typedef Object *(*CreationFunc)();
+	static CreationFunc get_native_creation_func(const StringName &p_class);
 	static void set_object_extension_instance(Object *p_object, const StringName &p_class, GDExtensionClassInstancePtr p_instance);
 
 	static APIType get_api_type(const StringName &p_class);
@@ -1003,6 +1003,21 @@ public:
 	virtual ~Object();
 };
 
+#ifdef DEBUG_ENABLED
+// Prevents an object from being freed while one of its methods is running.
+struct _ObjectDebugLock {
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+#endif
+
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
@@ -84,21 +84,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		bool do_post = false;
 
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			uint32_t batch_begin = p_task->group->index.postadd(p_task->group->batch_size);
 
-			if (work_index >= p_task->group->max) {
+			if (batch_begin >= p_task->group->max) {
 				break;
 			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
+			uint32_t batch_end = MIN(batch_begin + p_task->group->batch_size, p_task->group->max);
+			for (uint32_t work_index = batch_begin; work_index < batch_end; work_index++) {
+				if (p_task->native_group_func) {
+					p_task->native_group_func(p_task->native_func_userdata, work_index);
+				} else if (p_task->template_userdata) {
+					p_task->template_userdata->callback_indexed(work_index);
+				} else {
+					p_task->callable.call(work_index);
+				}
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = p_task->group->completed_index.add(batch_end - batch_begin);
 
 			if (completed_amount == p_task->group->max) {
 				do_post = true;
@@ -175,20 +178,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Tasks in the deques (this thread's own, then other threads') are taken without locking.
+		Task *task_to_process = singleton->_take_deque_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
 			}
 			thread_data->signaled = false;
 
-			if (singleton->task_queue.first()) {
-				task_to_process = singleton->task_queue.first()->self();
-				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+			task_to_process = singleton->_take_queued_task();
+			if (!task_to_process) {
+				singleton->idle_threads.increment();
+				if (!singleton->_has_deque_tasks_after_going_idle()) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
+				singleton->idle_threads.decrement();
 			}
 		}
 
@@ -216,14 +222,23 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// Pool threads keep what they post in their own deque, where idle threads steal it from.
+	// The deque is pushed to after unlocking, so the mutex is only held for the bookkeeping.
+	Task **to_push = caller_pool_thread ? (Task **)alloca(sizeof(Task *) * p_count) : nullptr;
+	uint32_t to_push_count = 0;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (caller_pool_thread) {
+				to_push[to_push_count++] = p_tasks[i];
+			} else {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+				to_process++;
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
-			to_process++;
 		} else {
 			// Too many threads using low priority, must go to queue.
 			low_priority_task_queue.add_last(&p_tasks[i]->task_elem);
@@ -234,6 +249,35 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 
 	task_mutex.unlock();
+
+	if (to_push_count) {
+		_push_deque_tasks(caller_pool_thread, to_push, to_push_count);
+	}
+}
+
+void WorkerThreadPool::_push_deque_tasks(ThreadData *p_caller_pool_thread, Task **p_tasks, uint32_t p_count) {
+	uint32_t pushed = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (p_caller_pool_thread->deque.push(p_tasks[i])) {
+			pushed++;
+		} else {
+			// The deque is full, overflow to the shared queue.
+			MutexLock lock(task_mutex);
+			task_queue.add_last(&p_tasks[i]->task_elem);
+			_notify_threads(p_caller_pool_thread, 1, 0);
+		}
+	}
+
+	if (pushed) {
+		// Pairs with the fence in _has_deque_tasks_after_going_idle(): either a thread going idle sees the
+		// new tasks, or this sees it idle and wakes it up. Nobody is woken up while every thread is busy,
+		// they will find the tasks when they look for more work.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (idle_threads.get() > 0) {
+			MutexLock lock(task_mutex);
+			_notify_threads(p_caller_pool_thread, pushed, 0);
+		}
+	}
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -300,6 +344,50 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_take_deque_task(ThreadData *p_thread_data) {
+	// Lock-free. Own tasks first (newest, likely hot in cache), then the oldest task of another thread.
+	Task *task = nullptr;
+	if (p_thread_data->deque.pop(task)) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		if (threads[(p_thread_data->index + i) % thread_count].deque.steal(task)) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_take_queued_task() {
+	// Must be called with task_mutex locked.
+	if (task_queue.first()) {
+		Task *task = task_queue.first()->self();
+		task_queue.remove(task_queue.first());
+		return task;
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_stealable_tasks() const {
+	for (const ThreadData &th : threads) {
+		if (!th.deque.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool WorkerThreadPool::_has_deque_tasks_after_going_idle() const {
+	// Must be called with task_mutex locked, after incrementing idle_threads.
+	// Deques are pushed to without the mutex, so this is the last chance to see a task posted
+	// by a thread that did not see this one idle (see _push_deque_tasks()).
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	return _has_stealable_tasks();
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -423,6 +511,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 
 	while (true) {
 		Task *task_to_process = nullptr;
+		bool look_in_deques = false;
 		{
 			MutexLock lock(task_mutex);
 			bool was_signaled = p_caller_pool_thread->signaled;
@@ -433,7 +522,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_stealable_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -452,24 +541,34 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
-					task_to_process = task_queue.first()->self();
-					task_queue.remove(task_queue.first());
-				}
-
-				if (!task_to_process) {
-					p_caller_pool_thread->awaited_task = p_task;
+				task_to_process = _take_queued_task();
+				look_in_deques = !task_to_process;
+			}
+		}
 
-					if (flushing_cmd_queue) {
-						flushing_cmd_queue->unlock();
+		if (look_in_deques) {
+			// The deques are looked into without holding the mutex.
+			task_to_process = _take_deque_task(p_caller_pool_thread);
+			if (!task_to_process) {
+				MutexLock lock(task_mutex);
+				// Whatever happened while unlocked (the awaited task completing, a notification, a queued task) is handled by looping again.
+				if (!IS_WAIT_OVER && !p_caller_pool_thread->signaled && !exit_threads && !task_queue.first()) {
+					idle_threads.increment();
+					if (!_has_deque_tasks_after_going_idle()) {
+						p_caller_pool_thread->awaited_task = p_task;
+
+						if (flushing_cmd_queue) {
+							flushing_cmd_queue->unlock();
+						}
+						p_caller_pool_thread->cond_var.wait(lock);
+						if (flushing_cmd_queue) {
+							flushing_cmd_queue->lock();
+						}
+
+						DEV_ASSERT(exit_threads || p_caller_pool_thread->signaled || IS_WAIT_OVER);
+						p_caller_pool_thread->awaited_task = nullptr;
 					}
-					p_caller_pool_thread->cond_var.wait(lock);
-					if (flushing_cmd_queue) {
-						flushing_cmd_queue->lock();
-					}
-
-					DEV_ASSERT(exit_threads || p_caller_pool_thread->signaled || IS_WAIT_OVER);
-					p_caller_pool_thread->awaited_task = nullptr;
+					idle_threads.decrement();
 				}
 			}
 		}
@@ -536,6 +635,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	} else {
 		group->tasks_used = p_tasks;
+		group->batch_size = MAX(1u, uint32_t(p_elements) / (uint32_t(p_tasks) * 16));
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class CommandQueueMT;
 
@@ -71,6 +72,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		uint32_t batch_size = 1; // Elements claimed at once from index, to keep the counters cool.
 	};
 
 	struct Task {
@@ -105,7 +107,7 @@ private:
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
+	SelfList<Task>::List task_queue; // Injection queue, for tasks posted from outside the pool (or overflowing a deque).
 
 	BinaryMutex task_mutex;
 
@@ -120,6 +122,8 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		// Tasks posted by this thread. Pushed and popped by this thread, stolen by the others, all lock-free.
+		WorkStealingDeque<Task *> deque;
 
 		ThreadData() :
 				ready_for_scripting(false),
@@ -161,6 +165,15 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	// Pool threads going to sleep, so threads pushing to their deque without the mutex know if someone must be woken up.
+	SafeNumeric<uint32_t> idle_threads;
+
+	void _push_deque_tasks(ThreadData *p_caller_pool_thread, Task **p_tasks, uint32_t p_count);
+	Task *_take_deque_task(ThreadData *p_thread_data);
+	Task *_take_queued_task();
+	bool _has_stealable_tasks() const;
+	bool _has_deque_tasks_after_going_idle() const;
+
 	static WorkerThreadPool *singleton;
 
 	static thread_local CommandQueueMT *flushing_cmd_queue;
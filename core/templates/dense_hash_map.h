@@ -0,0 +1,538 @@
+/**************************************************************************/
+/*  dense_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef DENSE_HASH_MAP_H
+#define DENSE_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * A compact, insertion-ordered hash map.
+ *
+ * Key/value pairs are stored densely in insertion order, and a separate
+ * open-addressing table of (hash, position) slots is used to find them. This
+ * makes iteration a linear walk over memory and allows O(1) access by
+ * insertion index (O(log n) while tombstones are pending, see below), at the
+ * cost of slightly more expensive erasure.
+ *
+ * Entries live in pages whose size doubles, so growing the map never moves
+ * existing entries: pointers returned by getptr() or operator[] stay valid
+ * across insertions. Erasing leaves a tombstone which is removed by a later
+ * erase() compacting the entries once there are enough of them; compaction
+ * moves entries, so any pointer obtained before an erase() must be considered
+ * invalid afterwards. Reads never move entries nor modify the map. While
+ * tombstones are pending, a Fenwick tree counting the live entries by position
+ * is kept up to date by writes, so indexed access can skip them quickly.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class DenseHashMap {
+public:
+	static constexpr uint32_t EMPTY_HASH = 0;
+	static constexpr uint32_t MIN_INDEX_CAPACITY = 8; // Must be a power of two.
+	static constexpr uint32_t FIRST_PAGE_SHIFT = 3; // The first page holds 8 entries, each next one doubles.
+	static constexpr uint32_t MIN_TOMBSTONES_TO_COMPACT = 8;
+
+private:
+	static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+	static constexpr uint32_t ERASED_SLOT = UINT32_MAX - 1;
+
+	struct Slot {
+		uint32_t hash;
+		uint32_t position;
+	};
+
+	typedef KeyValue<TKey, TValue> Element;
+
+	// Entries are raw storage, the element is only constructed while the entry is live.
+	struct Entry {
+		uint32_t hash; // EMPTY_HASH marks a tombstone.
+		alignas(Element) uint8_t data[sizeof(Element)];
+
+		_FORCE_INLINE_ Element &get() { return *reinterpret_cast<Element *>(data); }
+		_FORCE_INLINE_ const Element &get() const { return *reinterpret_cast<const Element *>(data); }
+	};
+
+	LocalVector<Entry *> pages;
+	Slot *slots = nullptr;
+	uint32_t slot_capacity = 0; // Always zero or a power of two.
+	uint32_t slots_used = 0; // Includes erased slots.
+	uint32_t entry_count = 0; // Includes tombstones.
+	uint32_t num_elements = 0;
+	LocalVector<uint32_t> live_tree; // Fenwick tree of live entries (1-based), empty unless tombstones were left.
+
+	static _FORCE_INLINE_ uint32_t _msb(uint32_t p_value) {
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(p_value);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, p_value);
+		return index;
+#else
+		uint32_t index = 0;
+		while (p_value >>= 1) {
+			index++;
+		}
+		return index;
+#endif
+	}
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+		return hash;
+	}
+
+	_FORCE_INLINE_ Entry *_get_entry(uint32_t p_position) const {
+		// Page p starts at position ((1 << p) - 1) << FIRST_PAGE_SHIFT.
+		const uint32_t biased = p_position + (1u << FIRST_PAGE_SHIFT);
+		const uint32_t msb = _msb(biased);
+		return &pages[msb - FIRST_PAGE_SHIFT][biased - (1u << msb)];
+	}
+
+	_FORCE_INLINE_ uint32_t _get_entry_capacity() const {
+		return ((1u << pages.size()) - 1) << FIRST_PAGE_SHIFT;
+	}
+
+	// Returns the slot holding p_key, or EMPTY_SLOT.
+	uint32_t _lookup_slot(const TKey &p_key, uint32_t p_hash) const {
+		if (num_elements == 0) {
+			return EMPTY_SLOT;
+		}
+		const uint32_t mask = slot_capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (true) {
+			const Slot &slot = slots[pos];
+			if (slot.position == EMPTY_SLOT) {
+				return EMPTY_SLOT;
+			}
+			if (slot.position != ERASED_SLOT && slot.hash == p_hash && Comparator::compare(_get_entry(slot.position)->get().key, p_key)) {
+				return pos;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	void _place_slot(uint32_t p_hash, uint32_t p_position) {
+		const uint32_t mask = slot_capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (slots[pos].position < ERASED_SLOT) {
+			pos = (pos + 1) & mask;
+		}
+		if (slots[pos].position == EMPTY_SLOT) {
+			slots_used++;
+		}
+		slots[pos].hash = p_hash;
+		slots[pos].position = p_position;
+	}
+
+	void _rebuild_slots(uint32_t p_min_elements) {
+		uint32_t capacity = MAX(MIN_INDEX_CAPACITY, next_power_of_2(p_min_elements * 2));
+		if (capacity != slot_capacity) {
+			if (slots) {
+				Memory::free_static(slots);
+			}
+			slots = static_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * capacity));
+			slot_capacity = capacity;
+		}
+		for (uint32_t i = 0; i < slot_capacity; i++) {
+			slots[i].position = EMPTY_SLOT;
+		}
+		slots_used = 0;
+		for (uint32_t i = 0; i < entry_count; i++) {
+			const Entry *entry = _get_entry(i);
+			if (entry->hash != EMPTY_HASH) {
+				_place_slot(entry->hash, i);
+			}
+		}
+	}
+
+	// The tree covers the whole entry capacity, rounded to a power of two so it can be searched by bisection.
+	void _build_live_tree() {
+		const uint32_t size = 1u << (pages.size() + FIRST_PAGE_SHIFT);
+		live_tree.resize(size + 1);
+		for (uint32_t i = 1; i <= size; i++) {
+			live_tree[i] = (i <= entry_count && _get_entry(i - 1)->hash != EMPTY_HASH) ? 1 : 0;
+		}
+		for (uint32_t i = 1; i <= size; i++) {
+			const uint32_t parent = i + (i & (~i + 1));
+			if (parent <= size) {
+				live_tree[parent] += live_tree[i];
+			}
+		}
+	}
+
+	void _update_live_tree(uint32_t p_position, int32_t p_delta) {
+		const uint32_t size = live_tree.size() - 1;
+		for (uint32_t i = p_position + 1; i <= size; i += i & (~i + 1)) {
+			live_tree[i] += p_delta;
+		}
+	}
+
+	// Moves live entries over the tombstones, keeping their order.
+	void _compact() {
+		uint32_t dst = 0;
+		for (uint32_t src = 0; src < entry_count; src++) {
+			Entry *from = _get_entry(src);
+			if (from->hash == EMPTY_HASH) {
+				continue;
+			}
+			if (src != dst) {
+				Entry *to = _get_entry(dst);
+				memnew_placement(to->data, Element(from->get()));
+				to->hash = from->hash;
+				from->get().~Element();
+				from->hash = EMPTY_HASH;
+			}
+			dst++;
+		}
+		entry_count = dst;
+		live_tree.clear();
+		_rebuild_slots(num_elements);
+	}
+
+	Entry *_insert(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if ((slots_used + 1) * 4 > slot_capacity * 3) {
+			_rebuild_slots(num_elements + 1);
+		}
+		bool grown = false;
+		if (entry_count == _get_entry_capacity()) {
+			pages.push_back(static_cast<Entry *>(Memory::alloc_static(sizeof(Entry) * ((1u << FIRST_PAGE_SHIFT) << pages.size()))));
+			grown = true;
+		}
+		Entry *entry = _get_entry(entry_count);
+		memnew_placement(entry->data, Element(p_key, p_value));
+		entry->hash = p_hash;
+		_place_slot(p_hash, entry_count);
+		entry_count++;
+		num_elements++;
+		if (!live_tree.is_empty()) {
+			if (grown) {
+				_build_live_tree();
+			} else {
+				_update_live_tree(entry_count - 1, 1);
+			}
+		}
+		return entry;
+	}
+
+public:
+	struct ConstIterator;
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const { return map->_get_entry(position)->get(); }
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->_get_entry(position)->get(); }
+		_FORCE_INLINE_ Iterator &operator++() {
+			position = map->_next_position(position);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &p_it) const { return position == p_it.position; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &p_it) const { return position != p_it.position; }
+		_FORCE_INLINE_ explicit operator bool() const { return map && position < map->entry_count; }
+		_FORCE_INLINE_ operator ConstIterator() const { return ConstIterator(map, position); }
+
+		Iterator(const DenseHashMap *p_map, uint32_t p_position) :
+				map(p_map), position(p_position) {}
+		Iterator() {}
+
+	private:
+		const DenseHashMap *map = nullptr;
+		uint32_t position = 0;
+	};
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const { return map->_get_entry(position)->get(); }
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->_get_entry(position)->get(); }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			position = map->_next_position(position);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_it) const { return position == p_it.position; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_it) const { return position != p_it.position; }
+		_FORCE_INLINE_ explicit operator bool() const { return map && position < map->entry_count; }
+
+		ConstIterator(const DenseHashMap *p_map, uint32_t p_position) :
+				map(p_map), position(p_position) {}
+		ConstIterator() {}
+
+	private:
+		const DenseHashMap *map = nullptr;
+		uint32_t position = 0;
+	};
+
+private:
+	_FORCE_INLINE_ uint32_t _next_position(uint32_t p_position) const {
+		p_position++;
+		while (p_position < entry_count && _get_entry(p_position)->hash == EMPTY_HASH) {
+			p_position++;
+		}
+		return p_position;
+	}
+
+	// Returns the position of the live entry at p_index, skipping tombstones.
+	uint32_t _get_index_position(uint32_t p_index) const {
+		if (entry_count == num_elements) {
+			return p_index;
+		}
+		DEV_ASSERT(!live_tree.is_empty());
+		// Find the last position with at most p_index live entries before it.
+		const uint32_t size = live_tree.size() - 1;
+		uint32_t position = 0;
+		uint32_t remaining = p_index;
+		for (uint32_t step = size; step > 0; step >>= 1) {
+			if (position + step <= size && live_tree[position + step] <= remaining) {
+				position += step;
+				remaining -= live_tree[position];
+			}
+		}
+		return position;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+	_FORCE_INLINE_ bool is_empty() const { return num_elements == 0; }
+
+	void clear() {
+		for (uint32_t i = 0; i < entry_count; i++) {
+			Entry *entry = _get_entry(i);
+			if (entry->hash != EMPTY_HASH) {
+				entry->get().~Element();
+				entry->hash = EMPTY_HASH;
+			}
+		}
+		for (uint32_t i = 0; i < slot_capacity; i++) {
+			slots[i].position = EMPTY_SLOT;
+		}
+		slots_used = 0;
+		entry_count = 0;
+		num_elements = 0;
+		live_tree.clear();
+	}
+
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity * 4 > slot_capacity * 3) {
+			_rebuild_slots(MAX(p_new_capacity, num_elements));
+		}
+		bool grown = false;
+		while (_get_entry_capacity() < p_new_capacity) {
+			pages.push_back(static_cast<Entry *>(Memory::alloc_static(sizeof(Entry) * ((1u << FIRST_PAGE_SHIFT) << pages.size()))));
+			grown = true;
+		}
+		if (grown && !live_tree.is_empty()) {
+			_build_live_tree();
+		}
+	}
+
+	/* Lookup */
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return _lookup_slot(p_key, _hash(p_key)) != EMPTY_SLOT;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot == EMPTY_SLOT) {
+			return nullptr;
+		}
+		return &_get_entry(slots[slot].position)->get().value;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot == EMPTY_SLOT) {
+			return nullptr;
+		}
+		return &_get_entry(slots[slot].position)->get().value;
+	}
+
+	const TValue &operator[](const TKey &p_key) const {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		CRASH_COND(slot == EMPTY_SLOT);
+		return _get_entry(slots[slot].position)->get().value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		const uint32_t hash = _hash(p_key);
+		const uint32_t slot = _lookup_slot(p_key, hash);
+		if (slot == EMPTY_SLOT) {
+			return _insert(p_key, TValue(), hash)->get().value;
+		}
+		return _get_entry(slots[slot].position)->get().value;
+	}
+
+	Iterator find(const TKey &p_key) {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot == EMPTY_SLOT) {
+			return end();
+		}
+		return Iterator(this, slots[slot].position);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot == EMPTY_SLOT) {
+			return end();
+		}
+		return ConstIterator(this, slots[slot].position);
+	}
+
+	/* Indexed access, in insertion order. */
+
+	// O(log n) instead of O(1) while erase() has left tombstones behind, as they are skipped over.
+	// Entries are never compacted here, so concurrent reads are safe and pointers stay valid.
+	const KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, num_elements);
+		return _get_entry(_get_index_position(p_index))->get();
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, num_elements);
+		return _get_entry(_get_index_position(p_index))->get();
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		const uint32_t hash = _hash(p_key);
+		const uint32_t slot = _lookup_slot(p_key, hash);
+		if (slot != EMPTY_SLOT) {
+			const uint32_t position = slots[slot].position;
+			_get_entry(position)->get().value = p_value;
+			return Iterator(this, position);
+		}
+		_insert(p_key, p_value, hash);
+		return Iterator(this, entry_count - 1);
+	}
+
+	/* Erase */
+
+	bool erase(const TKey &p_key) {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot == EMPTY_SLOT) {
+			return false;
+		}
+		const uint32_t position = slots[slot].position;
+		Entry *entry = _get_entry(position);
+		entry->get().~Element();
+		entry->hash = EMPTY_HASH;
+		slots[slot].position = ERASED_SLOT;
+		num_elements--;
+
+		if (num_elements == 0) {
+			entry_count = 0;
+			for (uint32_t i = 0; i < slot_capacity; i++) {
+				slots[i].position = EMPTY_SLOT;
+			}
+			slots_used = 0;
+			live_tree.clear();
+		} else if (position == entry_count - 1) {
+			// Erasing from the back, as when popping entries, needs no tombstone.
+			do {
+				entry_count--;
+			} while (_get_entry(entry_count - 1)->hash == EMPTY_HASH);
+			if (!live_tree.is_empty()) {
+				_update_live_tree(position, -1);
+			}
+		} else if (entry_count - num_elements > MAX(num_elements, MIN_TOMBSTONES_TO_COMPACT)) {
+			_compact();
+		} else if (live_tree.is_empty()) {
+			_build_live_tree(); // First tombstone.
+		} else {
+			_update_live_tree(position, -1);
+		}
+		return true;
+	}
+
+	/* Iterators */
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, (entry_count == 0 || _get_entry(0)->hash != EMPTY_HASH) ? 0 : _next_position(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, entry_count);
+	}
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, (entry_count == 0 || _get_entry(0)->hash != EMPTY_HASH) ? 0 : _next_position(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, entry_count);
+	}
+
+	/* Constructors */
+
+	DenseHashMap(const DenseHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const DenseHashMap &p_other) {
+		if (this == &p_other) {
+			return;
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	DenseHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+
+	DenseHashMap() {}
+
+	~DenseHashMap() {
+		clear();
+		for (Entry *page : pages) {
+			Memory::free_static(page);
+		}
+		if (slots) {
+			Memory::free_static(slots);
+		}
+	}
+};
+
+#endif // DENSE_HASH_MAP_H
@@ -30,7 +30,7 @@
 
 #include "dictionary.h"
 
-#include "core/templates/hash_map.h"
+#include "core/templates/dense_hash_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 // required in this order by VariantInternal, do not remove this comment.
@@ -42,7 +42,8 @@
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
+	// Insertion-ordered and dense, so iteration and indexed access are cheap.
+	DenseHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
@@ -56,27 +57,17 @@ void Dictionary::get_key_list(List<Variant> *p_keys) const {
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.key;
-		}
-		index++;
+	if (p_index < 0 || p_index >= size()) {
+		return Variant();
 	}
-
-	return Variant();
+	return _p->variant_map.get_by_index(p_index).key;
 }
 
 Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.value;
-		}
-		index++;
+	if (p_index < 0 || p_index >= size()) {
+		return Variant();
 	}
-
-	return Variant();
+	return _p->variant_map.get_by_index(p_index).value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
@@ -112,33 +103,28 @@ const Variant &Dictionary::operator[](const Variant &p_key) const {
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
-	if (!E) {
-		return nullptr;
-	}
-	return &E->value;
+	return _p->variant_map.getptr(p_key);
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(p_key));
-	if (!E) {
+	Variant *value = _p->variant_map.getptr(p_key);
+	if (!value) {
 		return nullptr;
 	}
 	if (unlikely(_p->read_only != nullptr)) {
-		*_p->read_only = E->value;
+		*_p->read_only = *value;
 		return _p->read_only;
 	} else {
-		return &E->value;
+		return value;
 	}
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
-
-	if (!E) {
+	const Variant *value = getptr(p_key);
+	if (!value) {
 		return Variant();
 	}
-	return E->value;
+	return *value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -218,8 +204,8 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	}
 	recursion_count++;
 	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
-		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
+		const Variant *other_value = p_dictionary.getptr(this_E.key);
+		if (!other_value || !this_E.value.hash_compare(*other_value, recursion_count, false)) {
 			return false;
 		}
 	}
@@ -337,7 +323,7 @@ const Variant *Dictionary::next(const Variant *p_key) const {
 		}
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(*p_key);
+	DenseHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E = _p->variant_map.find(*p_key);
 
 	if (!E) {
 		return nullptr;
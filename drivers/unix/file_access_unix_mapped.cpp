@@ -0,0 +1,276 @@
+/**************************************************************************/
+/*  file_access_unix_mapped.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_unix_mapped.h"
+
+#if defined(UNIX_ENABLED)
+
+#include "core/string/print_string.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+Error FileAccessUnixMapped::open_internal(const String &p_path, int p_mode_flags) {
+	_close();
+
+	ERR_FAIL_COND_V_MSG(p_mode_flags != READ, ERR_UNAVAILABLE, "Memory-mapped files can only be opened for reading.");
+
+	path_src = p_path;
+	path = fix_path(p_path);
+
+	int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		switch (errno) {
+			case ENOENT: {
+				last_error = ERR_FILE_NOT_FOUND;
+			} break;
+			default: {
+				last_error = ERR_FILE_CANT_OPEN;
+			} break;
+		}
+		return last_error;
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		last_error = ERR_FILE_CANT_OPEN;
+		return last_error;
+	}
+
+	length = st.st_size;
+	if (length > 0) {
+		if ((uint64_t)(size_t)length != length) {
+			// Doesn't fit in the address space (32-bit platforms).
+			::close(fd);
+			length = 0;
+			last_error = ERR_OUT_OF_MEMORY;
+			return last_error;
+		}
+
+		void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			::close(fd);
+			length = 0;
+			last_error = ERR_FILE_CANT_OPEN;
+			return last_error;
+		}
+		data = (uint8_t *)mapping;
+	}
+
+	// The mapping stays valid after the descriptor is closed.
+	::close(fd);
+
+	pos = 0;
+	opened = true;
+	last_error = OK;
+	return OK;
+}
+
+void FileAccessUnixMapped::_close() {
+	if (data) {
+		munmap(data, length);
+	}
+	data = nullptr;
+	length = 0;
+	pos = 0;
+	opened = false;
+}
+
+bool FileAccessUnixMapped::is_open() const {
+	return opened;
+}
+
+String FileAccessUnixMapped::get_path() const {
+	return path_src;
+}
+
+String FileAccessUnixMapped::get_path_absolute() const {
+	return path;
+}
+
+void FileAccessUnixMapped::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(!opened, "File must be opened before use.");
+
+	last_error = OK;
+	pos = p_position;
+}
+
+void FileAccessUnixMapped::seek_end(int64_t p_position) {
+	ERR_FAIL_COND_MSG(!opened, "File must be opened before use.");
+	ERR_FAIL_COND(p_position > 0 || (uint64_t)-p_position > length);
+
+	last_error = OK;
+	pos = length + p_position;
+}
+
+uint64_t FileAccessUnixMapped::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessUnixMapped::get_length() const {
+	return length;
+}
+
+bool FileAccessUnixMapped::eof_reached() const {
+	return last_error == ERR_FILE_EOF;
+}
+
+uint8_t FileAccessUnixMapped::get_8() const {
+	ERR_FAIL_COND_V_MSG(!opened, 0, "File must be opened before use.");
+
+	if (pos >= length) {
+		last_error = ERR_FILE_EOF;
+		return 0;
+	}
+	return data[pos++];
+}
+
+uint16_t FileAccessUnixMapped::get_16() const {
+	uint16_t b = 0;
+	get_buffer((uint8_t *)&b, 2);
+
+	if (big_endian) {
+		b = BSWAP16(b);
+	}
+
+	return b;
+}
+
+uint32_t FileAccessUnixMapped::get_32() const {
+	uint32_t b = 0;
+	get_buffer((uint8_t *)&b, 4);
+
+	if (big_endian) {
+		b = BSWAP32(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessUnixMapped::get_64() const {
+	uint64_t b = 0;
+	get_buffer((uint8_t *)&b, 8);
+
+	if (big_endian) {
+		b = BSWAP64(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessUnixMapped::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_COND_V_MSG(!opened, -1, "File must be opened before use.");
+
+	uint64_t available = pos < length ? length - pos : 0;
+	uint64_t read = MIN(p_length, available);
+	if (read < p_length) {
+		last_error = ERR_FILE_EOF;
+	}
+	if (read > 0) {
+		memcpy(p_dst, data + pos, read);
+		pos += read;
+	}
+	return read;
+}
+
+const uint8_t *FileAccessUnixMapped::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!opened, nullptr, "File must be opened before use.");
+
+	if (pos > length || p_length > length - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = data + pos;
+	pos += p_length;
+	return view;
+}
+
+Error FileAccessUnixMapped::get_error() const {
+	return last_error;
+}
+
+void FileAccessUnixMapped::store_8(uint8_t p_dest) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+bool FileAccessUnixMapped::file_exists(const String &p_path) {
+	struct stat st = {};
+	String filename = fix_path(p_path);
+
+	if (stat(filename.utf8().get_data(), &st)) {
+		return false;
+	}
+	return S_ISREG(st.st_mode);
+}
+
+uint64_t FileAccessUnixMapped::_get_modified_time(const String &p_file) {
+	String file = fix_path(p_file);
+	struct stat status = {};
+	int err = stat(file.utf8().get_data(), &status);
+
+	if (!err) {
+		return status.st_mtime;
+	} else {
+		print_verbose("Failed to get modified time for: " + p_file + "");
+		return 0;
+	}
+}
+
+BitField<FileAccess::UnixPermissionFlags> FileAccessUnixMapped::_get_unix_permissions(const String &p_file) {
+	String file = fix_path(p_file);
+	struct stat status = {};
+	int err = stat(file.utf8().get_data(), &status);
+
+	if (!err) {
+		return status.st_mode & 0xFFF; //only permissions
+	} else {
+		ERR_FAIL_V_MSG(0, "Failed to get unix permissions for: " + p_file + ".");
+	}
+}
+
+void FileAccessUnixMapped::close() {
+	_close();
+}
+
+FileAccessUnixMapped::~FileAccessUnixMapped() {
+	_close();
+}
+
+#endif // UNIX_ENABLED
@@ -125,6 +125,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -538,6 +539,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--path <directory>", "Path to a project (<directory> must contain a \"project.godot\" file).\n");
 	print_help_option("-u, --upwards", "Scan folders upwards for project.godot file.\n");
 	print_help_option("--main-pack <file>", "Path to a pack (.pck) file to load.\n");
+	print_help_option("--disable-pck-mmap", "Read pack files through buffered I/O instead of memory-mapping them.\n");
 	print_help_option("--render-thread <mode>", "Render thread mode (\"unsafe\", \"safe\", \"separate\").\n");
 	print_help_option("--remote-fs <address>", "Remote filesystem (<host/IP>[:<port>] address).\n");
 	print_help_option("--remote-fs-password <password>", "Password for remote filesystem.\n");
@@ -598,6 +600,10 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-d, --debug", "Debug (local stdout debugger).\n");
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--gdscript-sampling-profiler <file>", "Sample GDScript call stacks from startup until exit, then write them to <file> in the collapsed stack format used by flame graph tools.\n");
+	print_help_option("--gdscript-sampling-interval <usec>", "Sampling period of --gdscript-sampling-profiler in microseconds (default: 1000).\n");
+#endif // MODULE_GDSCRIPT_ENABLED
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -1609,6 +1615,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			}
 
+		} else if (arg == "--disable-pck-mmap") {
+			packed_data->set_use_mmap(false);
+
 		} else if (arg == "-d" || arg == "--debug") {
 			debug_uri = "local://";
 			OS::get_singleton()->_debug_stdout = true;
@@ -1741,6 +1750,29 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			}
 #endif // TOOLS_ENABLED
+#ifdef MODULE_GDSCRIPT_ENABLED
+		} else if (arg == "--gdscript-sampling-profiler") {
+			if (N) {
+				GDScriptSamplingProfiler::startup_output_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --gdscript-sampling-profiler <file>.\n");
+				goto error;
+			}
+		} else if (arg == "--gdscript-sampling-interval") {
+			if (N) {
+				int interval = N->get().to_int();
+				if (interval < 1) {
+					OS::get_singleton()->print("<usec> argument for --gdscript-sampling-interval <usec> must be greater than 0.\n");
+					goto error;
+				}
+				GDScriptSamplingProfiler::startup_interval_usec = interval;
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <usec> argument for --gdscript-sampling-interval <usec>.\n");
+				goto error;
+			}
+#endif // MODULE_GDSCRIPT_ENABLED
 		} else if (arg == "--" || arg == "++") {
 			adding_user_args = true;
 		} else {
@@ -100,6 +100,7 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		AUDIO_BUS_PROCESS_TIME,
 		MONITOR_MAX
 	};
 
@@ -55,6 +55,7 @@ complete -c godot -s l -l language -d "Use a specific locale (<locale> being a t
 complete -c godot -l path -d "Path to a project (<directory> must contain a 'project.godot' file)" -r
 complete -c godot -s u -l upwards -d "Scan folders upwards for project.godot file"
 complete -c godot -l main-pack -d "Path to a pack (.pck) file to load" -r
+complete -c godot -l disable-pck-mmap -d "Read pack files through buffered I/O instead of memory-mapping them"
 complete -c godot -l render-thread -d "Set the render thread mode" -x -a "unsafe safe separate"
 complete -c godot -l remote-fs -d "Use a remote filesystem (<host/IP>[:<port>] address)" -x
 complete -c godot -l remote-fs-password -d "Password for remote filesystem" -x
@@ -84,6 +85,8 @@ complete -c godot -l xr-mode -d "Select Extended Reality (XR) mode" -a "default
 complete -c godot -s d -l debug -d "Debug (local stdout debugger)"
 complete -c godot -s b -l breakpoints -d "Specify the breakpoint list as source::line comma-separated pairs, no spaces (use %20 instead)" -x
 complete -c godot -l profiling -d "Enable profiling in the script debugger"
+complete -c godot -l gdscript-sampling-profiler -d "Sample GDScript call stacks from startup until exit and write them to a file" -r
+complete -c godot -l gdscript-sampling-interval -d "Sampling period of the GDScript sampling profiler in microseconds" -x
 complete -c godot -l gpu-profile -d "Show a GPU profile of the tasks that took the most time during frame rendering"
 complete -c godot -l gpu-validation -d "Enable graphics API validation layers for debugging"
 complete -c godot -l gpu-abort -d "Abort on graphics API usage errors (usually validation layer errors)"
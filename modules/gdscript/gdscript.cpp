@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -446,6 +447,7 @@ void GDScript::set_source_code(const String &p_code) {
 		return;
 	}
 	source = p_code;
+	bytecode_cache.clear();
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
 #endif
@@ -787,6 +789,26 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+
+	if (!bytecode_cache.is_empty()) {
+		// Compiled at export time. It's only good for the first load, if it can't be used the binary tokens are compiled instead.
+		Vector<uint8_t> bytecode = bytecode_cache;
+		bytecode_cache.clear();
+		if (GDScriptBytecodeCache::deserialize(this, bytecode) == OK) {
+			Error err = OK;
+			if (ScriptServer::is_scripting_enabled() || tool) {
+				err = _static_init();
+			}
+#ifdef TOOLS_ENABLED
+			else {
+				_static_default_init();
+			}
+#endif
+			reloading = false;
+			return err;
+		}
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -1125,12 +1147,17 @@ Error GDScript::load_source_code(const String &p_path) {
 
 void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
 	binary_tokens = p_binary_tokens;
+	bytecode_cache.clear();
 }
 
 const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
 	return binary_tokens;
 }
 
+void GDScript::set_bytecode_cache_source(const Vector<uint8_t> &p_bytecode_cache) {
+	bytecode_cache = p_bytecode_cache;
+}
+
 Vector<uint8_t> GDScript::get_as_binary_tokens() const {
 	GDScriptTokenizerBuffer tokenizer;
 	return tokenizer.parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
@@ -1525,6 +1552,9 @@ void GDScript::clear(ClearData *p_clear_data) {
 	}
 	clearing = true;
 
+	// Functions and members are freed below, drop any inline cache entry pointing at them.
+	GDScriptFunction::InlineCache::invalidate_all();
+
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
 	bool is_root = false;
@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -180,6 +181,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode_cache; // Used instead of compiling `binary_tokens` on the first load, see `GDScriptBytecodeCache`.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -308,6 +310,7 @@ public:
 
 	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
 	const Vector<uint8_t> &get_binary_tokens_source() const;
+	void set_bytecode_cache_source(const Vector<uint8_t> &p_bytecode_cache);
 	Vector<uint8_t> get_as_binary_tokens() const;
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
@@ -31,6 +31,7 @@
 #include "gdscript_byte_codegen.h"
 
 #include "gdscript.h"
+#include "gdscript_byte_optimizer.h"
 
 #include "core/debugger/engine_debugger.h"
 
@@ -221,6 +222,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_global_names_count = 0;
 	}
 
+	if (GDScriptByteCodeOptimizer::is_enabled()) {
+		GDScriptByteCodeOptimizer::optimize(opcodes, function->default_arguments, function->constants);
+	}
+
 	if (opcodes.size()) {
 		function->code = opcodes;
 		function->_code_ptr = &function->code.write[0];
@@ -395,6 +400,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	function->inline_caches.resize(inline_cache_count);
+	function->_inline_caches_ptr = inline_cache_count ? function->inline_caches.ptrw() : nullptr;
+	function->_inline_caches_count = inline_cache_count;
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -584,6 +593,64 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+// Returns the opcode working on raw `int` or `float` values for the operation, or `-1` if there is none.
+static int _get_unboxed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		return -1;
+	}
+	if (p_left_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_ADD;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_SUBTRACT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_MULTIPLY;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_LESS;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_GREATER;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL;
+			default:
+				return -1;
+		}
+	}
+	if (p_left_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_ADD;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_SUBTRACT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_MULTIPLY;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_DIVIDE;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_EQUAL;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_NOT_EQUAL;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL;
+			default:
+				return -1;
+		}
+	}
+	return -1;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
@@ -595,6 +662,16 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Numeric operands hold their type, so the value can be used without going through an evaluator.
+		int unboxed_opcode = _get_unboxed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (unboxed_opcode >= 0) {
+			append_opcode(GDScriptFunction::Opcode(unboxed_opcode));
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -832,6 +909,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append(add_inline_cache());
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -850,6 +928,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(add_inline_cache());
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1040,6 +1119,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1065,6 +1145,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1299,6 +1380,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1312,6 +1394,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1325,6 +1408,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -0,0 +1,554 @@
+/**************************************************************************/
+/*  gdscript_byte_optimizer.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_byte_optimizer.h"
+
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+bool GDScriptByteCodeOptimizer::enabled = true;
+
+int GDScriptByteCodeOptimizer::get_instruction_size(const int *p_code, int p_code_size, int p_ip) {
+	if (p_ip < 0 || p_ip >= p_code_size) {
+		return -1;
+	}
+
+	// Instructions with a variable amount of addresses store its count right after the opcode.
+	int var_args_trailing = 0;
+
+	switch (GDScriptFunction::Opcode(p_code[p_ip])) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+			return 7 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*p_code);
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			return 5;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			return 6;
+		case GDScriptFunction::OPCODE_OPERATOR_INT_ADD:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_SUBTRACT:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_MULTIPLY:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_LESS:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_ADD:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_SUBTRACT:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_MULTIPLY:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_DIVIDE:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_NOT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL:
+			return 4;
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_LESS:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_GREATER:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL:
+			return 5;
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE:
+		case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+			return 6;
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+			return 4;
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+			return 5;
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+			return 5;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+			return 3;
+		case GDScriptFunction::OPCODE_UPDATE_MEMBER_VALIDATED:
+			return 7;
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE:
+			return 4;
+		case GDScriptFunction::OPCODE_ASSIGN:
+			return 3;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			return 2;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY:
+			return 6;
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY:
+			var_args_trailing = 2;
+			break;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+		case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA:
+			var_args_trailing = 3;
+			break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC:
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_ASYNC:
+			var_args_trailing = 4;
+			break;
+		case GDScriptFunction::OPCODE_AWAIT:
+		case GDScriptFunction::OPCODE_AWAIT_RESUME:
+			return 2;
+		case GDScriptFunction::OPCODE_JUMP:
+			return 2;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return 3;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+			return 1;
+		case GDScriptFunction::OPCODE_RETURN:
+			return 2;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+			return 3;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+			return 5;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_FLOAT:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_VECTOR2:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_VECTOR2I:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_VECTOR3:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_VECTOR3I:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_STRING:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_DICTIONARY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_OBJECT:
+		case GDScriptFunction::OPCODE_ITERATE:
+		case GDScriptFunction::OPCODE_ITERATE_INT:
+		case GDScriptFunction::OPCODE_ITERATE_FLOAT:
+		case GDScriptFunction::OPCODE_ITERATE_VECTOR2:
+		case GDScriptFunction::OPCODE_ITERATE_VECTOR2I:
+		case GDScriptFunction::OPCODE_ITERATE_VECTOR3:
+		case GDScriptFunction::OPCODE_ITERATE_VECTOR3I:
+		case GDScriptFunction::OPCODE_ITERATE_STRING:
+		case GDScriptFunction::OPCODE_ITERATE_DICTIONARY:
+		case GDScriptFunction::OPCODE_ITERATE_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_BYTE_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_INT32_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_INT64_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_FLOAT32_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_FLOAT64_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_STRING_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_VECTOR2_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_VECTOR3_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_COLOR_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_PACKED_VECTOR4_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_OBJECT:
+			return 5;
+		case GDScriptFunction::OPCODE_STORE_GLOBAL:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL:
+			return 3;
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_STRING:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_RECT2:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_RECT2I:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3I:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_TRANSFORM2D:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR4:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR4I:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PLANE:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_QUATERNION:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_AABB:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_BASIS:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_TRANSFORM3D:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PROJECTION:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_COLOR:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_STRING_NAME:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_NODE_PATH:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_RID:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_OBJECT:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_CALLABLE:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_SIGNAL:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_DICTIONARY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY:
+			return 2;
+		case GDScriptFunction::OPCODE_ASSERT:
+			return 3;
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+			return 1;
+		case GDScriptFunction::OPCODE_LINE:
+			return 2;
+		case GDScriptFunction::OPCODE_END:
+			return 1;
+	}
+
+	if (var_args_trailing == 0 || p_ip + 1 >= p_code_size || p_code[p_ip + 1] < 0) {
+		return -1;
+	}
+	return 1 + p_code[p_ip + 1] + var_args_trailing;
+}
+
+// Returns the offset of the jump destination operand of the instruction at `p_ip`, or 0 if it doesn't jump.
+static int _get_jump_operand(const int *p_code, int p_ip) {
+	const int opcode = p_code[p_ip];
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+			return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return 2;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			return 5;
+		default:
+			break;
+	}
+	if (opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+		return 4;
+	}
+	if (opcode >= GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL && opcode <= GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL) {
+		return 4;
+	}
+	return 0;
+}
+
+static bool _is_constant_address(int p_address) {
+	return ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_CONSTANT;
+}
+
+bool GDScriptByteCodeOptimizer::optimize(Vector<int> &r_code, Vector<int> &r_default_arguments, const Vector<Variant> &p_constants) {
+	enum {
+		FLAG_START = 1, // An instruction starts here.
+		FLAG_TARGET = 2, // Execution may resume here from somewhere else than the previous instruction.
+	};
+
+	const int code_size = r_code.size();
+	int *code = r_code.ptrw();
+
+	LocalVector<uint8_t> flags;
+	flags.resize(code_size + 1);
+	memset(flags.ptr(), 0, flags.size());
+
+	for (int ip = 0; ip < code_size;) {
+		const int size = get_instruction_size(code, code_size, ip);
+		if (size <= 0 || ip + size > code_size) {
+			return false;
+		}
+		flags[ip] |= FLAG_START;
+		ip += size;
+	}
+	flags[code_size] |= FLAG_START;
+
+	for (int ip = 0; ip < code_size; ip += get_instruction_size(code, code_size, ip)) {
+		const int operand = _get_jump_operand(code, ip);
+		if (operand != 0 && (code[ip + operand] < 0 || code[ip + operand] > code_size || !(flags[code[ip + operand]] & FLAG_START))) {
+			return false;
+		}
+	}
+	for (int i = 0; i < r_default_arguments.size(); i++) {
+		if (r_default_arguments[i] < 0 || r_default_arguments[i] > code_size || !(flags[r_default_arguments[i]] & FLAG_START)) {
+			return false;
+		}
+	}
+
+	// Thread jumps landing on unconditional jumps, so they go straight to the final destination.
+	// The hop limit keeps empty infinite loops from spinning here.
+	for (int ip = 0; ip < code_size; ip += get_instruction_size(code, code_size, ip)) {
+		const int operand = _get_jump_operand(code, ip);
+		if (operand == 0) {
+			continue;
+		}
+		int target = code[ip + operand];
+		for (int hops = 0; hops < 8 && target < code_size && code[target] == GDScriptFunction::OPCODE_JUMP; hops++) {
+			target = code[target + 1];
+		}
+		code[ip + operand] = target;
+	}
+
+	// Mark everything that can be reached without falling through, these can't be fused into the previous instruction.
+	HashMap<int, int> word_uses;
+	for (int ip = 0; ip < code_size; ip += get_instruction_size(code, code_size, ip)) {
+		const int operand = _get_jump_operand(code, ip);
+		if (operand != 0) {
+			flags[code[ip + operand]] |= FLAG_TARGET;
+		}
+		if (code[ip] == GDScriptFunction::OPCODE_AWAIT) {
+			flags[ip + 2] |= FLAG_TARGET; // Resumes at `OPCODE_AWAIT_RESUME`.
+		}
+	}
+	for (int i = 0; i < r_default_arguments.size(); i++) {
+		flags[r_default_arguments[i]] |= FLAG_TARGET;
+	}
+
+	LocalVector<int> new_code;
+	new_code.reserve(code_size);
+	LocalVector<int> remap; // Old instruction positions to new ones, dropped instructions map to the next emitted one.
+	remap.resize(code_size + 1);
+	for (uint32_t i = 0; i < remap.size(); i++) {
+		remap[i] = -1;
+	}
+	LocalVector<int> jump_operands; // Positions in `new_code` which hold an old jump destination.
+
+	for (int ip = 0; ip < code_size;) {
+		const int size = get_instruction_size(code, code_size, ip);
+		const int next = ip + size;
+		const bool next_fusable = next < code_size && !(flags[next] & FLAG_TARGET);
+		remap[ip] = new_code.size();
+
+		switch (code[ip]) {
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				if (code[ip + 1] == code[ip + 2]) {
+					ip = next; // Assignment to itself.
+					continue;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_JUMP: {
+				if (code[ip + 1] == next) {
+					ip = next; // Jump to the next instruction.
+					continue;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				const int condition = code[ip + 1];
+				const int constant = condition & GDScriptFunction::ADDR_MASK;
+				if (!_is_constant_address(condition) || constant >= p_constants.size()) {
+					break;
+				}
+				// Condition known at compile time, like in `while true:`.
+				if (p_constants[constant].booleanize() == (code[ip] == GDScriptFunction::OPCODE_JUMP_IF) && code[ip + 2] != next) {
+					new_code.push_back(GDScriptFunction::OPCODE_JUMP);
+					jump_operands.push_back(new_code.size());
+					new_code.push_back(code[ip + 2]);
+				}
+				ip = next;
+				continue;
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR: {
+				// `temp = a op b` then `x = temp`, and nothing else uses `temp`: compute into `x` directly.
+				// Unlike the validated version, this instruction sets the result type of its destination.
+				const int temp = code[ip + 3];
+				if (!next_fusable || code[next] != GDScriptFunction::OPCODE_ASSIGN || code[next + 2] != temp) {
+					break;
+				}
+				const int dst = code[next + 1];
+				if (dst == code[ip + 1] || dst == code[ip + 2] || dst == temp || _is_constant_address(dst) || _is_constant_address(temp)) {
+					break;
+				}
+				if (word_uses.is_empty()) {
+					// Conservative: counts every word holding the same value, addresses or not.
+					for (int i = 0; i < code_size; i++) {
+						word_uses[code[i]]++;
+					}
+				}
+				if (word_uses[temp] != 2) {
+					break;
+				}
+				for (int i = 0; i < size; i++) {
+					new_code.push_back(code[ip + i]);
+				}
+				new_code[remap[ip] + 3] = dst;
+				ip = next + get_instruction_size(code, code_size, next);
+				continue;
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				if (!next_fusable) {
+					break;
+				}
+				const int dst = code[ip + 3];
+				if ((code[next] == GDScriptFunction::OPCODE_JUMP_IF || code[next] == GDScriptFunction::OPCODE_JUMP_IF_NOT) && code[next + 1] == dst) {
+					new_code.push_back(code[next] == GDScriptFunction::OPCODE_JUMP_IF ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF : GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT);
+					for (int i = 1; i < size; i++) {
+						new_code.push_back(code[ip + i]);
+					}
+					jump_operands.push_back(new_code.size());
+					new_code.push_back(code[next + 2]);
+					ip = next + 3;
+					continue;
+				}
+				if (code[next] == GDScriptFunction::OPCODE_ASSIGN && code[next + 2] == dst) {
+					new_code.push_back(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN);
+					for (int i = 1; i < size; i++) {
+						new_code.push_back(code[ip + i]);
+					}
+					new_code.push_back(code[next + 1]);
+					ip = next + 3;
+					continue;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_LESS:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_NOT_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL: {
+				// Compare and branch, as in `while i < count:`.
+				if (!next_fusable || code[next] != GDScriptFunction::OPCODE_JUMP_IF_NOT || code[next + 1] != code[ip + 3]) {
+					break;
+				}
+				const bool is_int = code[ip] <= GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL;
+				const int comparison = code[ip] - (is_int ? GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL : GDScriptFunction::OPCODE_OPERATOR_FLOAT_EQUAL);
+				new_code.push_back((is_int ? GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL : GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_EQUAL) + comparison);
+				new_code.push_back(code[ip + 1]);
+				new_code.push_back(code[ip + 2]);
+				new_code.push_back(code[ip + 3]);
+				jump_operands.push_back(new_code.size());
+				new_code.push_back(code[next + 2]);
+				ip = next + 3;
+				continue;
+			} break;
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				// `temp = member`, `result = temp op value`, `member = result`, as compound assignment does on native properties.
+				if (!next_fusable || code[next] != GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+					break;
+				}
+				const int set = next + 5;
+				if (set + 3 > code_size || (flags[set] & FLAG_TARGET) || code[set] != GDScriptFunction::OPCODE_SET_MEMBER) {
+					break;
+				}
+				const int temp = code[ip + 1];
+				const int name = code[ip + 2];
+				const int result = code[next + 3];
+				if ((code[next + 1] != temp && code[next + 2] != temp) || code[set + 1] != result || code[set + 2] != name) {
+					break;
+				}
+				new_code.push_back(GDScriptFunction::OPCODE_UPDATE_MEMBER_VALIDATED);
+				new_code.push_back(temp);
+				new_code.push_back(name);
+				new_code.push_back(code[next + 1]);
+				new_code.push_back(code[next + 2]);
+				new_code.push_back(result);
+				new_code.push_back(code[next + 4]);
+				ip = set + 3;
+				continue;
+			} break;
+			default:
+				break;
+		}
+
+		const int operand = _get_jump_operand(code, ip);
+		for (int i = 0; i < size; i++) {
+			if (i == operand && operand != 0) {
+				jump_operands.push_back(new_code.size());
+			}
+			new_code.push_back(code[ip + i]);
+		}
+		ip = next;
+	}
+	remap[code_size] = new_code.size();
+
+	for (uint32_t i = 0; i < jump_operands.size(); i++) {
+		const int target = remap[new_code[jump_operands[i]]];
+		ERR_FAIL_COND_V_MSG(target < 0, false, "Bytecode optimizer: jump into a fused instruction.");
+		new_code[jump_operands[i]] = target;
+	}
+	Vector<int> default_arguments = r_default_arguments;
+	for (int i = 0; i < default_arguments.size(); i++) {
+		const int target = remap[default_arguments[i]];
+		ERR_FAIL_COND_V_MSG(target < 0, false, "Bytecode optimizer: default argument jump into a fused instruction.");
+		default_arguments.write[i] = target;
+	}
+	r_default_arguments = default_arguments;
+
+	r_code.resize(new_code.size());
+	memcpy(r_code.ptrw(), new_code.ptr(), new_code.size() * sizeof(int));
+	return true;
+}
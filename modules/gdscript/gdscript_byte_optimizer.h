@@ -0,0 +1,54 @@
+/**************************************************************************/
+/*  gdscript_byte_optimizer.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTE_OPTIMIZER_H
+#define GDSCRIPT_BYTE_OPTIMIZER_H
+
+#include "core/templates/vector.h"
+#include "core/variant/variant.h"
+
+// Peephole pass run on the finished bytecode of a function, after temporaries got their final stack addresses.
+// It fuses common instruction sequences into superinstructions, threads jumps, folds conditional jumps
+// on constants and drops instructions that do nothing. Jump targets are relocated accordingly.
+class GDScriptByteCodeOptimizer {
+	static bool enabled;
+
+public:
+	// Returns the size in words of the instruction at `p_ip`, or -1 if it can't be decoded.
+	static int get_instruction_size(const int *p_code, int p_code_size, int p_ip);
+
+	// Returns `false` if the code can't be decoded, in which case it is left untouched.
+	static bool optimize(Vector<int> &r_code, Vector<int> &r_default_arguments, const Vector<Variant> &p_constants);
+
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static bool is_enabled() { return enabled; }
+};
+
+#endif // GDSCRIPT_BYTE_OPTIMIZER_H
@@ -0,0 +1,1478 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_byte_optimizer.h"
+#include "gdscript_cache.h"
+#include "gdscript_compiler.h"
+#include "gdscript_function.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/compression.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+// Nested arrays and dictionaries deeper than this are not worth storing.
+static constexpr int MAX_VARIANT_DEPTH = 64;
+
+// `OPCODE_OPERATOR` caches the operand types and an evaluator pointer in its own code the first time it runs.
+// Neither can leave the process, so they are cleared when saving and again when loading.
+static void _reset_operator_cache(int *p_code, int p_ip, int p_size) {
+	for (int i = 5; i < p_size; i++) {
+		p_code[p_ip + i] = 0;
+	}
+}
+
+struct GDScriptBytecodeCache::Writer {
+	Vector<uint8_t> data;
+	String error;
+
+	void fail(const String &p_reason) {
+		if (error.is_empty()) {
+			error = p_reason;
+		}
+	}
+
+	bool failed() const { return !error.is_empty(); }
+
+	void put_bytes(const uint8_t *p_bytes, int p_size) {
+		int ofs = data.size();
+		data.resize(ofs + p_size);
+		memcpy(data.ptrw() + ofs, p_bytes, p_size);
+	}
+
+	void put_u8(uint8_t p_value) { data.push_back(p_value); }
+
+	void put_u32(uint32_t p_value) {
+		uint8_t buf[4];
+		encode_uint32(p_value, buf);
+		put_bytes(buf, 4);
+	}
+
+	void put_s32(int32_t p_value) { put_u32((uint32_t)p_value); }
+
+	void put_string(const String &p_string) {
+		CharString cs = p_string.utf8();
+		put_u32(cs.length());
+		put_bytes((const uint8_t *)cs.get_data(), cs.length());
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool failed = false;
+	GDScript *main_script = nullptr;
+
+	bool has(uint64_t p_bytes) {
+		if (failed || p_bytes > uint64_t(size - pos)) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+
+	int32_t get_s32() { return (int32_t)get_u32(); }
+
+	// Element counts are checked against the remaining data, so corrupted files can't trigger huge allocations.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (!has(count)) {
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		uint32_t length = get_u32();
+		if (!has(length)) {
+			return String();
+		}
+		String string;
+		string.parse_utf8((const char *)&data[pos], length);
+		pos += length;
+		return string;
+	}
+
+	Variant::Type get_type() {
+		uint32_t type = get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			failed = true;
+			return Variant::NIL;
+		}
+		return (Variant::Type)type;
+	}
+
+	Reader(const Vector<uint8_t> &p_data, GDScript *p_main_script) {
+		data = p_data.ptr();
+		size = p_data.size();
+		main_script = p_main_script;
+	}
+};
+
+uint32_t GDScriptBytecodeCache::_get_build_signature(bool p_debug) {
+	// Function pointers and opcodes are only stable within a single engine build.
+	// Debug and release builds also compile scripts differently, see `GDScriptCompiler::set_debug_codegen()`.
+	uint32_t signature = String(VERSION_FULL_BUILD).hash();
+	signature = hash_murmur3_one_32(p_debug, signature);
+	signature = hash_murmur3_one_32(String(VERSION_HASH).hash(), signature);
+	signature = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, signature);
+	signature = hash_murmur3_one_32(Variant::VARIANT_MAX, signature);
+	signature = hash_murmur3_one_32(Variant::OP_MAX, signature);
+	signature = hash_murmur3_one_32(sizeof(real_t), signature);
+	return hash_fmix32(signature);
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_binary_tokens_path) {
+	return p_binary_tokens_path.get_basename() + ".gdbc";
+}
+
+/* Loading */
+
+Vector<uint8_t> GDScriptBytecodeCache::load(const String &p_binary_tokens_path, const Vector<uint8_t> &p_binary_tokens) {
+	// The debugger needs local variable information, which is not stored.
+	if (EngineDebugger::is_active()) {
+		return Vector<uint8_t>();
+	}
+
+	String cache_path = get_cache_path(p_binary_tokens_path);
+	if (!FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path);
+	if (buffer.size() < 24) {
+		return Vector<uint8_t>();
+	}
+
+	const uint8_t *buf = buffer.ptr();
+	if (buf[0] != 'G' || buf[1] != 'D' || buf[2] != 'B' || buf[3] != 'C') {
+		return Vector<uint8_t>();
+	}
+#ifdef DEBUG_ENABLED
+	const bool debug = true;
+#else
+	const bool debug = false;
+#endif
+	if (decode_uint32(&buf[4]) != FORMAT_VERSION || decode_uint32(&buf[8]) != _get_build_signature(debug)) {
+		print_verbose(vformat(R"(GDScript: Compiled bytecode "%s" was made by a different engine build, compiling the script instead.)", cache_path));
+		return Vector<uint8_t>();
+	}
+	if (decode_uint32(&buf[12]) != hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size())) {
+		print_verbose(vformat(R"(GDScript: Compiled bytecode "%s" is out of date, compiling the script instead.)", cache_path));
+		return Vector<uint8_t>();
+	}
+
+	uint32_t decompressed_size = decode_uint32(&buf[16]);
+	uint32_t compressed_size = decode_uint32(&buf[20]);
+	ERR_FAIL_COND_V(compressed_size != uint32_t(buffer.size() - 24), Vector<uint8_t>());
+
+	Vector<uint8_t> contents;
+	contents.resize(decompressed_size);
+	int result = Compression::decompress(contents.ptrw(), contents.size(), &buf[24], compressed_size, Compression::MODE_ZSTD);
+	ERR_FAIL_COND_V_MSG(result != (int)decompressed_size, Vector<uint8_t>(), vformat(R"(Error decompressing GDScript compiled bytecode "%s".)", cache_path));
+
+	return contents;
+}
+
+void GDScriptBytecodeCache::_read_variant(Reader &r, Variant &r_variant, int p_depth) {
+	if (p_depth > MAX_VARIANT_DEPTH) {
+		r.failed = true;
+		return;
+	}
+
+	switch (r.get_u8()) {
+		case VARIANT_PLAIN: {
+			uint32_t length = r.get_u32();
+			if (!r.has(length)) {
+				return;
+			}
+			int read = 0;
+			Error err = decode_variant(r_variant, &r.data[r.pos], length, &read, false);
+			if (err != OK || read != (int)length) {
+				r.failed = true;
+				return;
+			}
+			r.pos += length;
+		} break;
+		case VARIANT_NULL_OBJECT: {
+			r_variant = (Object *)nullptr;
+		} break;
+		case VARIANT_GDSCRIPT: {
+			Ref<GDScript> ref;
+			GDScript *script = _read_gdscript(r, ref);
+			if (script == nullptr) {
+				r.failed = true;
+				return;
+			}
+			r_variant = Ref<GDScript>(script);
+		} break;
+		case VARIANT_GLOBAL: {
+			StringName name = r.get_string();
+			const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+			HashMap<StringName, int>::ConstIterator E = global_map.find(name);
+			if (!E) {
+				r.failed = true;
+				return;
+			}
+			r_variant = GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+		} break;
+		case VARIANT_RESOURCE: {
+			String path = r.get_string();
+			if (r.failed) {
+				return;
+			}
+			Ref<Resource> res = ResourceLoader::load(path);
+			if (res.is_null()) {
+				r.failed = true;
+				return;
+			}
+			r_variant = res;
+		} break;
+		case VARIANT_ARRAY: {
+			bool read_only = r.get_u8();
+			Variant::Type typed_builtin = r.get_type();
+			StringName typed_class_name = r.get_string();
+			Variant typed_script;
+			_read_variant(r, typed_script, p_depth + 1);
+			uint32_t count = r.get_count();
+			if (r.failed) {
+				return;
+			}
+
+			Array array;
+			if (typed_builtin != Variant::NIL) {
+				array.set_typed(typed_builtin, typed_class_name, typed_script);
+			}
+			for (uint32_t i = 0; i < count && !r.failed; i++) {
+				Variant element;
+				_read_variant(r, element, p_depth + 1);
+				array.push_back(element);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_variant = array;
+		} break;
+		case VARIANT_DICTIONARY: {
+			bool read_only = r.get_u8();
+			uint32_t count = r.get_count();
+
+			Dictionary dictionary;
+			for (uint32_t i = 0; i < count && !r.failed; i++) {
+				Variant key;
+				Variant value;
+				_read_variant(r, key, p_depth + 1);
+				_read_variant(r, value, p_depth + 1);
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_variant = dictionary;
+		} break;
+		default: {
+			r.failed = true;
+		} break;
+	}
+}
+
+void GDScriptBytecodeCache::_read_property_info(Reader &r, PropertyInfo &r_info) {
+	r_info.type = r.get_type();
+	r_info.name = r.get_string();
+	r_info.class_name = r.get_string();
+	r_info.hint = (PropertyHint)r.get_u32();
+	r_info.hint_string = r.get_string();
+	r_info.usage = r.get_u32();
+}
+
+void GDScriptBytecodeCache::_read_method_info(Reader &r, MethodInfo &r_info) {
+	r_info.name = r.get_string();
+	_read_property_info(r, r_info.return_val);
+	r_info.flags = r.get_u32();
+	r_info.id = r.get_s32();
+	r_info.return_val_metadata = r.get_s32();
+
+	uint32_t argument_count = r.get_count();
+	for (uint32_t i = 0; i < argument_count && !r.failed; i++) {
+		PropertyInfo argument;
+		_read_property_info(r, argument);
+		r_info.arguments.push_back(argument);
+	}
+
+	uint32_t default_count = r.get_count();
+	r_info.default_arguments.resize(default_count);
+	for (uint32_t i = 0; i < default_count && !r.failed; i++) {
+		_read_variant(r, r_info.default_arguments.write[i]);
+	}
+
+	uint32_t metadata_count = r.get_count();
+	r_info.arguments_metadata.resize(metadata_count);
+	for (uint32_t i = 0; i < metadata_count; i++) {
+		r_info.arguments_metadata.write[i] = r.get_s32();
+	}
+}
+
+// Classes of the script being loaded are returned without a reference in `r_ref`, like the compiler does
+// for local classes, to avoid cyclic references.
+GDScript *GDScriptBytecodeCache::_read_gdscript(Reader &r, Ref<GDScript> &r_ref) {
+	String path = r.get_string();
+	String fqcn = r.get_string();
+	if (r.failed) {
+		return nullptr;
+	}
+
+	if (path == r.main_script->path) {
+		return r.main_script->find_class(fqcn);
+	}
+
+	Error err = OK;
+	Ref<GDScript> root = GDScriptCache::get_shallow_script(path, err, r.main_script->path);
+	if (err != OK || root.is_null()) {
+		return nullptr;
+	}
+	r_ref = Ref<GDScript>(root->find_class(fqcn));
+	return r_ref.ptr();
+}
+
+void GDScriptBytecodeCache::_read_data_type(Reader &r, GDScriptDataType &r_type) {
+	uint8_t kind = r.get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		r.failed = true;
+		return;
+	}
+	r_type.kind = (GDScriptDataType::Kind)kind;
+	r_type.has_type = r.get_u8();
+	r_type.builtin_type = r.get_type();
+	r_type.native_type = r.get_string();
+
+	switch (r.get_u8()) {
+		case SCRIPT_NONE:
+			break;
+		case SCRIPT_GDSCRIPT: {
+			Ref<GDScript> ref;
+			r_type.script_type = _read_gdscript(r, ref);
+			r_type.script_type_ref = ref;
+			if (r_type.script_type == nullptr) {
+				r.failed = true;
+			}
+		} break;
+		case SCRIPT_RESOURCE: {
+			String path = r.get_string();
+			if (r.failed) {
+				return;
+			}
+			r_type.script_type_ref = ResourceLoader::load(path);
+			r_type.script_type = r_type.script_type_ref.ptr();
+			if (r_type.script_type == nullptr) {
+				r.failed = true;
+			}
+		} break;
+		default: {
+			r.failed = true;
+		} break;
+	}
+
+	uint32_t element_count = r.get_count();
+	r_type.container_element_types.resize(element_count);
+	for (uint32_t i = 0; i < element_count && !r.failed; i++) {
+		_read_data_type(r, r_type.container_element_types.write[i]);
+	}
+}
+
+void GDScriptBytecodeCache::_read_member_info(Reader &r, GDScript::MemberInfo &r_info) {
+	r_info.index = r.get_s32();
+	r_info.setter = r.get_string();
+	r_info.getter = r.get_string();
+	_read_data_type(r, r_info.data_type);
+	_read_property_info(r, r_info.property_info);
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &r, GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+
+	function->name = r.get_string();
+	function->_static = r.get_u8();
+	function->_initial_line = r.get_s32();
+	function->_argument_count = r.get_s32();
+	function->_stack_size = r.get_s32();
+	function->_instruction_args_size = r.get_s32();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	_read_data_type(r, function->return_type);
+	uint32_t argument_count = r.get_count();
+	function->argument_types.resize(argument_count);
+	for (uint32_t i = 0; i < argument_count && !r.failed; i++) {
+		_read_data_type(r, function->argument_types.write[i]);
+	}
+	_read_method_info(r, function->method_info);
+	_read_variant(r, function->rpc_config);
+
+	uint32_t temporary_count = r.get_count();
+	for (uint32_t i = 0; i < temporary_count && !r.failed; i++) {
+		int slot = r.get_s32();
+		function->temporary_slots[slot] = r.get_type();
+	}
+
+	uint32_t code_size = r.get_count();
+	function->code.resize(code_size);
+	for (uint32_t i = 0; i < code_size; i++) {
+		function->code.write[i] = r.get_s32();
+	}
+
+	// Global indices depend on registration order, so they were stored as names.
+	uint32_t global_count = r.get_count();
+	Vector<int> global_indices;
+	global_indices.resize(global_count);
+	for (uint32_t i = 0; i < global_count && !r.failed; i++) {
+		HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(r.get_string());
+		if (!E) {
+			r.failed = true;
+			break;
+		}
+		global_indices.write[i] = E->value;
+	}
+	for (int ip = 0; ip < function->code.size() && !r.failed;) {
+		int size = GDScriptByteCodeOptimizer::get_instruction_size(function->code.ptr(), function->code.size(), ip);
+		if (size <= 0 || ip + size > function->code.size()) {
+			r.failed = true;
+			break;
+		}
+		if (function->code[ip] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			int global = function->code[ip + 2];
+			if (global < 0 || global >= global_indices.size()) {
+				r.failed = true;
+				break;
+			}
+			function->code.write[ip + 2] = global_indices[global];
+		} else if (function->code[ip] == GDScriptFunction::OPCODE_OPERATOR) {
+			_reset_operator_cache(function->code.ptrw(), ip, size);
+		}
+		ip += size;
+	}
+
+	uint32_t default_argument_count = r.get_count();
+	function->default_arguments.resize(default_argument_count);
+	for (uint32_t i = 0; i < default_argument_count; i++) {
+		function->default_arguments.write[i] = r.get_s32();
+	}
+
+	uint32_t constant_count = r.get_count();
+	function->constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count && !r.failed; i++) {
+		_read_variant(r, function->constants.write[i]);
+	}
+
+	uint32_t global_name_count = r.get_count();
+	function->global_names.resize(global_name_count);
+	for (uint32_t i = 0; i < global_name_count; i++) {
+		function->global_names.write[i] = r.get_string();
+	}
+
+	uint32_t operator_count = r.get_count();
+	function->operator_funcs.resize(operator_count);
+	for (uint32_t i = 0; i < operator_count && !r.failed; i++) {
+		uint32_t op = r.get_u32();
+		Variant::Type type_a = r.get_type();
+		Variant::Type type_b = r.get_type();
+		function->operator_funcs.write[i] = op < Variant::OP_MAX ? Variant::get_validated_operator_evaluator((Variant::Operator)op, type_a, type_b) : nullptr;
+		r.failed = r.failed || function->operator_funcs[i] == nullptr;
+	}
+
+	uint32_t setter_count = r.get_count();
+	function->setters.resize(setter_count);
+	for (uint32_t i = 0; i < setter_count && !r.failed; i++) {
+		Variant::Type type = r.get_type();
+		function->setters.write[i] = Variant::get_member_validated_setter(type, r.get_string());
+		r.failed = r.failed || function->setters[i] == nullptr;
+	}
+
+	uint32_t getter_count = r.get_count();
+	function->getters.resize(getter_count);
+	for (uint32_t i = 0; i < getter_count && !r.failed; i++) {
+		Variant::Type type = r.get_type();
+		function->getters.write[i] = Variant::get_member_validated_getter(type, r.get_string());
+		r.failed = r.failed || function->getters[i] == nullptr;
+	}
+
+	uint32_t keyed_setter_count = r.get_count();
+	function->keyed_setters.resize(keyed_setter_count);
+	for (uint32_t i = 0; i < keyed_setter_count && !r.failed; i++) {
+		function->keyed_setters.write[i] = Variant::get_member_validated_keyed_setter(r.get_type());
+		r.failed = r.failed || function->keyed_setters[i] == nullptr;
+	}
+
+	uint32_t keyed_getter_count = r.get_count();
+	function->keyed_getters.resize(keyed_getter_count);
+	for (uint32_t i = 0; i < keyed_getter_count && !r.failed; i++) {
+		function->keyed_getters.write[i] = Variant::get_member_validated_keyed_getter(r.get_type());
+		r.failed = r.failed || function->keyed_getters[i] == nullptr;
+	}
+
+	uint32_t indexed_setter_count = r.get_count();
+	function->indexed_setters.resize(indexed_setter_count);
+	for (uint32_t i = 0; i < indexed_setter_count && !r.failed; i++) {
+		function->indexed_setters.write[i] = Variant::get_member_validated_indexed_setter(r.get_type());
+		r.failed = r.failed || function->indexed_setters[i] == nullptr;
+	}
+
+	uint32_t indexed_getter_count = r.get_count();
+	function->indexed_getters.resize(indexed_getter_count);
+	for (uint32_t i = 0; i < indexed_getter_count && !r.failed; i++) {
+		function->indexed_getters.write[i] = Variant::get_member_validated_indexed_getter(r.get_type());
+		r.failed = r.failed || function->indexed_getters[i] == nullptr;
+	}
+
+	uint32_t builtin_method_count = r.get_count();
+	function->builtin_methods.resize(builtin_method_count);
+	for (uint32_t i = 0; i < builtin_method_count && !r.failed; i++) {
+		Variant::Type type = r.get_type();
+		function->builtin_methods.write[i] = Variant::get_validated_builtin_method(type, r.get_string());
+		r.failed = r.failed || function->builtin_methods[i] == nullptr;
+	}
+
+	uint32_t constructor_count = r.get_count();
+	function->constructors.resize(constructor_count);
+	for (uint32_t i = 0; i < constructor_count && !r.failed; i++) {
+		Variant::Type type = r.get_type();
+		int index = r.get_s32();
+		function->constructors.write[i] = index >= 0 && index < Variant::get_constructor_count(type) ? Variant::get_validated_constructor(type, index) : nullptr;
+		r.failed = r.failed || function->constructors[i] == nullptr;
+	}
+
+	uint32_t utility_count = r.get_count();
+	function->utilities.resize(utility_count);
+	for (uint32_t i = 0; i < utility_count && !r.failed; i++) {
+		function->utilities.write[i] = Variant::get_validated_utility_function(r.get_string());
+		r.failed = r.failed || function->utilities[i] == nullptr;
+	}
+
+	uint32_t gds_utility_count = r.get_count();
+	function->gds_utilities.resize(gds_utility_count);
+	for (uint32_t i = 0; i < gds_utility_count && !r.failed; i++) {
+		function->gds_utilities.write[i] = GDScriptUtilityFunctions::get_function(r.get_string());
+		r.failed = r.failed || function->gds_utilities[i] == nullptr;
+	}
+
+	uint32_t method_count = r.get_count();
+	function->methods.resize(method_count);
+	for (uint32_t i = 0; i < method_count && !r.failed; i++) {
+		StringName class_name = r.get_string();
+		StringName method_name = r.get_string();
+		function->methods.write[i] = r.failed ? nullptr : ClassDB::get_method(class_name, method_name);
+		r.failed = r.failed || function->methods[i] == nullptr;
+	}
+
+	// Lambdas are owned by the function, so they are deleted with it if anything fails.
+	uint32_t lambda_count = r.get_count();
+	for (uint32_t i = 0; i < lambda_count && !r.failed; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = r.get_s32();
+		info.use_self = r.get_u8();
+		GDScriptFunction *lambda = _read_function(r, p_script);
+		if (lambda == nullptr) {
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		p_script->lambda_info.insert(lambda, info);
+	}
+
+	int inline_cache_count = r.get_s32();
+
+	Vector<String> debug_names[7];
+	for (Vector<String> &names : debug_names) {
+		uint32_t count = r.get_count();
+		names.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			names.write[i] = r.get_string();
+		}
+	}
+
+	if (r.failed || inline_cache_count < 0) {
+		r.failed = true;
+		memdelete(function);
+		return nullptr;
+	}
+
+#ifdef DEBUG_ENABLED
+	function->operator_names = debug_names[0];
+	function->setter_names = debug_names[1];
+	function->getter_names = debug_names[2];
+	function->builtin_methods_names = debug_names[3];
+	function->constructors_names = debug_names[4];
+	function->utilities_names = debug_names[5];
+	function->gds_utilities_names = debug_names[6];
+#endif
+
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->_code_size ? function->code.ptrw() : nullptr;
+	function->_default_arg_count = function->default_arguments.size() ? function->default_arguments.size() - 1 : 0;
+	function->_default_arg_ptr = function->default_arguments.size() ? function->default_arguments.ptr() : nullptr;
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->_constant_count ? function->constants.ptrw() : nullptr;
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->_global_names_count ? function->global_names.ptr() : nullptr;
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_operator_funcs_ptr = function->_operator_funcs_count ? function->operator_funcs.ptr() : nullptr;
+	function->_setters_count = function->setters.size();
+	function->_setters_ptr = function->_setters_count ? function->setters.ptr() : nullptr;
+	function->_getters_count = function->getters.size();
+	function->_getters_ptr = function->_getters_count ? function->getters.ptr() : nullptr;
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_setters_ptr = function->_keyed_setters_count ? function->keyed_setters.ptr() : nullptr;
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_keyed_getters_ptr = function->_keyed_getters_count ? function->keyed_getters.ptr() : nullptr;
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_setters_ptr = function->_indexed_setters_count ? function->indexed_setters.ptr() : nullptr;
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_indexed_getters_ptr = function->_indexed_getters_count ? function->indexed_getters.ptr() : nullptr;
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_builtin_methods_ptr = function->_builtin_methods_count ? function->builtin_methods.ptr() : nullptr;
+	function->_constructors_count = function->constructors.size();
+	function->_constructors_ptr = function->_constructors_count ? function->constructors.ptr() : nullptr;
+	function->_utilities_count = function->utilities.size();
+	function->_utilities_ptr = function->_utilities_count ? function->utilities.ptr() : nullptr;
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_gds_utilities_ptr = function->_gds_utilities_count ? function->gds_utilities.ptr() : nullptr;
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->_methods_count ? function->methods.ptrw() : nullptr;
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->_lambdas_count ? function->lambdas.ptrw() : nullptr;
+	function->inline_caches.resize(inline_cache_count);
+	function->_inline_caches_count = inline_cache_count;
+	function->_inline_caches_ptr = inline_cache_count ? function->inline_caches.ptrw() : nullptr;
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_read_skeleton(Reader &r, GDScript *p_script) {
+	p_script->fully_qualified_name = r.get_string();
+	p_script->local_name = r.get_string();
+	p_script->global_name = r.get_string();
+	p_script->simplified_icon_path = r.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	uint32_t subclass_count = r.get_count();
+	for (uint32_t i = 0; i < subclass_count && !r.failed; i++) {
+		StringName name = r.get_string();
+		String fqcn = r.get_string();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fqcn);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_read_skeleton(r, subclass.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_class(Reader &r, GDScript *p_script) {
+	p_script->tool = r.get_u8();
+
+	StringName native_name = r.get_string();
+	HashMap<StringName, int>::ConstIterator native = GDScriptLanguage::get_singleton()->get_global_map().find(native_name);
+	if (!native) {
+		r.failed = true;
+		return;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native->value];
+	if (p_script->native.is_null()) {
+		r.failed = true;
+		return;
+	}
+
+	if (r.get_u8()) {
+		Ref<GDScript> base_ref;
+		GDScript *base = _read_gdscript(r, base_ref);
+		if (base == nullptr) {
+			r.failed = true;
+			return;
+		}
+		p_script->base = Ref<GDScript>(base);
+		p_script->_base = base;
+	}
+
+	uint32_t member_count = r.get_count();
+	for (uint32_t i = 0; i < member_count && !r.failed; i++) {
+		StringName name = r.get_string();
+		_read_member_info(r, p_script->member_indices[name]);
+	}
+
+	uint32_t own_member_count = r.get_count();
+	for (uint32_t i = 0; i < own_member_count && !r.failed; i++) {
+		p_script->members.insert(r.get_string());
+	}
+
+	uint32_t static_count = r.get_count();
+	for (uint32_t i = 0; i < static_count && !r.failed; i++) {
+		StringName name = r.get_string();
+		_read_member_info(r, p_script->static_variables_indices[name]);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	uint32_t constant_count = r.get_count();
+	for (uint32_t i = 0; i < constant_count && !r.failed; i++) {
+		StringName name = r.get_string();
+		_read_variant(r, p_script->constants[name]);
+	}
+
+	uint32_t signal_count = r.get_count();
+	for (uint32_t i = 0; i < signal_count && !r.failed; i++) {
+		StringName name = r.get_string();
+		_read_method_info(r, p_script->_signals[name]);
+	}
+
+	Variant rpc_config;
+	_read_variant(r, rpc_config);
+	p_script->rpc_config = rpc_config;
+
+	uint32_t function_count = r.get_count();
+	for (uint32_t i = 0; i < function_count && !r.failed; i++) {
+		GDScriptFunction *function = _read_function(r, p_script);
+		if (function == nullptr) {
+			return;
+		}
+		p_script->member_functions[function->name] = function;
+	}
+	if (GDScriptFunction **initializer = p_script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init)) {
+		p_script->initializer = *initializer;
+	}
+
+	GDScriptFunction **special_functions[] = { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer };
+	for (GDScriptFunction **special_function : special_functions) {
+		if (r.get_u8()) {
+			*special_function = _read_function(r, p_script);
+		}
+	}
+
+	uint32_t subclass_count = r.get_count();
+	for (uint32_t i = 0; i < subclass_count && !r.failed; i++) {
+		StringName name = r.get_string();
+		HashMap<StringName, Ref<GDScript>>::Iterator E = p_script->subclasses.find(name);
+		if (!E) {
+			r.failed = true;
+			return;
+		}
+		_read_class(r, E->value.ptr());
+	}
+
+	p_script->valid = !r.failed;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_contents) {
+	Reader r(p_contents, p_script);
+	_read_skeleton(r, p_script);
+	return r.failed ? ERR_INVALID_DATA : OK;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_contents) {
+	// Only scripts that were never compiled are filled from the cache, hot-reloading goes through the compiler.
+	if (!p_script->member_functions.is_empty() || p_script->implicit_initializer != nullptr) {
+		return ERR_ALREADY_IN_USE;
+	}
+
+	// Member layouts and functions are about to change.
+	GDScriptFunction::InlineCache::invalidate_all();
+
+	Reader r(p_contents, p_script);
+	p_script->_owner = nullptr;
+	_read_skeleton(r, p_script);
+	_read_class(r, p_script);
+	bool has_static_data = r.get_u8();
+
+	if (r.failed || r.pos != r.size) {
+		p_script->valid = false;
+		print_verbose(vformat(R"(GDScript: Compiled bytecode for "%s" can't be used, compiling the script instead.)", p_script->path));
+		return ERR_INVALID_DATA;
+	}
+
+	if (has_static_data) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	Error err = GDScriptCache::finish_compiling(p_script->path);
+	if (err) {
+		p_script->valid = false;
+	}
+	return err;
+}
+
+/* Saving */
+
+#ifdef TOOLS_ENABLED
+
+// Maps the validated calls stored in functions back to what they were looked up with.
+struct GDScriptBytecodeCacheSymbols {
+	RBMap<Variant::ValidatedOperatorEvaluator, uint32_t> operators; // Operator, left type and right type, one byte each.
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+	HashMap<int, StringName> global_names;
+	HashMap<Object *, StringName> global_objects;
+
+	// Keeps the first key found for a pointer, so lookups are deterministic.
+	template <typename K, typename V>
+	static void add(RBMap<K, V> &r_map, K p_key, const V &p_value) {
+		if (p_key != nullptr && !r_map.has(p_key)) {
+			r_map.insert(p_key, p_value);
+		}
+	}
+
+	template <typename K, typename V>
+	static const V *get(const RBMap<K, V> &p_map, K p_key) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+		return E ? &E->value() : nullptr;
+	}
+
+	GDScriptBytecodeCacheSymbols() {
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int a = 0; a < Variant::VARIANT_MAX; a++) {
+				for (int b = 0; b < Variant::VARIANT_MAX; b++) {
+					add(operators, Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)a, (Variant::Type)b), uint32_t(op | (a << 8) | (b << 16)));
+				}
+			}
+		}
+
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = (Variant::Type)i;
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &E : members) {
+				add(setters, Variant::get_member_validated_setter(type, E), Pair<Variant::Type, StringName>(type, E));
+				add(getters, Variant::get_member_validated_getter(type, E), Pair<Variant::Type, StringName>(type, E));
+			}
+
+			add(keyed_setters, Variant::get_member_validated_keyed_setter(type), type);
+			add(keyed_getters, Variant::get_member_validated_keyed_getter(type), type);
+			add(indexed_setters, Variant::get_member_validated_indexed_setter(type), type);
+			add(indexed_getters, Variant::get_member_validated_indexed_getter(type), type);
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &E : methods) {
+				add(builtin_methods, Variant::get_validated_builtin_method(type, E), Pair<Variant::Type, StringName>(type, E));
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				add(constructors, Variant::get_validated_constructor(type, j), Pair<Variant::Type, int>(type, j));
+			}
+		}
+
+		List<StringName> utility_functions;
+		Variant::get_utility_function_list(&utility_functions);
+		for (const StringName &E : utility_functions) {
+			add(utilities, Variant::get_validated_utility_function(E), E);
+		}
+
+		List<StringName> gds_utility_functions;
+		GDScriptUtilityFunctions::get_function_list(&gds_utility_functions);
+		for (const StringName &E : gds_utility_functions) {
+			add(gds_utilities, GDScriptUtilityFunctions::get_function(E), E);
+		}
+
+		for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+			global_names[E.value] = E.key;
+			const Variant &global = GDScriptLanguage::get_singleton()->get_global_array()[E.value];
+			if (global.get_type() == Variant::OBJECT && global.get_validated_object() != nullptr) {
+				global_objects.insert(global.get_validated_object(), E.key);
+			}
+		}
+	}
+};
+
+static const GDScriptBytecodeCacheSymbols &_get_symbols() {
+	static GDScriptBytecodeCacheSymbols symbols;
+	return symbols;
+}
+
+void GDScriptBytecodeCache::_write_variant(Writer &w, const Variant &p_variant, int p_depth) {
+	if (p_depth > MAX_VARIANT_DEPTH) {
+		w.fail("Constant is nested too deeply.");
+		return;
+	}
+
+	switch (p_variant.get_type()) {
+		case Variant::OBJECT: {
+			Object *obj = p_variant.get_validated_object();
+			if (obj == nullptr) {
+				w.put_u8(VARIANT_NULL_OBJECT);
+				return;
+			}
+
+			if (const GDScript *script = Object::cast_to<GDScript>(obj)) {
+				w.put_u8(VARIANT_GDSCRIPT);
+				_write_gdscript(w, script);
+				return;
+			}
+
+			HashMap<Object *, StringName>::ConstIterator E = _get_symbols().global_objects.find(obj);
+			if (E) {
+				w.put_u8(VARIANT_GLOBAL);
+				w.put_string(E->value);
+				return;
+			}
+
+			const Resource *res = Object::cast_to<Resource>(obj);
+			if (res != nullptr && res->get_path().is_resource_file()) {
+				w.put_u8(VARIANT_RESOURCE);
+				w.put_string(res->get_path());
+				return;
+			}
+
+			w.fail(vformat(R"(Constant of type "%s" can't be stored.)", obj->get_class()));
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_variant;
+			w.put_u8(VARIANT_ARRAY);
+			w.put_u8(array.is_read_only());
+			w.put_u32(array.get_typed_builtin());
+			w.put_string(array.get_typed_class_name());
+			_write_variant(w, array.get_typed_script(), p_depth + 1);
+			w.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_write_variant(w, array[i], p_depth + 1);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_variant;
+			w.put_u8(VARIANT_DICTIONARY);
+			w.put_u8(dictionary.is_read_only());
+			w.put_u32(dictionary.size());
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			for (const Variant &key : keys) {
+				_write_variant(w, key, p_depth + 1);
+				_write_variant(w, dictionary[key], p_depth + 1);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			w.fail(vformat(R"(Constant of type "%s" can't be stored.)", Variant::get_type_name(p_variant.get_type())));
+		} break;
+		default: {
+			int length = 0;
+			Error err = encode_variant(p_variant, nullptr, length, false);
+			if (err != OK) {
+				w.fail(vformat(R"(Constant of type "%s" can't be stored.)", Variant::get_type_name(p_variant.get_type())));
+				return;
+			}
+			Vector<uint8_t> buffer;
+			buffer.resize(length);
+			encode_variant(p_variant, buffer.ptrw(), length, false);
+			w.put_u8(VARIANT_PLAIN);
+			w.put_u32(length);
+			w.put_bytes(buffer.ptr(), length);
+		} break;
+	}
+}
+
+void GDScriptBytecodeCache::_write_property_info(Writer &w, const PropertyInfo &p_info) {
+	w.put_u32(p_info.type);
+	w.put_string(p_info.name);
+	w.put_string(p_info.class_name);
+	w.put_u32(p_info.hint);
+	w.put_string(p_info.hint_string);
+	w.put_u32(p_info.usage);
+}
+
+void GDScriptBytecodeCache::_write_method_info(Writer &w, const MethodInfo &p_info) {
+	w.put_string(p_info.name);
+	_write_property_info(w, p_info.return_val);
+	w.put_u32(p_info.flags);
+	w.put_s32(p_info.id);
+	w.put_s32(p_info.return_val_metadata);
+
+	w.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &E : p_info.arguments) {
+		_write_property_info(w, E);
+	}
+
+	w.put_u32(p_info.default_arguments.size());
+	for (const Variant &E : p_info.default_arguments) {
+		_write_variant(w, E);
+	}
+
+	w.put_u32(p_info.arguments_metadata.size());
+	for (int E : p_info.arguments_metadata) {
+		w.put_s32(E);
+	}
+}
+
+void GDScriptBytecodeCache::_write_gdscript(Writer &w, const GDScript *p_script) {
+	if (p_script->path.is_empty() || !p_script->path.is_resource_file()) {
+		w.fail("Built-in scripts can't be referenced.");
+	}
+	w.put_string(p_script->path);
+	w.put_string(p_script->fully_qualified_name);
+}
+
+void GDScriptBytecodeCache::_write_data_type(Writer &w, const GDScriptDataType &p_type) {
+	w.put_u8(p_type.kind);
+	w.put_u8(p_type.has_type);
+	w.put_u32(p_type.builtin_type);
+	w.put_string(p_type.native_type);
+
+	if (p_type.script_type == nullptr) {
+		w.put_u8(SCRIPT_NONE);
+	} else if (const GDScript *script = Object::cast_to<GDScript>(p_type.script_type)) {
+		w.put_u8(SCRIPT_GDSCRIPT);
+		_write_gdscript(w, script);
+	} else {
+		if (!p_type.script_type->get_path().is_resource_file()) {
+			w.fail("Built-in scripts can't be referenced.");
+		}
+		w.put_u8(SCRIPT_RESOURCE);
+		w.put_string(p_type.script_type->get_path());
+	}
+
+	w.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &E : p_type.container_element_types) {
+		_write_data_type(w, E);
+	}
+}
+
+void GDScriptBytecodeCache::_write_member_info(Writer &w, const GDScript::MemberInfo &p_info) {
+	w.put_s32(p_info.index);
+	w.put_string(p_info.setter);
+	w.put_string(p_info.getter);
+	_write_data_type(w, p_info.data_type);
+	_write_property_info(w, p_info.property_info);
+}
+
+void GDScriptBytecodeCache::_write_function(Writer &w, const GDScriptFunction *p_function) {
+	const GDScriptBytecodeCacheSymbols &symbols = _get_symbols();
+
+	w.put_string(p_function->name);
+	w.put_u8(p_function->_static);
+	w.put_s32(p_function->_initial_line);
+	w.put_s32(p_function->_argument_count);
+	w.put_s32(p_function->_stack_size);
+	w.put_s32(p_function->_instruction_args_size);
+
+	_write_data_type(w, p_function->return_type);
+	w.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &E : p_function->argument_types) {
+		_write_data_type(w, E);
+	}
+	_write_method_info(w, p_function->method_info);
+	_write_variant(w, p_function->rpc_config);
+
+	w.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		w.put_s32(E.key);
+		w.put_u32(E.value);
+	}
+
+	// Global indices depend on registration order, so they are stored as names.
+	Vector<int> code = p_function->code;
+	Vector<StringName> globals;
+	for (int ip = 0; ip < code.size();) {
+		int size = GDScriptByteCodeOptimizer::get_instruction_size(code.ptr(), code.size(), ip);
+		if (size <= 0) {
+			w.fail(vformat(R"(Can't decode the bytecode of "%s".)", p_function->name));
+			return;
+		}
+		if (code[ip] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			const StringName *name = symbols.global_names.getptr(code[ip + 2]);
+			if (name == nullptr) {
+				w.fail(vformat(R"(Unknown global in "%s".)", p_function->name));
+				return;
+			}
+			int index = globals.find(*name);
+			if (index == -1) {
+				index = globals.size();
+				globals.push_back(*name);
+			}
+			code.write[ip + 2] = index;
+		} else if (code[ip] == GDScriptFunction::OPCODE_OPERATOR) {
+			_reset_operator_cache(code.ptrw(), ip, size);
+		}
+		ip += size;
+	}
+	w.put_u32(code.size());
+	for (int E : code) {
+		w.put_s32(E);
+	}
+	w.put_u32(globals.size());
+	for (const StringName &E : globals) {
+		w.put_string(E);
+	}
+
+	w.put_u32(p_function->default_arguments.size());
+	for (int E : p_function->default_arguments) {
+		w.put_s32(E);
+	}
+
+	w.put_u32(p_function->constants.size());
+	for (const Variant &E : p_function->constants) {
+		_write_variant(w, E);
+	}
+
+	w.put_u32(p_function->global_names.size());
+	for (const StringName &E : p_function->global_names) {
+		w.put_string(E);
+	}
+
+	w.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator E : p_function->operator_funcs) {
+		const uint32_t *key = symbols.get(symbols.operators, E);
+		if (key == nullptr) {
+			w.fail("Unknown operator evaluator.");
+			return;
+		}
+		w.put_u32(*key & 0xFF);
+		w.put_u32((*key >> 8) & 0xFF);
+		w.put_u32((*key >> 16) & 0xFF);
+	}
+
+	w.put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter E : p_function->setters) {
+		const Pair<Variant::Type, StringName> *key = symbols.get(symbols.setters, E);
+		if (key == nullptr) {
+			w.fail("Unknown member setter.");
+			return;
+		}
+		w.put_u32(key->first);
+		w.put_string(key->second);
+	}
+
+	w.put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter E : p_function->getters) {
+		const Pair<Variant::Type, StringName> *key = symbols.get(symbols.getters, E);
+		if (key == nullptr) {
+			w.fail("Unknown member getter.");
+			return;
+		}
+		w.put_u32(key->first);
+		w.put_string(key->second);
+	}
+
+	w.put_u32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter E : p_function->keyed_setters) {
+		const Variant::Type *type = symbols.get(symbols.keyed_setters, E);
+		if (type == nullptr) {
+			w.fail("Unknown keyed setter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter E : p_function->keyed_getters) {
+		const Variant::Type *type = symbols.get(symbols.keyed_getters, E);
+		if (type == nullptr) {
+			w.fail("Unknown keyed getter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter E : p_function->indexed_setters) {
+		const Variant::Type *type = symbols.get(symbols.indexed_setters, E);
+		if (type == nullptr) {
+			w.fail("Unknown indexed setter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter E : p_function->indexed_getters) {
+		const Variant::Type *type = symbols.get(symbols.indexed_getters, E);
+		if (type == nullptr) {
+			w.fail("Unknown indexed getter.");
+			return;
+		}
+		w.put_u32(*type);
+	}
+
+	w.put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod E : p_function->builtin_methods) {
+		const Pair<Variant::Type, StringName> *key = symbols.get(symbols.builtin_methods, E);
+		if (key == nullptr) {
+			w.fail("Unknown built-in method.");
+			return;
+		}
+		w.put_u32(key->first);
+		w.put_string(key->second);
+	}
+
+	w.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor E : p_function->constructors) {
+		const Pair<Variant::Type, int> *key = symbols.get(symbols.constructors, E);
+		if (key == nullptr) {
+			w.fail("Unknown constructor.");
+			return;
+		}
+		w.put_u32(key->first);
+		w.put_s32(key->second);
+	}
+
+	w.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction E : p_function->utilities) {
+		const StringName *name = symbols.get(symbols.utilities, E);
+		if (name == nullptr) {
+			w.fail("Unknown utility function.");
+			return;
+		}
+		w.put_string(*name);
+	}
+
+	w.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr E : p_function->gds_utilities) {
+		const StringName *name = symbols.get(symbols.gds_utilities, E);
+		if (name == nullptr) {
+			w.fail("Unknown GDScript utility function.");
+			return;
+		}
+		w.put_string(*name);
+	}
+
+	w.put_u32(p_function->methods.size());
+	for (MethodBind *E : p_function->methods) {
+		if (E == nullptr || ClassDB::get_method(E->get_instance_class(), E->get_name()) != E) {
+			w.fail("Method can't be looked up by name.");
+			return;
+		}
+		w.put_string(E->get_instance_class());
+		w.put_string(E->get_name());
+	}
+
+	w.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *E : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = p_function->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(E));
+		if (info == nullptr) {
+			w.fail("Missing lambda information.");
+			return;
+		}
+		w.put_s32(info->capture_count);
+		w.put_u8(info->use_self);
+		_write_function(w, E);
+	}
+
+	w.put_s32(p_function->inline_caches.size());
+
+	const Vector<String> *debug_names[] = {
+		&p_function->operator_names,
+		&p_function->setter_names,
+		&p_function->getter_names,
+		&p_function->builtin_methods_names,
+		&p_function->constructors_names,
+		&p_function->utilities_names,
+		&p_function->gds_utilities_names,
+	};
+	for (const Vector<String> *names : debug_names) {
+		w.put_u32(names->size());
+		for (const String &E : *names) {
+			w.put_string(E);
+		}
+	}
+}
+
+void GDScriptBytecodeCache::_write_skeleton(Writer &w, const GDScript *p_script) {
+	w.put_string(p_script->fully_qualified_name);
+	w.put_string(p_script->local_name);
+	w.put_string(p_script->global_name);
+	w.put_string(p_script->simplified_icon_path);
+
+	w.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		w.put_string(E.key);
+		w.put_string(E.value->fully_qualified_name);
+		_write_skeleton(w, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_write_class(Writer &w, const GDScript *p_script) {
+	if (!p_script->valid || p_script->native.is_null()) {
+		w.fail(vformat(R"(Class "%s" is not compiled.)", p_script->fully_qualified_name));
+		return;
+	}
+
+	w.put_u8(p_script->tool);
+	w.put_string(p_script->native->get_name());
+
+	w.put_u8(p_script->base.is_valid());
+	if (p_script->base.is_valid()) {
+		_write_gdscript(w, p_script->base.ptr());
+	}
+
+	w.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		w.put_string(E.key);
+		_write_member_info(w, E.value);
+	}
+
+	w.put_u32(p_script->members.size());
+	for (const StringName &E : p_script->members) {
+		w.put_string(E);
+	}
+
+	w.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		w.put_string(E.key);
+		_write_member_info(w, E.value);
+	}
+
+	w.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		w.put_string(E.key);
+		_write_variant(w, E.value);
+	}
+
+	w.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		w.put_string(E.key);
+		_write_method_info(w, E.value);
+	}
+
+	_write_variant(w, p_script->rpc_config);
+
+	w.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_write_function(w, E.value);
+	}
+
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *special_function : special_functions) {
+		w.put_u8(special_function != nullptr);
+		if (special_function != nullptr) {
+			_write_function(w, special_function);
+		}
+	}
+
+	w.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		w.put_string(E.key);
+		_write_class(w, E.value.ptr());
+	}
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::serialize(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug) {
+	ERR_FAIL_COND_V(!p_script->is_root_script(), Vector<uint8_t>());
+
+	// The editor compiles scripts with debug-only opcodes, release builds would leave them out.
+	if (!p_debug) {
+		GDScriptCompiler::set_debug_codegen(false);
+		Error err = p_script->reload(true);
+		GDScriptCompiler::set_debug_codegen(true);
+		if (err != OK) {
+			p_script->reload(true);
+			return Vector<uint8_t>();
+		}
+	}
+
+	Writer w;
+	_write_skeleton(w, p_script);
+	_write_class(w, p_script);
+
+	HashMap<String, Ref<GDScript>>::ConstIterator E = GDScriptCache::singleton->static_gdscript_cache.find(p_script->fully_qualified_name);
+	w.put_u8(E && E->value.ptr() == p_script);
+
+	if (!p_debug) {
+		// Back to the bytecode the editor runs.
+		p_script->reload(true);
+	}
+
+	if (w.failed()) {
+		print_verbose(vformat(R"(GDScript: Can't export compiled bytecode for "%s": %s)", p_script->path, w.error));
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> buf;
+	buf.resize(24);
+	buf.write[0] = 'G';
+	buf.write[1] = 'D';
+	buf.write[2] = 'B';
+	buf.write[3] = 'C';
+	encode_uint32(FORMAT_VERSION, &buf.write[4]);
+	encode_uint32(_get_build_signature(p_debug), &buf.write[8]);
+	encode_uint32(hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size()), &buf.write[12]);
+	encode_uint32(w.data.size(), &buf.write[16]);
+
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(w.data.size(), Compression::MODE_ZSTD));
+	int compressed_size = Compression::compress(compressed.ptrw(), w.data.ptr(), w.data.size(), Compression::MODE_ZSTD);
+	ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Error compressing GDScript compiled bytecode.");
+	compressed.resize(compressed_size);
+
+	encode_uint32(compressed_size, &buf.write[20]);
+	buf.append_array(compressed);
+	return buf;
+}
+
+#endif // TOOLS_ENABLED
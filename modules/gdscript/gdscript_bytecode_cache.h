@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+
+#include "core/templates/vector.h"
+
+// Ahead-of-time compiled form of an exported script, stored as `<name>.gdbc` next to its binary tokens.
+// It holds the class layout and the final bytecode of every function, so loading it skips parsing,
+// analysis and code generation. Calls into the engine are stored by name and resolved again on load.
+// Scripts that can't be stored this way, and caches that don't match the running engine build or the
+// tokens they were made from, go through the regular compiler with the binary tokens instead.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+
+	enum VariantTag : uint8_t {
+		VARIANT_PLAIN,
+		VARIANT_NULL_OBJECT,
+		VARIANT_GDSCRIPT,
+		VARIANT_GLOBAL,
+		VARIANT_RESOURCE,
+		VARIANT_ARRAY,
+		VARIANT_DICTIONARY,
+	};
+
+	enum ScriptTag : uint8_t {
+		SCRIPT_NONE,
+		SCRIPT_GDSCRIPT,
+		SCRIPT_RESOURCE,
+	};
+
+	static uint32_t _get_build_signature(bool p_debug);
+
+	static void _read_variant(Reader &r, Variant &r_variant, int p_depth = 0);
+	static void _read_property_info(Reader &r, PropertyInfo &r_info);
+	static void _read_method_info(Reader &r, MethodInfo &r_info);
+	static GDScript *_read_gdscript(Reader &r, Ref<GDScript> &r_ref);
+	static void _read_data_type(Reader &r, GDScriptDataType &r_type);
+	static void _read_member_info(Reader &r, GDScript::MemberInfo &r_info);
+	static GDScriptFunction *_read_function(Reader &r, GDScript *p_script);
+	static void _read_skeleton(Reader &r, GDScript *p_script);
+	static void _read_class(Reader &r, GDScript *p_script);
+
+#ifdef TOOLS_ENABLED
+	static void _write_variant(Writer &w, const Variant &p_variant, int p_depth = 0);
+	static void _write_property_info(Writer &w, const PropertyInfo &p_info);
+	static void _write_method_info(Writer &w, const MethodInfo &p_info);
+	static void _write_gdscript(Writer &w, const GDScript *p_script);
+	static void _write_data_type(Writer &w, const GDScriptDataType &p_type);
+	static void _write_member_info(Writer &w, const GDScript::MemberInfo &p_info);
+	static void _write_function(Writer &w, const GDScriptFunction *p_function);
+	static void _write_skeleton(Writer &w, const GDScript *p_script);
+	static void _write_class(Writer &w, const GDScript *p_script);
+#endif
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1;
+
+	static String get_cache_path(const String &p_binary_tokens_path);
+
+	// Returns the decompressed contents of the cache stored next to `p_binary_tokens_path`, or an empty
+	// buffer if there is none or it can't be used with this engine build and these binary tokens.
+	static Vector<uint8_t> load(const String &p_binary_tokens_path, const Vector<uint8_t> &p_binary_tokens);
+
+	// Creates the inner class scripts, like `GDScriptCompiler::make_scripts()` does after parsing.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_contents);
+	// Fills `p_script` like `GDScriptCompiler::compile()` would. On error the script must be compiled from source.
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_contents);
+
+#ifdef TOOLS_ENABLED
+	// Returns an empty buffer if `p_script` contains something that can't be stored. `p_debug` tells whether
+	// the export template it is meant for is a debug one, for release ones the script is recompiled without
+	// debug-only opcodes first.
+	static Vector<uint8_t> serialize(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
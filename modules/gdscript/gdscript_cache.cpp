@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
@@ -295,6 +296,16 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		// Scripts exported with compiled bytecode don't need to be parsed.
+		Vector<uint8_t> bytecode = GDScriptBytecodeCache::load(remapped_path, script->get_binary_tokens_source());
+		if (!bytecode.is_empty() && GDScriptBytecodeCache::make_scripts(script.ptr(), bytecode) == OK) {
+			script->set_bytecode_cache_source(bytecode);
+			singleton->shallow_gdscript_cache[p_path] = script;
+			return script;
+		}
+	}
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
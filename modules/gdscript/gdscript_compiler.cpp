@@ -40,6 +40,10 @@
 
 #include "scene/scene_string_names.h"
 
+#ifdef DEBUG_ENABLED
+thread_local bool GDScriptCompiler::debug_codegen = true;
+#endif
+
 bool GDScriptCompiler::_is_class_member_property(CodeGen &codegen, const StringName &p_name) {
 	if (codegen.function_node && codegen.function_node->is_static) {
 		return false;
@@ -251,6 +255,31 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+// Whether `target op= value` can write the result straight into the target, instead of going through a temporary.
+// Only for operations evaluated on the raw values, those don't care about the target aliasing an operand.
+static bool _is_numeric_in_place_operation(const GDScriptCodeGenerator::Address &p_target, Variant::Operator p_operator, const GDScriptCodeGenerator::Address &p_value) {
+	if (p_target.mode != GDScriptCodeGenerator::Address::LOCAL_VARIABLE && p_target.mode != GDScriptCodeGenerator::Address::FUNCTION_PARAMETER) {
+		return false;
+	}
+	if (!p_target.type.has_type || p_target.type.kind != GDScriptDataType::BUILTIN || !p_value.type.has_type || p_value.type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	const Variant::Type type = p_target.type.builtin_type;
+	if ((type != Variant::INT && type != Variant::FLOAT) || p_value.type.builtin_type != type) {
+		return false;
+	}
+	switch (p_operator) {
+		case Variant::OP_ADD:
+		case Variant::OP_SUBTRACT:
+		case Variant::OP_MULTIPLY:
+			return true;
+		case Variant::OP_DIVIDE:
+			return type == Variant::FLOAT; // Integer division checks for division by zero.
+		default:
+			return false;
+	}
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -1315,6 +1344,17 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 				GDScriptCodeGenerator::Address to_assign;
 				bool has_operation = assignment->operation != GDScriptParser::AssignmentNode::OP_NONE;
+				if (has_operation && !is_member && !is_static && !assignment->use_conversion_assign && _is_numeric_in_place_operation(target, assignment->variant_op, assigned_value)) {
+					// Typed numeric locals always hold a value of their type, so the result can be written there directly.
+					gen->write_binary_operator(target, assignment->variant_op, target, assigned_value);
+					if (assigned_value.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+						gen->pop_temporary();
+					}
+					if (target.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+						gen->pop_temporary();
+					}
+					return GDScriptCodeGenerator::Address();
+				}
 				if (has_operation) {
 					// Perform operation.
 					GDScriptCodeGenerator::Address op_result = codegen.add_temporary(_gdtype_from_datatype(assignment->get_datatype(), codegen.script));
@@ -1873,7 +1913,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 #ifdef DEBUG_ENABLED
 		// Add a newline before each statement, since the debugger needs those.
-		gen->write_newline(s->start_line);
+		if (debug_codegen) {
+			gen->write_newline(s->start_line);
+		}
 #endif
 
 		switch (s->type) {
@@ -1925,7 +1967,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 #ifdef DEBUG_ENABLED
 					// Add a newline before each branch, since the debugger needs those.
-					gen->write_newline(branch->start_line);
+					if (debug_codegen) {
+						gen->write_newline(branch->start_line);
+					}
 #endif
 					// For each pattern in branch.
 					GDScriptCodeGenerator::Address pattern_result = codegen.add_temporary();
@@ -2105,6 +2149,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::ASSERT: {
 #ifdef DEBUG_ENABLED
+				if (!debug_codegen) {
+					break;
+				}
+
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
@@ -2132,7 +2180,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::BREAKPOINT: {
 #ifdef DEBUG_ENABLED
-				gen->write_breakpoint();
+				if (debug_codegen) {
+					gen->write_breakpoint();
+				}
 #endif
 			} break;
 			case GDScriptParser::Node::VARIABLE: {
@@ -3201,6 +3251,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	// Member layouts and functions are about to change.
+	GDScriptFunction::InlineCache::invalidate_all();
+
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
 	// Create scripts for subclasses beforehand so they can be referenced
@@ -175,7 +175,18 @@ class GDScriptCompiler {
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
 
+#ifdef DEBUG_ENABLED
+	static thread_local bool debug_codegen;
+#endif
+
 public:
+#ifdef DEBUG_ENABLED
+	// When disabled, line, breakpoint and assert opcodes are left out, as in builds without DEBUG_ENABLED.
+	// Used to compile bytecode ahead of time for release export templates.
+	static void set_debug_codegen(bool p_enabled) { debug_codegen = p_enabled; }
+	static bool is_debug_codegen() { return debug_codegen; }
+#endif
+
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
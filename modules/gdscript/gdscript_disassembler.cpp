@@ -141,6 +141,54 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator ";
+
+				text += DADDR(5);
+				text += " = ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 6;
+			} break;
+
+#define DISASSEMBLE_OPERATOR_UNBOXED(m_name, m_type, m_op) \
+	case OPCODE_OPERATOR_##m_name: {                       \
+		text += "operator (";                              \
+		text += m_type;                                    \
+		text += ") ";                                      \
+		text += DADDR(3);                                  \
+		text += " = ";                                     \
+		text += DADDR(1);                                  \
+		text += " " m_op " ";                              \
+		text += DADDR(2);                                  \
+		incr += 4;                                         \
+	} break
+
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_ADD, "int", "+");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_SUBTRACT, "int", "-");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_MULTIPLY, "int", "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_EQUAL, "int", "==");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_NOT_EQUAL, "int", "!=");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_LESS, "int", "<");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_LESS_EQUAL, "int", "<=");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_GREATER, "int", ">");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_GREATER_EQUAL, "int", ">=");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_ADD, "float", "+");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_SUBTRACT, "float", "-");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_MULTIPLY, "float", "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_DIVIDE, "float", "/");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_EQUAL, "float", "==");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_NOT_EQUAL, "float", "!=");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_LESS, "float", "<");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_LESS_EQUAL, "float", "<=");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_GREATER, "float", ">");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_GREATER_EQUAL, "float", ">=");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -267,7 +315,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -288,7 +336,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -320,6 +368,26 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 3;
 			} break;
+			case OPCODE_UPDATE_MEMBER_VALIDATED: {
+				text += "update_member ";
+				text += "[\"";
+				text += _global_names_ptr[_code_ptr[ip + 2]];
+				text += "\"] = ";
+				text += DADDR(5);
+				text += " = ";
+				text += DADDR(3);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 6]];
+				text += " ";
+				text += DADDR(4);
+				text += " (";
+				text += DADDR(1);
+				text += " = [\"";
+				text += _global_names_ptr[_code_ptr[ip + 2]];
+				text += "\"])";
+
+				incr += 7;
+			} break;
 			case OPCODE_SET_STATIC_VARIABLE: {
 				Ref<GDScript> gdscript = get_constant(_code_ptr[ip + 2] & ADDR_MASK);
 
@@ -597,7 +665,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -945,6 +1013,34 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+
+#define DISASSEMBLE_JUMP_IF_NOT_UNBOXED(m_name, m_type, m_op) \
+	case OPCODE_JUMP_IF_NOT_##m_name: {                       \
+		text += "jump-if-not (";                              \
+		text += m_type;                                       \
+		text += ") ";                                         \
+		text += DADDR(3);                                     \
+		text += " = ";                                        \
+		text += DADDR(1);                                     \
+		text += " " m_op " ";                                 \
+		text += DADDR(2);                                     \
+		text += " to ";                                       \
+		text += itos(_code_ptr[ip + 4]);                      \
+		incr = 5;                                             \
+	} break
+
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_EQUAL, "int", "==");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_NOT_EQUAL, "int", "!=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_LESS, "int", "<");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_LESS_EQUAL, "int", "<=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_GREATER, "int", ">");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_GREATER_EQUAL, "int", ">=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_EQUAL, "float", "==");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_NOT_EQUAL, "float", "!=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS, "float", "<");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS_EQUAL, "float", "<=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER, "float", ">");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER_EQUAL, "float", ">=");
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
@@ -958,6 +1054,21 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += _code_ptr[ip] == OPCODE_OPERATOR_VALIDATED_JUMP_IF ? "jump-if " : "jump-if-not ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
 			case OPCODE_RETURN: {
 				text += "return ";
 				text += DADDR(1);
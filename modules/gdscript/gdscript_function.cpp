@@ -134,24 +134,127 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+// Coroutine stacks are recycled through a per-thread free list, bucketed by power of two sizes,
+// so that code awaiting in a loop does not hit the allocator on every `await`.
+struct GDScriptFunctionStateStackPool {
+	static constexpr uint32_t MIN_SHIFT = 6; // 64 bytes.
+	static constexpr uint32_t BUCKET_COUNT = 11; // Up to 64 KiB, bigger stacks are not pooled.
+	static constexpr uint32_t MAX_FREE_PER_BUCKET = 256;
+
+	LocalVector<uint8_t *> free_buffers[BUCKET_COUNT];
+
+	static uint32_t get_bucket(uint32_t p_size) {
+		uint32_t shift = MAX(nearest_shift(p_size - 1), MIN_SHIFT);
+		return shift - MIN_SHIFT;
+	}
+
+	~GDScriptFunctionStateStackPool() {
+		for (LocalVector<uint8_t *> &buffers : free_buffers) {
+			for (uint8_t *buffer : buffers) {
+				memfree(buffer);
+			}
+		}
+	}
+};
+
+static thread_local GDScriptFunctionStateStackPool stack_pool;
+
+uint8_t *GDScriptFunctionState::_alloc_stack(uint32_t p_size) {
+	uint32_t bucket = GDScriptFunctionStateStackPool::get_bucket(p_size);
+	if (bucket >= GDScriptFunctionStateStackPool::BUCKET_COUNT) {
+		return (uint8_t *)memalloc(p_size);
+	}
+	LocalVector<uint8_t *> &buffers = stack_pool.free_buffers[bucket];
+	if (!buffers.is_empty()) {
+		uint8_t *buffer = buffers[buffers.size() - 1];
+		buffers.resize(buffers.size() - 1);
+		return buffer;
+	}
+	return (uint8_t *)memalloc(1 << (bucket + GDScriptFunctionStateStackPool::MIN_SHIFT));
+}
+
+void GDScriptFunctionState::_free_stack(uint8_t *p_stack, uint32_t p_size) {
+	uint32_t bucket = GDScriptFunctionStateStackPool::get_bucket(p_size);
+	if (bucket >= GDScriptFunctionStateStackPool::BUCKET_COUNT || stack_pool.free_buffers[bucket].size() >= GDScriptFunctionStateStackPool::MAX_FREE_PER_BUCKET) {
+		memfree(p_stack);
+		return;
+	}
+	// May be a different thread than the one that allocated it, the buffer just changes pools.
+	stack_pool.free_buffers[bucket].push_back(p_stack);
+}
+
+// Resumes the awaiting function directly from the signal, instead of going through
+// a bound method callable, which needs an extra allocation and a method lookup.
+class GDScriptFunctionStateCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> state;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return p_a == p_b;
+	}
+
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return p_a < p_b;
+	}
+
+public:
+	uint32_t hash() const override {
+		return hash_one_uint64((uint64_t)state->get_instance_id());
+	}
+
+	String get_as_text() const override {
+		return "GDScriptFunctionState::resume";
+	}
+
+	CompareEqualFunc get_compare_equal_func() const override {
+		return compare_equal;
+	}
+
+	CompareLessFunc get_compare_less_func() const override {
+		return compare_less;
+	}
+
+	ObjectID get_object() const override {
+		return state->get_instance_id();
+	}
+
+	StringName get_method() const override {
+		return SNAME("resume");
+	}
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		r_call_error.error = Callable::CallError::CALL_OK;
+		r_return_value = state->resume(GDScriptFunctionState::_signal_arg(p_arguments, p_argcount));
+	}
+
+	GDScriptFunctionStateCallable(GDScriptFunctionState *p_state) :
+			state(p_state) {}
+};
+
+Variant GDScriptFunctionState::_signal_arg(const Variant **p_args, int p_argcount) {
+	if (p_argcount == 0) {
+		return Variant();
+	} else if (p_argcount == 1) {
+		return *p_args[0];
+	}
+
+	Array extra_args;
+	for (int i = 0; i < p_argcount; i++) {
+		extra_args.push_back(*p_args[i]);
+	}
+	return extra_args;
+}
+
+Error GDScriptFunctionState::_connect_await(Signal p_signal) {
+	return p_signal.connect(Callable(memnew(GDScriptFunctionStateCallable(this))), Object::CONNECT_ONE_SHOT);
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
-	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
 
 	if (p_argcount == 0) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.expected = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
@@ -163,7 +266,7 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		return Variant();
 	}
 
-	return resume(arg);
+	return resume(_signal_arg(p_args, p_argcount - 1));
 }
 
 bool GDScriptFunctionState::is_valid(bool p_extended_check) const {
@@ -215,43 +318,31 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 	Callable::CallError err;
 	Variant ret = function->call(nullptr, nullptr, 0, err, &state);
 
-	bool completed = true;
+	state.result = Variant();
 
-	// If the return value is a GDScriptFunctionState reference,
-	// then the function did await again after resuming.
-	if (ret.is_ref_counted()) {
-		GDScriptFunctionState *gdfs = Object::cast_to<GDScriptFunctionState>(ret);
-		if (gdfs && gdfs->function == function) {
-			completed = false;
-			gdfs->first_state = first_state.is_valid() ? first_state : Ref<GDScriptFunctionState>(this);
-		}
+	if (scripts_list.in_list()) {
+		// The function awaited again, which re-armed this same state in place.
+		return ret;
 	}
 
 	function = nullptr; //cleaned up;
-	state.result = Variant();
 
-	if (completed) {
-		if (first_state.is_valid()) {
-			first_state->emit_signal(SNAME("completed"), ret);
-		} else {
-			emit_signal(SNAME("completed"), ret);
-		}
+	emit_signal(SNAME("completed"), ret);
 
 #ifdef DEBUG_ENABLED
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->exit_function();
-		}
+	if (EngineDebugger::is_active()) {
+		GDScriptLanguage::get_singleton()->exit_function();
+	}
 
-		_clear_stack();
+	_clear_stack();
 #endif
-	}
 
 	return ret;
 }
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
@@ -280,6 +371,7 @@ void GDScriptFunctionState::_bind_methods() {
 GDScriptFunctionState::GDScriptFunctionState() :
 		scripts_list(this),
 		instances_list(this) {
+	state.function_state = this;
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
@@ -288,4 +380,10 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+
+	// Only left over if the function was never resumed.
+	_clear_stack();
+	if (state.stack) {
+		_free_stack(state.stack, state.alloca_size);
+	}
 }
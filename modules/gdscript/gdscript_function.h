@@ -43,6 +43,7 @@
 
 class GDScriptInstance;
 class GDScript;
+class GDScriptFunctionState;
 
 class GDScriptDataType {
 public:
@@ -218,6 +219,27 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN, // Only emitted by GDScriptByteCodeOptimizer.
+		// Operators on `int` and `float` slots known to hold that type, they work on the raw values.
+		OPCODE_OPERATOR_INT_ADD,
+		OPCODE_OPERATOR_INT_SUBTRACT,
+		OPCODE_OPERATOR_INT_MULTIPLY,
+		OPCODE_OPERATOR_INT_EQUAL,
+		OPCODE_OPERATOR_INT_NOT_EQUAL,
+		OPCODE_OPERATOR_INT_LESS,
+		OPCODE_OPERATOR_INT_LESS_EQUAL,
+		OPCODE_OPERATOR_INT_GREATER,
+		OPCODE_OPERATOR_INT_GREATER_EQUAL,
+		OPCODE_OPERATOR_FLOAT_ADD,
+		OPCODE_OPERATOR_FLOAT_SUBTRACT,
+		OPCODE_OPERATOR_FLOAT_MULTIPLY,
+		OPCODE_OPERATOR_FLOAT_DIVIDE,
+		OPCODE_OPERATOR_FLOAT_EQUAL,
+		OPCODE_OPERATOR_FLOAT_NOT_EQUAL,
+		OPCODE_OPERATOR_FLOAT_LESS,
+		OPCODE_OPERATOR_FLOAT_LESS_EQUAL,
+		OPCODE_OPERATOR_FLOAT_GREATER,
+		OPCODE_OPERATOR_FLOAT_GREATER_EQUAL,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -234,6 +256,7 @@ public:
 		OPCODE_GET_NAMED_VALIDATED,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
+		OPCODE_UPDATE_MEMBER_VALIDATED, // Only emitted by GDScriptByteCodeOptimizer.
 		OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.
 		OPCODE_GET_STATIC_VARIABLE, // Only for GDScript.
 		OPCODE_ASSIGN,
@@ -277,6 +300,21 @@ public:
 		OPCODE_JUMP_IF_NOT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF, // Only emitted by GDScriptByteCodeOptimizer.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, // Only emitted by GDScriptByteCodeOptimizer.
+		// Raw comparison followed by a jump when false, only emitted by GDScriptByteCodeOptimizer. Same order as the comparisons above.
+		OPCODE_JUMP_IF_NOT_INT_EQUAL,
+		OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL,
+		OPCODE_JUMP_IF_NOT_INT_LESS,
+		OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL,
+		OPCODE_JUMP_IF_NOT_INT_GREATER,
+		OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_LESS,
+		OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_GREATER,
+		OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL,
 		OPCODE_RETURN,
 		OPCODE_RETURN_TYPED_BUILTIN,
 		OPCODE_RETURN_TYPED_ARRAY,
@@ -397,8 +435,50 @@ public:
 		StringName identifier;
 	};
 
+	// Remembers how a name resolved for the last receivers seen at one untyped
+	// `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` or `OPCODE_CALL*` site, so that repeated
+	// accesses can skip the generic lookup. Entries are only valid while their
+	// generation matches `InlineCache::generation`, which is bumped whenever scripts
+	// are compiled or cleared.
+	struct InlineCache {
+		enum Kind : uint8_t {
+			KIND_UNCACHEABLE, // Receiver is known, but the access must take the generic path.
+			KIND_SCRIPT_MEMBER,
+			KIND_NATIVE_PROPERTY,
+			KIND_BUILTIN_MEMBER,
+			KIND_SCRIPT_FUNCTION,
+			KIND_NATIVE_METHOD,
+		};
+
+		struct Entry {
+			uint32_t generation = 0;
+			Kind kind = KIND_UNCACHEABLE;
+			Variant::Type base_type = Variant::NIL;
+			const GDScript *script = nullptr;
+			const void *native_class = nullptr; // `StringName::data_unique_pointer()` of the class name, if the entry depends on it.
+			int index = -1; // Member index for script members, property index for indexed native properties.
+			Variant::Type member_type = Variant::NIL;
+			const GDScriptDataType *member_data_type = nullptr;
+			union {
+				MethodBind *method = nullptr;
+				GDScriptFunction *function;
+				Variant::ValidatedGetter getter;
+				Variant::ValidatedSetter setter;
+			};
+		};
+
+		static constexpr int MAX_ENTRIES = 2;
+
+		Entry entries[MAX_ENTRIES];
+		uint8_t next_entry = 0;
+
+		static SafeNumeric<uint32_t> generation;
+		static void invalidate_all() { generation.increment(); }
+	};
+
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
@@ -439,6 +519,7 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	Vector<InlineCache> inline_caches;
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -457,6 +538,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -475,6 +557,7 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	InlineCache *_inline_caches_ptr = nullptr;
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -509,6 +592,24 @@ private:
 	} profile;
 #endif
 
+	struct InlineCacheReceiver {
+		Variant::Type type = Variant::NIL;
+		Object *object = nullptr;
+		GDScriptInstance *instance = nullptr;
+		const GDScript *script = nullptr;
+		const void *native_class = nullptr;
+	};
+
+	// Inline cache helpers, implemented in `gdscript_inline_cache.cpp`. They return
+	// `false` when the caller must fall back to the generic path.
+	static bool _inline_cache_get_receiver(const Variant *p_base, InlineCacheReceiver &r_receiver);
+	static InlineCache::Entry *_inline_cache_find(InlineCache &p_cache, const InlineCacheReceiver &p_receiver);
+	static InlineCache::Entry &_inline_cache_add(InlineCache &p_cache, const InlineCacheReceiver &p_receiver);
+	static bool _inline_cache_script_shadows(const GDScript *p_script, const StringName &p_name, const StringName &p_fallback);
+	static bool _inline_cache_get_named(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant *r_dst);
+	static bool _inline_cache_set_named(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+	static bool _inline_cache_call(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
@@ -516,13 +617,14 @@ public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
 	struct CallState {
+		GDScriptFunctionState *function_state = nullptr; // The state this is embedded in.
 		GDScript *script = nullptr;
 		GDScriptInstance *instance = nullptr;
 #ifdef DEBUG_ENABLED
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Pooled buffer of alloca_size bytes, owned by the GDScriptFunctionState.
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -558,14 +660,20 @@ public:
 class GDScriptFunctionState : public RefCounted {
 	GDCLASS(GDScriptFunctionState, RefCounted);
 	friend class GDScriptFunction;
+	friend class GDScriptFunctionStateCallable;
 	GDScriptFunction *function = nullptr;
 	GDScriptFunction::CallState state;
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
-	Ref<GDScriptFunctionState> first_state;
 
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	static uint8_t *_alloc_stack(uint32_t p_size);
+	static void _free_stack(uint8_t *p_stack, uint32_t p_size);
+	static Variant _signal_arg(const Variant **p_args, int p_argcount);
+
+	Error _connect_await(Signal p_signal);
+
 protected:
 	static void _bind_methods();
 
@@ -0,0 +1,351 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_function.h"
+
+#include "gdscript.h"
+
+#include "core/config/engine.h"
+#include "core/object/class_db.h"
+#include "core/variant/variant_internal.h"
+#include "scene/scene_string_names.h"
+
+SafeNumeric<uint32_t> GDScriptFunction::InlineCache::generation(1);
+
+// Walks the native class hierarchy the same way `ClassDB::get_property()` does, and returns
+// the class declaring `p_name` only if nothing else with that name is found on the way.
+static bool _get_native_property_class(const StringName &p_class, const StringName &p_name, bool p_check_shadowing, StringName &r_declaring_class) {
+	StringName class_name = p_class;
+	while (class_name != StringName()) {
+		if (ClassDB::has_property(class_name, p_name, true)) {
+			r_declaring_class = class_name;
+			return true;
+		}
+		if (p_check_shadowing && (ClassDB::has_integer_constant(class_name, p_name, true) || ClassDB::has_method(class_name, p_name, true) || ClassDB::has_signal(class_name, p_name, true))) {
+			return false;
+		}
+		class_name = ClassDB::get_parent_class_nocheck(class_name);
+	}
+	return false;
+}
+
+// Extension classes can intercept properties and be reloaded, and objects overriding
+// `Object::callp()` can't have their native methods called directly.
+static bool _is_native_cacheable(const Object *p_object) {
+	const ClassDB::APIType api = ClassDB::get_api_type(p_object->get_class_name());
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		return false;
+	}
+	return !p_object->is_class_ptr(Script::get_class_ptr_static()) && !p_object->is_class_ptr(GDScriptNativeClass::get_class_ptr_static());
+}
+
+bool GDScriptFunction::_inline_cache_get_receiver(const Variant *p_base, InlineCacheReceiver &r_receiver) {
+	// Caches are shared by every caller of the function, only the main thread uses them.
+	if (!Thread::is_main_thread()) {
+		return false;
+	}
+
+	r_receiver.type = p_base->get_type();
+	if (r_receiver.type != Variant::OBJECT) {
+		return true;
+	}
+
+	Object *obj = p_base->get_validated_object();
+	if (unlikely(!obj)) {
+		return false;
+	}
+
+	ScriptInstance *si = obj->get_script_instance();
+	if (si) {
+		if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		r_receiver.instance = static_cast<GDScriptInstance *>(si);
+		r_receiver.script = r_receiver.instance->script.ptr();
+		if (unlikely(!r_receiver.script->valid)) {
+			return false;
+		}
+	}
+
+	r_receiver.object = obj;
+	r_receiver.native_class = obj->get_class_name().data_unique_pointer();
+	return true;
+}
+
+GDScriptFunction::InlineCache::Entry *GDScriptFunction::_inline_cache_find(InlineCache &p_cache, const InlineCacheReceiver &p_receiver) {
+	const uint32_t current_generation = InlineCache::generation.get();
+	for (InlineCache::Entry &entry : p_cache.entries) {
+		if (entry.generation == current_generation && entry.base_type == p_receiver.type && entry.script == p_receiver.script && (entry.native_class == nullptr || entry.native_class == p_receiver.native_class)) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+GDScriptFunction::InlineCache::Entry &GDScriptFunction::_inline_cache_add(InlineCache &p_cache, const InlineCacheReceiver &p_receiver) {
+	InlineCache::Entry &entry = p_cache.entries[p_cache.next_entry];
+	p_cache.next_entry = (p_cache.next_entry + 1) % InlineCache::MAX_ENTRIES;
+
+	entry = InlineCache::Entry();
+	entry.generation = InlineCache::generation.get();
+	entry.base_type = p_receiver.type;
+	entry.script = p_receiver.script;
+	entry.native_class = p_receiver.native_class;
+	return entry;
+}
+
+bool GDScriptFunction::_inline_cache_script_shadows(const GDScript *p_script, const StringName &p_name, const StringName &p_fallback) {
+	for (const GDScript *script = p_script; script; script = script->_base) {
+		if (script->constants.has(p_name) || script->static_variables_indices.has(p_name) || script->_signals.has(p_name) || script->member_functions.has(p_name) || script->subclasses.has(p_name) || script->member_functions.has(p_fallback)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GDScriptFunction::_inline_cache_get_named(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant *r_dst) {
+	if (p_base->get_type() == Variant::DICTIONARY) {
+		return false;
+	}
+
+	InlineCacheReceiver receiver;
+	if (!_inline_cache_get_receiver(p_base, receiver)) {
+		return false;
+	}
+
+	InlineCache::Entry *entry = _inline_cache_find(p_cache, receiver);
+	if (!entry) {
+		entry = &_inline_cache_add(p_cache, receiver);
+		if (receiver.type != Variant::OBJECT) {
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(receiver.type, p_name);
+			if (getter) {
+				entry->kind = InlineCache::KIND_BUILTIN_MEMBER;
+				entry->getter = getter;
+				entry->member_type = Variant::get_member_type(receiver.type, p_name);
+			}
+		} else if (const GDScript::MemberInfo *member = receiver.script ? receiver.script->member_indices.getptr(p_name) : nullptr) {
+			if (!member->getter) {
+				entry->kind = InlineCache::KIND_SCRIPT_MEMBER;
+				entry->native_class = nullptr;
+				entry->index = member->index;
+			}
+		} else if (_is_native_cacheable(receiver.object) && (!receiver.script || !_inline_cache_script_shadows(receiver.script, p_name, GDScriptLanguage::get_singleton()->strings._get))) {
+			const StringName class_name = receiver.object->get_class_name();
+			StringName declaring_class;
+			if (_get_native_property_class(class_name, p_name, true, declaring_class)) {
+				const StringName getter = ClassDB::get_property_getter(declaring_class, p_name);
+				const int index = ClassDB::get_property_index(declaring_class, p_name);
+				// Indexed getters are looked up through `Object::callp()`, which may find a script function first.
+				MethodBind *method = getter ? ClassDB::get_method(index >= 0 ? class_name : declaring_class, getter) : nullptr;
+				if (method && (index < 0 || !receiver.script || !_inline_cache_script_shadows(receiver.script, getter, StringName()))) {
+					entry->kind = InlineCache::KIND_NATIVE_PROPERTY;
+					entry->method = method;
+					entry->index = index;
+				}
+			}
+		}
+	}
+
+	switch (entry->kind) {
+		case InlineCache::KIND_SCRIPT_MEMBER: {
+			Variant ret = receiver.instance->members[entry->index];
+			*r_dst = ret;
+			return true;
+		}
+		case InlineCache::KIND_NATIVE_PROPERTY: {
+			Callable::CallError ce;
+			if (entry->index >= 0) {
+				Variant index = entry->index;
+				const Variant *args[1] = { &index };
+				*r_dst = entry->method->call(receiver.object, args, 1, ce);
+			} else {
+				*r_dst = entry->method->call(receiver.object, nullptr, 0, ce);
+			}
+			return true;
+		}
+		case InlineCache::KIND_BUILTIN_MEMBER: {
+			Variant ret;
+			VariantInternal::initialize(&ret, entry->member_type);
+			entry->getter(p_base, &ret);
+			*r_dst = ret;
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_set_named(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	if (p_base->get_type() == Variant::DICTIONARY) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	// `Object::set()` also marks the object as edited, which matters to the editor.
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+#endif
+
+	InlineCacheReceiver receiver;
+	if (!_inline_cache_get_receiver(p_base, receiver)) {
+		return false;
+	}
+
+	InlineCache::Entry *entry = _inline_cache_find(p_cache, receiver);
+	if (!entry) {
+		entry = &_inline_cache_add(p_cache, receiver);
+		if (receiver.type != Variant::OBJECT) {
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(receiver.type, p_name);
+			if (setter) {
+				entry->kind = InlineCache::KIND_BUILTIN_MEMBER;
+				entry->setter = setter;
+				entry->member_type = Variant::get_member_type(receiver.type, p_name);
+			}
+		} else if (const GDScript::MemberInfo *member = receiver.script ? receiver.script->member_indices.getptr(p_name) : nullptr) {
+			if (!member->setter) {
+				entry->kind = InlineCache::KIND_SCRIPT_MEMBER;
+				entry->native_class = nullptr;
+				entry->index = member->index;
+				entry->member_data_type = &member->data_type;
+			}
+		} else if (_is_native_cacheable(receiver.object) && (!receiver.script || !_inline_cache_script_shadows(receiver.script, p_name, GDScriptLanguage::get_singleton()->strings._set))) {
+			const StringName class_name = receiver.object->get_class_name();
+			StringName declaring_class;
+			if (_get_native_property_class(class_name, p_name, false, declaring_class)) {
+				const StringName setter = ClassDB::get_property_setter(declaring_class, p_name);
+				const int index = ClassDB::get_property_index(declaring_class, p_name);
+				// Indexed setters are called through `Object::callp()`, which may find a script function first.
+				MethodBind *method = setter ? ClassDB::get_method(index >= 0 ? class_name : declaring_class, setter) : nullptr;
+				if (method && (index < 0 || !receiver.script || !_inline_cache_script_shadows(receiver.script, setter, StringName()))) {
+					entry->kind = InlineCache::KIND_NATIVE_PROPERTY;
+					entry->method = method;
+					entry->index = index;
+				}
+			}
+		}
+	}
+
+	switch (entry->kind) {
+		case InlineCache::KIND_SCRIPT_MEMBER: {
+			// Values needing a conversion go through `GDScriptInstance::set()`.
+			if (entry->member_data_type->has_type && !entry->member_data_type->is_type(*p_value)) {
+				return false;
+			}
+			receiver.instance->members.write[entry->index] = *p_value;
+			r_valid = true;
+			return true;
+		}
+		case InlineCache::KIND_NATIVE_PROPERTY: {
+			Callable::CallError ce;
+			if (entry->index >= 0) {
+				Variant index = entry->index;
+				const Variant *args[2] = { &index, p_value };
+				entry->method->call(receiver.object, args, 2, ce);
+			} else {
+				entry->method->call(receiver.object, &p_value, 1, ce);
+			}
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+			return true;
+		}
+		case InlineCache::KIND_BUILTIN_MEMBER: {
+			if (p_value->get_type() != entry->member_type) {
+				return false;
+			}
+			entry->setter(p_base, p_value);
+			r_valid = true;
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_call(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	// Built-in types already dispatch through a validated call when typed.
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+
+	InlineCacheReceiver receiver;
+	if (!_inline_cache_get_receiver(p_base, receiver)) {
+		return false;
+	}
+
+	InlineCache::Entry *entry = _inline_cache_find(p_cache, receiver);
+	if (!entry) {
+		entry = &_inline_cache_add(p_cache, receiver);
+		// `free()` and `_ready()` have side effects handled by `Object::callp()` and `GDScriptInstance::callp()`.
+		if (p_name != CoreStringName(free_) && !(receiver.script && p_name == SceneStringName(_ready))) {
+			GDScriptFunction *function = nullptr;
+			for (const GDScript *script = receiver.script; script && !function; script = script->_base) {
+				GDScriptFunction *const *E = script->member_functions.getptr(p_name);
+				if (E) {
+					function = *E;
+				}
+			}
+
+			if (function) {
+				entry->kind = InlineCache::KIND_SCRIPT_FUNCTION;
+				entry->native_class = nullptr;
+				entry->function = function;
+			} else if (_is_native_cacheable(receiver.object)) {
+				MethodBind *method = ClassDB::get_method(receiver.object->get_class_name(), p_name);
+				if (method) {
+					entry->kind = InlineCache::KIND_NATIVE_METHOD;
+					entry->method = method;
+				}
+			}
+		}
+	}
+
+	switch (entry->kind) {
+		case InlineCache::KIND_SCRIPT_FUNCTION: {
+#ifdef DEBUG_ENABLED
+			// Like `Object::callp()`, so freeing the receiver from within the call is reported instead of crashing.
+			_ObjectDebugLock debug_lock(receiver.object);
+#endif
+			r_ret = entry->function->call(receiver.instance, p_args, p_argcount, r_err);
+			return true;
+		}
+		case InlineCache::KIND_NATIVE_METHOD: {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(receiver.object);
+#endif
+			r_err.error = Callable::CallError::CALL_OK;
+			r_ret = entry->method->call(receiver.object, p_args, p_argcount, r_err);
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
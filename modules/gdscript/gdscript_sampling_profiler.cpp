@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript_function.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+String GDScriptSamplingProfiler::startup_output_path;
+uint32_t GDScriptSamplingProfiler::startup_interval_usec = GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC;
+GDScriptSamplingProfiler *GDScriptSamplingProfiler::singleton = nullptr;
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::sample_requested;
+thread_local LocalVector<GDScriptSamplingProfiler::Frame> GDScriptSamplingProfiler::frames;
+
+bool GDScriptSamplingProfiler::_push_frame(const GDScriptFunction *p_function, const int *p_line) {
+	// The VM already enforces its own call depth limit, this only guards against unbalanced pushes.
+	ERR_FAIL_COND_V(frames.size() > uint32_t(GDScriptFunction::MAX_CALL_DEPTH), false);
+	Frame frame;
+	frame.function = p_function;
+	frame.line = p_line;
+	frames.push_back(frame);
+	return true;
+}
+
+void GDScriptSamplingProfiler::pop_frame() {
+	ERR_FAIL_COND(frames.is_empty());
+	frames.resize(frames.size() - 1);
+}
+
+void GDScriptSamplingProfiler::_take_sample() {
+	if (frames.is_empty()) {
+		// Not inside a profiled call (e.g. the profiler started mid-call), leave the request to another thread.
+		return;
+	}
+	if (sample_requested.bit_and(0) == 0) {
+		// Another thread took this sample first.
+		return;
+	}
+
+	String stack;
+	for (uint32_t i = 0; i < frames.size(); i++) {
+		const GDScriptFunction *function = frames[i].function;
+		if (i > 0) {
+			stack += ";";
+		}
+		stack += String(function->get_name()) + " (" + String(function->get_source()) + ":" + itos(*frames[i].line) + ")";
+	}
+
+	GDScriptSamplingProfiler *profiler = singleton;
+	if (profiler) {
+		profiler->_add_sample(stack);
+	}
+}
+
+void GDScriptSamplingProfiler::_thread_func(void *p_user) {
+	GDScriptSamplingProfiler *profiler = static_cast<GDScriptSamplingProfiler *>(p_user);
+	while (!profiler->exit_thread.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->interval_usec);
+		if (sample_requested.bit_or(1) != 0) {
+			// The previous request was never picked up, so no script reached a safe point
+			// during the whole interval: either idle, or busy in engine/native code.
+			profiler->_add_sample("[engine]");
+		}
+	}
+}
+
+void GDScriptSamplingProfiler::_add_sample(const String &p_stack) {
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t>::Iterator E = samples.find(p_stack);
+	if (E) {
+		E->value++;
+	} else {
+		samples.insert(p_stack, 1);
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(active.is_set(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND_MSG(singleton != this, "Only one GDScript sampling profiler can be running at a time.");
+
+	interval_usec = MAX(p_interval_usec, 1u);
+	{
+		MutexLock lock(mutex);
+		samples.clear();
+	}
+	sample_requested.set(0);
+	exit_thread.clear();
+	active.set();
+	thread.start(_thread_func, this);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	exit_thread.set();
+	thread.wait_to_finish();
+	active.clear();
+	sample_requested.set(0);
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	Vector<String> lines;
+	{
+		MutexLock lock(mutex);
+		for (const KeyValue<String, uint64_t> &E : samples) {
+			lines.push_back(E.key + " " + itos(E.value));
+		}
+	}
+	lines.sort();
+
+	String result;
+	for (const String &line : lines) {
+		result += line + "\n";
+	}
+	return result;
+}
+
+Error GDScriptSamplingProfiler::save(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_WRITE, vformat("Cannot write GDScript sampling profile to \"%s\".", p_path));
+	f->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+void GDScriptSamplingProfiler::toggle(bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		uint32_t interval = DEFAULT_INTERVAL_USEC;
+		if (p_opts.size() > 0 && p_opts[0].get_type() == Variant::INT) {
+			interval = MAX(int(p_opts[0]), 1);
+		}
+		stop();
+		start(interval);
+	} else {
+		stop();
+		if (EngineDebugger::is_active()) {
+			Array msg;
+			msg.push_back(get_collapsed_stacks());
+			EngineDebugger::get_singleton()->send_message("gdscript:sampler", msg);
+		}
+	}
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	if (!singleton) {
+		singleton = this;
+	}
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	if (singleton == this) {
+		stop();
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Statistical profiler for GDScript. A timer thread periodically raises a
+// request flag which the VM checks at safe points (function entry, line
+// changes and jumps), so the executing thread records its own call stack
+// and no other thread ever has to inspect it. Samples are aggregated in the
+// collapsed stack format understood by flame graph tools.
+class GDScriptSamplingProfiler : public EngineProfiler {
+public:
+	static constexpr uint32_t DEFAULT_INTERVAL_USEC = 1000;
+
+private:
+	struct Frame {
+		const GDScriptFunction *function = nullptr;
+		const int *line = nullptr;
+	};
+
+	static GDScriptSamplingProfiler *singleton;
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> sample_requested;
+	static thread_local LocalVector<Frame> frames;
+
+	Thread thread;
+	SafeFlag exit_thread;
+	uint32_t interval_usec = DEFAULT_INTERVAL_USEC;
+
+	Mutex mutex;
+	HashMap<String, uint64_t> samples;
+
+	static bool _push_frame(const GDScriptFunction *p_function, const int *p_line);
+	static void _take_sample();
+	static void _thread_func(void *p_user);
+
+	void _add_sample(const String &p_stack);
+
+public:
+	// Set by `--gdscript-sampling-profiler <output>` and `--gdscript-sampling-interval <usec>`
+	// to sample from startup until exit, then write the collapsed stacks to the output path.
+	static String startup_output_path;
+	static uint32_t startup_interval_usec;
+
+	static GDScriptSamplingProfiler *get_singleton() { return singleton; }
+
+	// Called by the VM once the function stack is set up. Returns whether the
+	// frame was recorded, in which case pop_frame() must be called on exit.
+	_FORCE_INLINE_ static bool push_frame(const GDScriptFunction *p_function, const int *p_line) {
+		if (likely(!active.is_set())) {
+			return false;
+		}
+		return _push_frame(p_function, p_line);
+	}
+	static void pop_frame();
+
+	// Safe point check, cheap enough to be done on every line and jump.
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(sample_requested.get() != 0)) {
+			_take_sample();
+		}
+	}
+
+	void start(uint32_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	void stop();
+	bool is_active() const { return active.is_set(); }
+
+	String get_collapsed_stacks();
+	Error save(const String &p_path);
+
+	virtual void toggle(bool p_enable, const Array &p_opts) override;
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
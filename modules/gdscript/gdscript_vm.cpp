@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/os/os.h"
 
@@ -215,6 +216,26 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
+		&&OPCODE_OPERATOR_INT_ADD,                       \
+		&&OPCODE_OPERATOR_INT_SUBTRACT,                  \
+		&&OPCODE_OPERATOR_INT_MULTIPLY,                  \
+		&&OPCODE_OPERATOR_INT_EQUAL,                     \
+		&&OPCODE_OPERATOR_INT_NOT_EQUAL,                 \
+		&&OPCODE_OPERATOR_INT_LESS,                      \
+		&&OPCODE_OPERATOR_INT_LESS_EQUAL,                \
+		&&OPCODE_OPERATOR_INT_GREATER,                   \
+		&&OPCODE_OPERATOR_INT_GREATER_EQUAL,             \
+		&&OPCODE_OPERATOR_FLOAT_ADD,                     \
+		&&OPCODE_OPERATOR_FLOAT_SUBTRACT,                \
+		&&OPCODE_OPERATOR_FLOAT_MULTIPLY,                \
+		&&OPCODE_OPERATOR_FLOAT_DIVIDE,                  \
+		&&OPCODE_OPERATOR_FLOAT_EQUAL,                   \
+		&&OPCODE_OPERATOR_FLOAT_NOT_EQUAL,               \
+		&&OPCODE_OPERATOR_FLOAT_LESS,                    \
+		&&OPCODE_OPERATOR_FLOAT_LESS_EQUAL,              \
+		&&OPCODE_OPERATOR_FLOAT_GREATER,                 \
+		&&OPCODE_OPERATOR_FLOAT_GREATER_EQUAL,           \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_NATIVE,                       \
@@ -231,6 +252,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_NAMED_VALIDATED,                    \
 		&&OPCODE_SET_MEMBER,                             \
 		&&OPCODE_GET_MEMBER,                             \
+		&&OPCODE_UPDATE_MEMBER_VALIDATED,                \
 		&&OPCODE_SET_STATIC_VARIABLE,                    \
 		&&OPCODE_GET_STATIC_VARIABLE,                    \
 		&&OPCODE_ASSIGN,                                 \
@@ -274,6 +296,20 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP_IF_NOT,                            \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_JUMP_IF_NOT_INT_EQUAL,                  \
+		&&OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL,              \
+		&&OPCODE_JUMP_IF_NOT_INT_LESS,                   \
+		&&OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL,             \
+		&&OPCODE_JUMP_IF_NOT_INT_GREATER,                \
+		&&OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL,          \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_EQUAL,                \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL,            \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_LESS,                 \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL,           \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_GREATER,              \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL,        \
 		&&OPCODE_RETURN,                                 \
 		&&OPCODE_RETURN_TYPED_BUILTIN,                   \
 		&&OPCODE_RETURN_TYPED_ARRAY,                     \
@@ -499,11 +535,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -582,7 +618,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	memnew_placement(&stack[ADDR_STACK_CLASS], Variant(script));
 	memnew_placement(&stack[ADDR_STACK_NIL], Variant);
 
+	const bool sampled = GDScriptSamplingProfiler::push_frame(this, &line);
+	GDScriptSamplingProfiler::poll();
+
 	String err_text;
+	bool stack_detached = false; // Frame moved to (or kept in) a GDScriptFunctionState by `await`.
 
 #ifdef DEBUG_ENABLED
 
@@ -779,6 +819,56 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(result, 2);
+				GET_VARIANT_PTR(dst, 4);
+
+				operator_func(a, b, result);
+				*dst = *result;
+
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_OPERATOR_UNBOXED(m_name, m_type, m_result, m_op)                                                              \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                                       \
+		CHECK_SPACE(4);                                                                                                      \
+		GET_VARIANT_PTR(a, 0);                                                                                               \
+		GET_VARIANT_PTR(b, 1);                                                                                               \
+		GET_VARIANT_PTR(dst, 2);                                                                                             \
+		*VariantInternal::get_##m_result(dst) = (*VariantInternal::get_##m_type(a)) m_op(*VariantInternal::get_##m_type(b)); \
+		ip += 4;                                                                                                             \
+	}                                                                                                                        \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_UNBOXED(INT_ADD, int, int, +);
+			OPCODE_OPERATOR_UNBOXED(INT_SUBTRACT, int, int, -);
+			OPCODE_OPERATOR_UNBOXED(INT_MULTIPLY, int, int, *);
+			OPCODE_OPERATOR_UNBOXED(INT_EQUAL, int, bool, ==);
+			OPCODE_OPERATOR_UNBOXED(INT_NOT_EQUAL, int, bool, !=);
+			OPCODE_OPERATOR_UNBOXED(INT_LESS, int, bool, <);
+			OPCODE_OPERATOR_UNBOXED(INT_LESS_EQUAL, int, bool, <=);
+			OPCODE_OPERATOR_UNBOXED(INT_GREATER, int, bool, >);
+			OPCODE_OPERATOR_UNBOXED(INT_GREATER_EQUAL, int, bool, >=);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_ADD, float, float, +);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_SUBTRACT, float, float, -);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_MULTIPLY, float, float, *);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_DIVIDE, float, float, /);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_EQUAL, float, bool, ==);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_NOT_EQUAL, float, bool, !=);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_LESS, float, bool, <);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_LESS_EQUAL, float, bool, <=);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_GREATER, float, bool, >);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_GREATER_EQUAL, float, bool, >=);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1093,7 +1183,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1103,8 +1193,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_cache_set_named(_inline_caches_ptr[cache_index], dst, *index, value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1125,7 +1220,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1145,7 +1240,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1155,13 +1250,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+				InlineCache &cache = _inline_caches_ptr[cache_index];
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret;
+				valid = _inline_cache_get_named(cache, src, *index, &ret);
+				if (!valid) {
+					ret = src->get_named(*index, valid);
+				}
 
 #else
-				*dst = src->get_named(*index, valid);
+				if (!_inline_cache_get_named(cache, src, *index, dst)) {
+					*dst = src->get_named(*index, valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1170,7 +1275,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1232,6 +1337,44 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_UPDATE_MEMBER_VALIDATED) {
+				CHECK_SPACE(7);
+				GET_VARIANT_PTR(value, 0);
+				int indexname = _code_ptr[ip + 2];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(result, 4);
+				int operator_idx = _code_ptr[ip + 6];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				bool valid;
+#ifndef DEBUG_ENABLED
+				ClassDB::get_property(p_instance->owner, *index, *value);
+				operator_func(a, b, result);
+				ClassDB::set_property(p_instance->owner, *index, *result, &valid);
+#else
+				bool ok = ClassDB::get_property(p_instance->owner, *index, *value);
+				if (!ok) {
+					err_text = "Internal error getting property: " + String(*index);
+					OPCODE_BREAK;
+				}
+				operator_func(a, b, result);
+				ok = ClassDB::set_property(p_instance->owner, *index, *result, &valid);
+				if (!ok) {
+					err_text = "Internal error setting property: " + String(*index);
+					OPCODE_BREAK;
+				} else if (!valid) {
+					err_text = "Error setting property '" + String(*index) + "' with value of type " + Variant::get_type_name(result->get_type()) + ".";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 7;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_STATIC_VARIABLE) {
 				CHECK_SPACE(4);
 
@@ -1706,7 +1849,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1717,6 +1860,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+				InlineCache &cache = _inline_caches_ptr[cache_index];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1734,7 +1881,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!_inline_cache_call(cache, base, *methodname, (const Variant **)argptrs, argc, *ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1764,7 +1913,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!_inline_cache_call(cache, base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1814,7 +1965,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2375,45 +2526,58 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 
 				if (is_signal) {
-					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
-					gdfs->function = this;
-
-					gdfs->state.stack.resize(alloca_size);
-
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					Ref<GDScriptFunctionState> gdfs;
+					if (p_state) {
+						// Awaiting again after being resumed: re-arm the same state, the frame already lives in its stack.
+						gdfs = Ref<GDScriptFunctionState>(p_state->function_state);
+					} else {
+						gdfs.instantiate();
+						gdfs->function = this;
+
+						// Relocate the frame into a pooled buffer. Variants are moved bitwise, so the
+						// originals are not freed on exit. First 3 stack addresses are special, so we just skip them here.
+						gdfs->state.stack = GDScriptFunctionState::_alloc_stack(alloca_size);
+						memcpy(&gdfs->state.stack[sizeof(Variant) * FIXED_ADDRESSES_MAX], (void *)&stack[FIXED_ADDRESSES_MAX], sizeof(Variant) * (_stack_size - FIXED_ADDRESSES_MAX));
+						gdfs->state.stack_size = _stack_size;
+						gdfs->state.alloca_size = alloca_size;
+						gdfs->state.script = _script;
+						gdfs->state.instance = p_instance;
+#ifdef DEBUG_ENABLED
+						gdfs->state.function_name = name;
+						gdfs->state.script_path = _script->get_script_path();
+#endif
+						gdfs->state.defarg = defarg;
 					}
-					gdfs->state.stack_size = _stack_size;
-					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
-					gdfs->state.script = _script;
+
 					{
 						MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 						_script->pending_func_states.add(&gdfs->scripts_list);
 						if (p_instance) {
-							gdfs->state.instance = p_instance;
 							p_instance->pending_func_states.add(&gdfs->instances_list);
-						} else {
-							gdfs->state.instance = nullptr;
 						}
 					}
-#ifdef DEBUG_ENABLED
-					gdfs->state.function_name = name;
-					gdfs->state.script_path = _script->get_script_path();
-#endif
-					gdfs->state.defarg = defarg;
-					gdfs->function = this;
-
-					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = gdfs->_connect_await(sig);
 					if (err != OK) {
+						// The frame is still owned by this call and freed on exit.
+						{
+							MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+							gdfs->scripts_list.remove_from_list();
+							gdfs->instances_list.remove_from_list();
+						}
+						gdfs->function = nullptr;
+						if (!p_state) {
+							gdfs->state.stack_size = 0;
+						}
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
 					}
 
+					stack_detached = true;
+					retvalue = gdfs;
+
 #ifdef DEBUG_ENABLED
 					exit_ok = true;
 					awaited = true;
@@ -2508,6 +2672,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GD_ERR_BREAK(to < 0 || to > _code_size);
 				ip = to;
+
+				// Loop back edges are the safe point of release builds, which have no line opcodes.
+				GDScriptSamplingProfiler::poll();
 			}
 			DISPATCH_OPCODE;
 
@@ -2516,7 +2683,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_VARIANT_PTR(test, 0);
 
-				bool result = test->booleanize();
+				// Conditions are bool most of the time, skip the generic conversion for them.
+				bool result = test->get_type() == Variant::BOOL ? *VariantInternal::get_bool(test) : test->booleanize();
 
 				if (result) {
 					int to = _code_ptr[ip + 2];
@@ -2533,7 +2701,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_VARIANT_PTR(test, 0);
 
-				bool result = test->booleanize();
+				bool result = test->get_type() == Variant::BOOL ? *VariantInternal::get_bool(test) : test->booleanize();
 
 				if (!result) {
 					int to = _code_ptr[ip + 2];
@@ -2566,6 +2734,87 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(test, 2);
+
+				operator_func(a, b, test);
+
+				bool result = test->get_type() == Variant::BOOL ? *VariantInternal::get_bool(test) : test->booleanize();
+
+				if (result) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(test, 2);
+
+				operator_func(a, b, test);
+
+				bool result = test->get_type() == Variant::BOOL ? *VariantInternal::get_bool(test) : test->booleanize();
+
+				if (!result) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_JUMP_IF_NOT_UNBOXED(m_name, m_type, m_op)                                           \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_name) {                                                          \
+		CHECK_SPACE(5);                                                                            \
+		GET_VARIANT_PTR(a, 0);                                                                     \
+		GET_VARIANT_PTR(b, 1);                                                                     \
+		GET_VARIANT_PTR(test, 2);                                                                  \
+		bool result = (*VariantInternal::get_##m_type(a)) m_op(*VariantInternal::get_##m_type(b)); \
+		*VariantInternal::get_bool(test) = result;                                                 \
+		if (!result) {                                                                             \
+			int to = _code_ptr[ip + 4];                                                            \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                                               \
+			ip = to;                                                                               \
+		} else {                                                                                   \
+			ip += 5;                                                                               \
+		}                                                                                          \
+	}                                                                                              \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_EQUAL, int, ==);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_NOT_EQUAL, int, !=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_LESS, int, <);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_LESS_EQUAL, int, <=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_GREATER, int, >);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_GREATER_EQUAL, int, >=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_EQUAL, float, ==);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_NOT_EQUAL, float, !=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS, float, <);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS_EQUAL, float, <=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER, float, >);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER_EQUAL, float, >=);
+
 			OPCODE(OPCODE_RETURN) {
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(r, 0);
@@ -3578,6 +3827,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptSamplingProfiler::poll();
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3681,8 +3932,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		if (!stack_detached) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
+			if (p_state) {
+				p_state->stack_size = 0;
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
@@ -3693,6 +3949,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		stack[i].~Variant();
 	}
 
+	if (sampled) {
+		GDScriptSamplingProfiler::pop_frame();
+	}
+
 	call_depth--;
 
 	return retvalue;
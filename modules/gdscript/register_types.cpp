@@ -32,7 +32,9 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
@@ -74,6 +76,7 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+Ref<GDScriptSamplingProfiler> gdscript_sampling_profiler;
 
 #ifdef TOOLS_ENABLED
 
@@ -84,10 +87,12 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
+	bool export_debug = true;
 
 protected:
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		export_debug = p_debug;
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
@@ -107,13 +112,25 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS ? GDScriptTokenizerBuffer::COMPRESS_NONE : GDScriptTokenizerBuffer::COMPRESS_ZSTD;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
 			return;
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED_BYTECODE) {
+			// The tokens stay exported, they are compiled instead if the bytecode can't be used.
+			Ref<GDScript> script = ResourceLoader::load(p_path);
+			if (script.is_null() || !script->is_valid() || script->get_source_code() != source) {
+				return;
+			}
+			Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(script.ptr(), file, export_debug);
+			if (!bytecode.is_empty()) {
+				add_file(GDScriptBytecodeCache::get_cache_path(p_path), bytecode, false);
+			}
+		}
 	}
 
 public:
@@ -157,6 +174,12 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+		gdscript_sampling_profiler.instantiate();
+		gdscript_sampling_profiler->bind("gdscript:sampler");
+		if (!GDScriptSamplingProfiler::startup_output_path.is_empty()) {
+			gdscript_sampling_profiler->start(GDScriptSamplingProfiler::startup_interval_usec);
+		}
 	}
 
 #ifdef TOOLS_ENABLED
@@ -171,6 +194,15 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+		if (gdscript_sampling_profiler.is_valid()) {
+			gdscript_sampling_profiler->stop();
+			if (!GDScriptSamplingProfiler::startup_output_path.is_empty()) {
+				gdscript_sampling_profiler->save(GDScriptSamplingProfiler::startup_output_path);
+			}
+			gdscript_sampling_profiler->unbind();
+			gdscript_sampling_profiler.unref();
+		}
+
 		ScriptServer::unregister_language(script_language_gd);
 
 		if (gdscript_cache) {
@@ -33,6 +33,8 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_byte_optimizer.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -70,6 +72,47 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE_BENCHMARK("[Modules][GDScript] Bytecode optimizer benchmark") {
+	const String source = R"(
+extends RefCounted
+
+var total: int = 0
+
+func run() -> int:
+	var sum := 0
+	var i := 0
+	while i < 200000:
+		if i % 3 == 0 or i % 5 == 0:
+			sum += i
+		i += 1
+	for j in 10000:
+		total += j
+	return sum + total
+)";
+
+	int64_t results[2] = {};
+	uint64_t times[2] = {};
+	for (int optimized = 0; optimized < 2; optimized++) {
+		GDScriptByteCodeOptimizer::set_enabled(optimized);
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		results[optimized] = ref_counted->call("run");
+		times[optimized] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+	GDScriptByteCodeOptimizer::set_enabled(true);
+
+	CHECK_MESSAGE(results[0] == results[1], "Optimized bytecode should compute the same result.");
+	MESSAGE("Unoptimized bytecode: ", times[0], " usec, optimized bytecode: ", times[1], " usec.");
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
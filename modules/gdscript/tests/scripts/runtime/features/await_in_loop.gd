@@ -0,0 +1,24 @@
+signal tick(value)
+
+var events := []
+
+func counter(times: int) -> int:
+	var total := 0
+	var label := "sum"
+	for _i in times:
+		var value = await tick
+		total += value
+		events.append("%s %d" % [label, total])
+	return total
+
+func wait_for_counter() -> void:
+	var result = await counter(3)
+	print("completed ", result)
+
+func test():
+	wait_for_counter()
+	for i in 3:
+		tick.emit(i + 1)
+	print(events)
+	tick.emit(10) # Nothing is awaiting anymore.
+	print(events.size())
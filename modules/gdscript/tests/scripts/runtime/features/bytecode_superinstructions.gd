@@ -0,0 +1,49 @@
+extends Node
+
+# Sequences fused or folded by the bytecode optimizer must behave as before.
+
+var counter: int = 0
+
+func count_down(from: int) -> int:
+	var steps := 0
+	while from > 0:
+		from -= 1
+		steps += 1
+	return steps
+
+func first_over(limit: float) -> float:
+	var value := 1.0
+	while true:
+		value *= 2.0
+		if value > limit:
+			break
+	return value
+
+func with_default(value: int, offset: int = 10) -> int:
+	return value + offset
+
+func test():
+	print(count_down(5))
+	print(first_over(100.0))
+	print(with_default(1))
+	print(with_default(1, 2))
+
+	var a := 3
+	var b := 4
+	var sum := a + b
+	print(sum)
+	if a < b and sum == 7:
+		print("and")
+	if a > b or sum != 7:
+		print("unreachable")
+	else:
+		print("or")
+
+	process_priority = 1
+	for i in 4:
+		process_priority += i
+	print(process_priority)
+
+	for i in range(3):
+		counter += i * 2
+	print(counter)
@@ -0,0 +1,38 @@
+# Typed `int` and `float` operations use opcodes working on the raw values.
+
+func sum_to(count: int) -> int:
+	var total := 0
+	var i := 0
+	while i < count:
+		total += i
+		i += 1
+	return total
+
+func halve(value: float, times: int) -> float:
+	for _i in times:
+		value /= 2.0
+	return value
+
+func test():
+	var a := 7
+	var b := -3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x := 1.5
+	var y := 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x == y, " ", x != y, " ", x < y, " ", x <= y, " ", x > y, " ", x >= y)
+	print(x / 0.0)
+
+	print(sum_to(10))
+	print(halve(8.0, 3))
+
+	var n := 5
+	n -= 2
+	n *= 4
+	print(n)
+
+	# Mixed types still go through the generic path.
+	var mixed := a * 0.5
+	print(mixed)
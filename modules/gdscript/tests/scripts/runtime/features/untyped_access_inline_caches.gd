@@ -0,0 +1,83 @@
+# Untyped property accesses and calls must resolve correctly at every call site,
+# whichever receivers they see and in whichever order.
+
+class A:
+	var value = 1
+	var typed: float = 0.5
+	func describe():
+		return "A %s" % value
+
+class B:
+	var other = 0
+	var value = 2
+	func describe():
+		return "B %s" % value
+
+class C extends A:
+	var value_with_setter = 0:
+		set(v):
+			value_with_setter = v * 10
+	func describe():
+		return "C %s" % super()
+
+class ShadowedIndexedSetter extends StyleBoxFlat:
+	var last_corner = -1
+	@warning_ignore("native_method_override")
+	func set_corner_radius(corner, radius):
+		last_corner = corner
+		super(corner, radius * 2)
+
+func read_value(obj):
+	return obj.value
+
+func write_value(obj, v):
+	obj.value = v
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), A.new()]
+	for _i in 2:
+		for obj in receivers:
+			print(read_value(obj), " ", obj.describe())
+
+	for obj in receivers:
+		write_value(obj, 5)
+	for obj in receivers:
+		print(read_value(obj))
+
+	# Typed members still convert values through the generic path.
+	var a = receivers[0]
+	for v in [1, 2.5, true]:
+		a.typed = v
+		print(a.typed)
+
+	var c = receivers[2]
+	for v in 3:
+		c.value_with_setter = v
+		print(c.value_with_setter)
+
+	# Native properties and methods.
+	var resources = [Resource.new(), Resource.new()]
+	for r in resources:
+		r.resource_name = "res"
+	for r in resources:
+		print(r.resource_name, " ", r.get_class())
+
+	# Indexed native setters are called through `Object::callp()`, so script functions shadowing them win.
+	var boxes = [ShadowedIndexedSetter.new(), ShadowedIndexedSetter.new()]
+	for box in boxes:
+		box.corner_radius_top_right = 3
+	for box in boxes:
+		print(box.corner_radius_top_right, " ", box.last_corner)
+
+	# Built-in members.
+	var vectors = [Vector2(1, 2), Vector3(3, 4, 5), Vector2(6, 7)]
+	for v in vectors:
+		var copy = v
+		copy.x = 10.0
+		print(v.x, " ", copy.x, " ", copy.y)
+
+	# Dictionaries keep going through the generic path.
+	var dict = { "value": 3 }
+	print(read_value(dict))
+	write_value(dict, 4)
+	print(dict.value)
@@ -0,0 +1,260 @@
+/**************************************************************************/
+/*  test_bytecode_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BYTECODE_CACHE_H
+#define TEST_BYTECODE_CACHE_H
+
+#ifdef TOOLS_ENABLED
+
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_compiler.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptBytecodeCache {
+
+// Exported scripts get the binary tokens of `tokens_source` and the compiled bytecode of `bytecode_source`.
+// Both have the same interface, so which one runs tells whether the bytecode was used or the tokens were compiled instead.
+const String tokens_source = R"(
+extends RefCounted
+
+func run():
+	return "tokens"
+)";
+
+const String bytecode_source = R"(
+extends RefCounted
+
+class Inner:
+	var value := 40
+
+	func add(p_amount: int) -> int:
+		return value + p_amount
+
+var calls := 0
+
+func count() -> bool:
+	calls += 1
+	return true
+
+func run():
+	var inner := Inner.new()
+	var values := [inner.add(2)]
+	values.append_array([1, 2, 3].map(func(v): return v * 2))
+	return "bytecode %s" % [values]
+
+func run_assert() -> int:
+	calls = 0
+	assert(count())
+	return calls
+)";
+
+inline Vector<uint8_t> get_tokens() {
+	return GDScriptTokenizerBuffer::parse_code_string(tokens_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+}
+
+inline String get_script_path(const String &p_name) {
+	return OS::get_singleton()->get_cache_path().path_join(p_name + ".gd");
+}
+
+inline void write_file(const String &p_path, const Vector<uint8_t> &p_data) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_buffer(p_data);
+}
+
+inline Variant call_script(const Ref<GDScript> &p_script, const StringName &p_method) {
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(p_script);
+	return ref_counted->call(p_method);
+}
+
+// Compiles `bytecode_source` from `<p_name>.gd`, like the editor does before exporting.
+inline Ref<GDScript> load_source(const String &p_name) {
+	const String path = get_script_path(p_name);
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(bytecode_source);
+	file.unref();
+
+	Error error = OK;
+	Ref<GDScript> script = GDScriptCache::get_full_script(path, error);
+	REQUIRE(error == OK);
+	REQUIRE(script->is_valid());
+	return script;
+}
+
+// Loads `<p_name>.gd` the way exported projects do: through a remap to its binary tokens, with `p_bytecode` stored next to them.
+inline Ref<GDScript> load_exported(const String &p_name, const Vector<uint8_t> &p_bytecode) {
+	const String path = get_script_path(p_name);
+	const String tokens_path = path.get_basename() + ".gdc";
+	GDScriptCache::remove_script(path);
+	write_file(tokens_path, get_tokens());
+	write_file(GDScriptBytecodeCache::get_cache_path(tokens_path), p_bytecode);
+
+	Ref<FileAccess> file = FileAccess::open(path + ".remap", FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(vformat("[remap]\n\npath=\"%s\"\n", tokens_path));
+	file.unref();
+
+	Error error = OK;
+	Ref<GDScript> script = GDScriptCache::get_full_script(path, error);
+	CHECK(error == OK);
+
+	GDScriptCache::remove_script(path);
+	DirAccess::remove_absolute(path + ".remap");
+	DirAccess::remove_absolute(tokens_path);
+	DirAccess::remove_absolute(GDScriptBytecodeCache::get_cache_path(tokens_path));
+	DirAccess::remove_absolute(path);
+	return script;
+}
+
+TEST_CASE("[Modules][GDScript] Compiled bytecode round trip") {
+	SUBCASE("Serialize, load and call") {
+		Ref<GDScript> script = load_source("bytecode_cache_round_trip");
+		const Variant expected = call_script(script, "run");
+		CHECK(expected == Variant("bytecode [42, 2, 4, 6]"));
+		const Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), true);
+		REQUIRE_FALSE(bytecode.is_empty());
+		script.unref();
+
+		Ref<GDScript> loaded = load_exported("bytecode_cache_round_trip", bytecode);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->is_valid());
+		CHECK_MESSAGE(call_script(loaded, "run") == expected, "The stored bytecode should run instead of the compiled tokens.");
+		CHECK(int(call_script(loaded, "run_assert")) == 1);
+	}
+
+	SUBCASE("Operator caches filled at runtime are not stored") {
+		// Untyped operators store the operand types and an evaluator pointer in their code the first time they run.
+		Ref<GDScript> script = load_source("bytecode_cache_operator_caches");
+		const Vector<uint8_t> before_run = GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), true);
+		REQUIRE_FALSE(before_run.is_empty());
+		const Variant expected = call_script(script, "run");
+		const Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), true);
+		CHECK_MESSAGE(bytecode == before_run, "Running the script in the editor should not change its exported bytecode.");
+		script.unref();
+
+		Ref<GDScript> loaded = load_exported("bytecode_cache_operator_caches", bytecode);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->is_valid());
+		CHECK(call_script(loaded, "run") == expected);
+	}
+
+	SUBCASE("Bytecode for another kind of build is ignored") {
+		// This build has DEBUG_ENABLED, so bytecode meant for release export templates doesn't match it.
+		Ref<GDScript> script = load_source("bytecode_cache_signature_mismatch");
+		const Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), false);
+		REQUIRE_FALSE(bytecode.is_empty());
+		script.unref();
+
+		Ref<GDScript> loaded = load_exported("bytecode_cache_signature_mismatch", bytecode);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->is_valid());
+		CHECK_MESSAGE(call_script(loaded, "run") == Variant("tokens"), "The tokens should be compiled instead.");
+	}
+
+	SUBCASE("Truncated files are ignored") {
+		Ref<GDScript> script = load_source("bytecode_cache_truncated_file");
+		Vector<uint8_t> bytecode = GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), true);
+		REQUIRE(bytecode.size() > 24);
+		script.unref();
+
+		bytecode.resize(bytecode.size() - 8);
+		ERR_PRINT_OFF;
+		Ref<GDScript> loaded = load_exported("bytecode_cache_truncated_file", bytecode);
+		ERR_PRINT_ON;
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->is_valid());
+		CHECK_MESSAGE(call_script(loaded, "run") == Variant("tokens"), "The tokens should be compiled instead.");
+
+		bytecode.resize(16);
+		loaded = load_exported("bytecode_cache_truncated_file", bytecode);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(loaded->is_valid());
+		CHECK(call_script(loaded, "run") == Variant("tokens"));
+	}
+
+	SUBCASE("Truncated contents are rejected") {
+		Ref<GDScript> script = load_source("bytecode_cache_truncated_contents");
+		const String tokens_path = script->get_path().get_basename() + ".gdc";
+		write_file(GDScriptBytecodeCache::get_cache_path(tokens_path), GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), true));
+		GDScriptCache::remove_script(script->get_path());
+		DirAccess::remove_absolute(script->get_path());
+		script.unref();
+
+		Vector<uint8_t> contents = GDScriptBytecodeCache::load(tokens_path, get_tokens());
+		DirAccess::remove_absolute(GDScriptBytecodeCache::get_cache_path(tokens_path));
+		REQUIRE_FALSE(contents.is_empty());
+
+		contents.resize(contents.size() / 2);
+		Ref<GDScript> loaded;
+		loaded.instantiate();
+		CHECK(GDScriptBytecodeCache::deserialize(loaded.ptr(), contents) == ERR_INVALID_DATA);
+		CHECK_FALSE(loaded->is_valid());
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Compiled bytecode for release export templates") {
+	Ref<GDScript> script = load_source("bytecode_cache_release");
+	CHECK(int(call_script(script, "run_assert")) == 1);
+
+	SUBCASE("Release code generation leaves out asserts") {
+		GDScriptCompiler::set_debug_codegen(false);
+		CHECK(script->reload(true) == OK);
+		GDScriptCompiler::set_debug_codegen(true);
+		CHECK_MESSAGE(int(call_script(script, "run_assert")) == 0, "Assert conditions should not be evaluated.");
+
+		CHECK(script->reload(true) == OK);
+		CHECK(int(call_script(script, "run_assert")) == 1);
+	}
+
+	SUBCASE("Serializing for release restores the editor's bytecode") {
+		CHECK_FALSE(GDScriptBytecodeCache::serialize(script.ptr(), get_tokens(), false).is_empty());
+		CHECK(GDScriptCompiler::is_debug_codegen());
+		REQUIRE(script->is_valid());
+		CHECK(int(call_script(script, "run_assert")) == 1);
+	}
+
+	GDScriptCache::remove_script(script->get_path());
+	DirAccess::remove_absolute(script->get_path());
+}
+
+} // namespace TestGDScriptBytecodeCache
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_BYTECODE_CACHE_H
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  test_sampling_profiler.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SAMPLING_PROFILER_H
+#define TEST_SAMPLING_PROFILER_H
+
+#include "../gdscript.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptSamplingProfiler {
+
+// Keeps the VM busy in `spin()`, called from `run()`, for the given time.
+const String busy_source = R"(
+extends RefCounted
+
+func spin(p_usec: int) -> int:
+	var count := 0
+	var end := Time.get_ticks_usec() + p_usec
+	while Time.get_ticks_usec() < end:
+		count += 1
+	return count
+
+func run(p_usec: int) -> int:
+	return spin(p_usec)
+)";
+
+TEST_CASE("[Modules][GDScript] Sampling profiler collapsed stacks") {
+	GDScriptSamplingProfiler *profiler = GDScriptSamplingProfiler::get_singleton();
+	REQUIRE(profiler);
+	REQUIRE_FALSE(profiler->is_active());
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(busy_source);
+	ERR_PRINT_OFF;
+	const Error error = script->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(script);
+
+	profiler->start(100);
+	CHECK(profiler->is_active());
+	CHECK(int64_t(ref_counted->call("run", 50000)) > 0);
+	profiler->stop();
+	CHECK_FALSE(profiler->is_active());
+
+	const String stacks = profiler->get_collapsed_stacks();
+	const PackedStringArray lines = stacks.split("\n", false);
+	REQUIRE_FALSE(lines.is_empty());
+	CHECK(stacks.ends_with("\n"));
+
+	uint64_t script_samples = 0;
+	for (int i = 0; i < lines.size(); i++) {
+		// Each line is a `;` separated stack, outermost call first, followed by its sample count.
+		const int separator = lines[i].rfind(" ");
+		REQUIRE(separator > 0);
+		const String count = lines[i].substr(separator + 1);
+		CHECK(count.is_valid_int());
+		CHECK(count.to_int() > 0);
+		if (i > 0) {
+			CHECK_MESSAGE(lines[i - 1] < lines[i], "Stacks should be sorted, and listed once.");
+		}
+		const String stack = lines[i].substr(0, separator);
+		if (stack.begins_with("run (")) {
+			CHECK(stack.get_slice_count(";") == 2);
+			CHECK(stack.get_slice(";", 1).begins_with("spin ("));
+			script_samples += count.to_int();
+		} else {
+			CHECK_MESSAGE(stack == "[engine]", "Only the script calls and the time spent outside of them should be sampled.");
+		}
+	}
+	CHECK_MESSAGE(script_samples > 0, "The script should be sampled while it runs.");
+
+	SUBCASE("Saving writes the collapsed stacks") {
+		const String path = OS::get_singleton()->get_cache_path().path_join("gdscript_sampling_profile.txt");
+		CHECK(profiler->save(path) == OK);
+		CHECK(FileAccess::get_file_as_string(path) == stacks);
+		DirAccess::remove_absolute(path);
+	}
+
+	SUBCASE("Restarting clears the previous samples") {
+		profiler->start(100000);
+		profiler->stop();
+		CHECK(profiler->get_collapsed_stacks().is_empty());
+	}
+}
+
+} // namespace TestGDScriptSamplingProfiler
+
+#endif // TEST_SAMPLING_PROFILER_H
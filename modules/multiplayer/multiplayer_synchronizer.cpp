@@ -31,8 +31,13 @@
 #include "multiplayer_synchronizer.h"
 
 #include "core/config/engine.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/multiplayer_api.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif
+
 Object *MultiplayerSynchronizer::_get_prop_target(Object *p_obj, const NodePath &p_path) {
 	if (p_path.get_name_count() == 0) {
 		return p_obj;
@@ -110,6 +115,7 @@ void MultiplayerSynchronizer::reset() {
 	last_watch_usec = 0;
 	sync_started = false;
 	watchers.clear();
+	interest_peers.clear();
 }
 
 uint32_t MultiplayerSynchronizer::get_net_id() const {
@@ -150,6 +156,17 @@ PackedStringArray MultiplayerSynchronizer::get_configuration_warnings() const {
 		warnings.push_back(RTR("A valid NodePath must be set in the \"Root Path\" property in order for MultiplayerSynchronizer to be able to synchronize properties."));
 	}
 
+	if (interest_enabled && has_node(root_path)) {
+		const Node *node = get_node(root_path);
+		bool is_spatial = Object::cast_to<Node2D>(node) != nullptr;
+#ifndef _3D_DISABLED
+		is_spatial = is_spatial || Object::cast_to<Node3D>(node) != nullptr;
+#endif
+		if (!is_spatial) {
+			warnings.push_back(RTR("Interest management requires the root node to be a Node2D or Node3D. This synchronizer will not be visible to any peer."));
+		}
+	}
+
 	return warnings;
 }
 
@@ -191,6 +208,9 @@ void MultiplayerSynchronizer::set_visibility_public(bool p_visible) {
 }
 
 bool MultiplayerSynchronizer::is_visible_to(int p_peer) {
+	if (interest_enabled && !interest_peers.has(p_peer)) {
+		return false;
+	}
 	if (visibility_filters.size()) {
 		Variant arg = p_peer;
 		const Variant *argv[1] = { &arg };
@@ -242,6 +262,57 @@ MultiplayerSynchronizer::VisibilityUpdateMode MultiplayerSynchronizer::get_visib
 	return visibility_update_mode;
 }
 
+void MultiplayerSynchronizer::set_interest_enabled(bool p_enabled) {
+	if (interest_enabled == p_enabled) {
+		return;
+	}
+	interest_enabled = p_enabled;
+	// Not clearing interest_peers, the replication interface keeps them matching its own state. Once disabled,
+	// its next update drops the synchronizer from both, unless interest is enabled again in the meantime.
+	update_configuration_warnings();
+	update_visibility(0);
+}
+
+bool MultiplayerSynchronizer::is_interest_enabled() const {
+	return interest_enabled;
+}
+
+void MultiplayerSynchronizer::set_interest_radius(real_t p_radius) {
+	ERR_FAIL_COND_MSG(p_radius < 0, "Interest radius must be greater or equal to 0.");
+	interest_radius = p_radius;
+}
+
+real_t MultiplayerSynchronizer::get_interest_radius() const {
+	return interest_radius;
+}
+
+bool MultiplayerSynchronizer::get_interest_position(Vector3 &r_position) {
+	Node *node = get_root_node();
+	if (!node || !node->is_inside_tree()) {
+		return false;
+	}
+#ifndef _3D_DISABLED
+	if (Node3D *node_3d = Object::cast_to<Node3D>(node)) {
+		r_position = node_3d->get_global_position();
+		return true;
+	}
+#endif
+	if (Node2D *node_2d = Object::cast_to<Node2D>(node)) {
+		const Vector2 pos = node_2d->get_global_position();
+		r_position = Vector3(pos.x, pos.y, 0);
+		return true;
+	}
+	return false;
+}
+
+void MultiplayerSynchronizer::set_interest_relevant(int p_peer, bool p_relevant) {
+	if (p_relevant) {
+		interest_peers.insert(p_peer);
+	} else {
+		interest_peers.erase(p_peer);
+	}
+}
+
 void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &MultiplayerSynchronizer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &MultiplayerSynchronizer::get_root_path);
@@ -267,12 +338,19 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_visibility_for", "peer", "visible"), &MultiplayerSynchronizer::set_visibility_for);
 	ClassDB::bind_method(D_METHOD("get_visibility_for", "peer"), &MultiplayerSynchronizer::get_visibility_for);
 
+	ClassDB::bind_method(D_METHOD("set_interest_enabled", "enabled"), &MultiplayerSynchronizer::set_interest_enabled);
+	ClassDB::bind_method(D_METHOD("is_interest_enabled"), &MultiplayerSynchronizer::is_interest_enabled);
+	ClassDB::bind_method(D_METHOD("set_interest_radius", "radius"), &MultiplayerSynchronizer::set_interest_radius);
+	ClassDB::bind_method(D_METHOD("get_interest_radius"), &MultiplayerSynchronizer::get_interest_radius);
+
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_replication_interval", "get_replication_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_delta_interval", "get_delta_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, "SceneReplicationConfig", PROPERTY_USAGE_NO_EDITOR), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "interest_enabled"), "set_interest_enabled", "is_interest_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_radius", PROPERTY_HINT_RANGE, "0,1000,0.01,or_greater,suffix:m"), "set_interest_radius", "get_interest_radius");
 
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_PHYSICS);
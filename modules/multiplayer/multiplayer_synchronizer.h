@@ -59,6 +59,9 @@ private:
 	VisibilityUpdateMode visibility_update_mode = VISIBILITY_PROCESS_IDLE;
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
+	bool interest_enabled = false;
+	real_t interest_radius = 0;
+	HashSet<int> interest_peers; // Peers this synchronizer is currently relevant to, set by the replication interface.
 	Vector<Watcher> watchers;
 	uint64_t last_watch_usec = 0;
 
@@ -117,6 +120,13 @@ public:
 	void remove_visibility_filter(Callable p_callback);
 	VisibilityUpdateMode get_visibility_update_mode() const;
 
+	void set_interest_enabled(bool p_enabled);
+	bool is_interest_enabled() const;
+	void set_interest_radius(real_t p_radius);
+	real_t get_interest_radius() const;
+	bool get_interest_position(Vector3 &r_position);
+	void set_interest_relevant(int p_peer, bool p_relevant);
+
 	List<Variant> get_delta_state(uint64_t p_cur_usec, uint64_t p_last_usec, uint64_t &r_indexes);
 	List<NodePath> get_delta_properties(uint64_t p_indexes);
 	SceneReplicationConfig *get_replication_config_ptr() const;
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  scene_interest_grid.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_interest_grid.h"
+
+void SceneInterestGrid::_cell_remove(const Vector3i &p_cell, const ObjectID &p_id) {
+	LocalVector<ObjectID> *cell = cells.getptr(p_cell);
+	ERR_FAIL_NULL(cell); // Bug.
+	int64_t idx = cell->find(p_id);
+	ERR_FAIL_COND(idx < 0); // Bug.
+	cell->remove_at_unordered(idx);
+	if (cell->is_empty()) {
+		cells.erase(p_cell);
+	}
+}
+
+void SceneInterestGrid::set_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Interest cell size must be greater than 0.");
+	if (cell_size == p_size) {
+		return;
+	}
+	cell_size = p_size;
+	cells.clear();
+	for (KeyValue<ObjectID, Entry> &E : entries) {
+		E.value.cell = _get_cell(E.value.position);
+		cells[E.value.cell].push_back(E.key);
+	}
+}
+
+void SceneInterestGrid::update(const ObjectID &p_id, const Vector3 &p_position, real_t p_radius) {
+	const Vector3i cell = _get_cell(p_position);
+	Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		entry = &entries.insert(p_id, Entry())->value;
+		cells[cell].push_back(p_id);
+	} else if (entry->cell != cell) {
+		_cell_remove(entry->cell, p_id);
+		cells[cell].push_back(p_id);
+	}
+	entry->position = p_position;
+	entry->radius = MAX(p_radius, 0);
+	entry->cell = cell;
+	max_radius = MAX(max_radius, entry->radius);
+}
+
+void SceneInterestGrid::remove(const ObjectID &p_id) {
+	const Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		return;
+	}
+	_cell_remove(entry->cell, p_id);
+	entries.erase(p_id);
+	if (entries.is_empty()) {
+		max_radius = 0;
+	}
+}
+
+void SceneInterestGrid::clear() {
+	entries.clear();
+	cells.clear();
+	max_radius = 0;
+}
+
+void SceneInterestGrid::query(const Vector3 &p_position, real_t p_radius, HashSet<ObjectID> &r_result) const {
+	if (entries.is_empty()) {
+		return;
+	}
+	const real_t reach = MAX(p_radius, 0) + max_radius;
+	const Vector3i from = _get_cell(p_position - Vector3(reach, reach, reach));
+	const Vector3i to = _get_cell(p_position + Vector3(reach, reach, reach));
+	const int64_t cell_count = (int64_t(to.x) - from.x + 1) * (int64_t(to.y) - from.y + 1) * (int64_t(to.z) - from.z + 1);
+
+	auto check_cell = [&](const LocalVector<ObjectID> &p_cell) {
+		for (const ObjectID &id : p_cell) {
+			const Entry &entry = entries[id];
+			const real_t range = p_radius + entry.radius;
+			if (entry.position.distance_squared_to(p_position) <= range * range) {
+				r_result.insert(id);
+			}
+		}
+	};
+
+	if (cell_count > int64_t(cells.size())) {
+		// The sphere covers more cells than are occupied, visit the occupied ones instead.
+		for (const KeyValue<Vector3i, LocalVector<ObjectID>> &E : cells) {
+			if (E.key.x >= from.x && E.key.x <= to.x && E.key.y >= from.y && E.key.y <= to.y && E.key.z >= from.z && E.key.z <= to.z) {
+				check_cell(E.value);
+			}
+		}
+		return;
+	}
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const LocalVector<ObjectID> *cell = cells.getptr(Vector3i(x, y, z));
+				if (cell) {
+					check_cell(*cell);
+				}
+			}
+		}
+	}
+}
@@ -165,6 +165,7 @@ Error SceneMultiplayer::poll() {
 	}
 
 	replicator->on_network_process();
+	rpc->on_network_process();
 	return OK;
 }
 
@@ -174,6 +175,7 @@ void SceneMultiplayer::clear() {
 	connected_peers.clear();
 	packet_cache.clear();
 	replicator->on_reset();
+	rpc->on_reset();
 	cache->clear();
 	relay_buffer->clear();
 }
@@ -260,6 +262,8 @@ _FORCE_INLINE_ Error SceneMultiplayer::_send(const uint8_t *p_packet, int p_pack
 #endif
 
 Error SceneMultiplayer::send_command(int p_to, const uint8_t *p_packet, int p_packet_len) {
+	// Pending RPCs were issued first, they must not arrive after this command (e.g. a despawn).
+	rpc->flush_batches(p_to);
 	if (server_relay && get_unique_id() != 1 && p_to != 1 && multiplayer_peer->is_server_relay_supported()) {
 		// Send relay packet.
 		relay_buffer->seek(0);
@@ -418,6 +422,7 @@ void SceneMultiplayer::_del_peer(int p_id) {
 	}
 
 	replicator->on_peer_change(p_id, false);
+	rpc->on_peer_change(p_id, false);
 	cache->on_peer_change(p_id, false);
 	connected_peers.erase(p_id);
 	emit_signal(SNAME("peer_disconnected"), p_id);
@@ -632,6 +637,62 @@ int SceneMultiplayer::get_max_delta_packet_size() const {
 	return replicator->get_max_delta_packet_size();
 }
 
+void SceneMultiplayer::set_sync_baseline_compression_enabled(bool p_enabled) {
+	replicator->set_sync_baseline_compression_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_sync_baseline_compression_enabled() const {
+	return replicator->is_sync_baseline_compression_enabled();
+}
+
+Error SceneMultiplayer::set_peer_viewpoint(int p_peer, const Vector3 &p_position, real_t p_radius) {
+	return replicator->set_peer_viewpoint(p_peer, p_position, p_radius);
+}
+
+void SceneMultiplayer::remove_peer_viewpoint(int p_peer) {
+	replicator->remove_peer_viewpoint(p_peer);
+}
+
+void SceneMultiplayer::set_interest_cell_size(real_t p_size) {
+	replicator->set_interest_cell_size(p_size);
+}
+
+real_t SceneMultiplayer::get_interest_cell_size() const {
+	return replicator->get_interest_cell_size();
+}
+
+Dictionary SceneMultiplayer::get_replication_stats() const {
+	return replicator->get_stats();
+}
+
+void SceneMultiplayer::reset_replication_stats() {
+	replicator->reset_stats();
+}
+
+void SceneMultiplayer::set_rpc_batching_enabled(bool p_enabled) {
+	rpc->set_batching_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_rpc_batching_enabled() const {
+	return rpc->is_batching_enabled();
+}
+
+void SceneMultiplayer::set_max_rpc_batch_size(int p_size) {
+	rpc->set_max_batch_size(p_size);
+}
+
+int SceneMultiplayer::get_max_rpc_batch_size() const {
+	return rpc->get_max_batch_size();
+}
+
+Dictionary SceneMultiplayer::get_rpc_stats() const {
+	return rpc->get_stats();
+}
+
+void SceneMultiplayer::reset_rpc_stats() {
+	rpc->reset_stats();
+}
+
 void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &SceneMultiplayer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &SceneMultiplayer::get_root_path);
@@ -660,6 +721,20 @@ void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_sync_packet_size", "size"), &SceneMultiplayer::set_max_sync_packet_size);
 	ClassDB::bind_method(D_METHOD("get_max_delta_packet_size"), &SceneMultiplayer::get_max_delta_packet_size);
 	ClassDB::bind_method(D_METHOD("set_max_delta_packet_size", "size"), &SceneMultiplayer::set_max_delta_packet_size);
+	ClassDB::bind_method(D_METHOD("set_sync_baseline_compression_enabled", "enabled"), &SceneMultiplayer::set_sync_baseline_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_sync_baseline_compression_enabled"), &SceneMultiplayer::is_sync_baseline_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_peer_viewpoint", "peer", "position", "radius"), &SceneMultiplayer::set_peer_viewpoint);
+	ClassDB::bind_method(D_METHOD("remove_peer_viewpoint", "peer"), &SceneMultiplayer::remove_peer_viewpoint);
+	ClassDB::bind_method(D_METHOD("set_interest_cell_size", "size"), &SceneMultiplayer::set_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("get_interest_cell_size"), &SceneMultiplayer::get_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("get_replication_stats"), &SceneMultiplayer::get_replication_stats);
+	ClassDB::bind_method(D_METHOD("reset_replication_stats"), &SceneMultiplayer::reset_replication_stats);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enabled"), &SceneMultiplayer::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &SceneMultiplayer::is_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("set_max_rpc_batch_size", "size"), &SceneMultiplayer::set_max_rpc_batch_size);
+	ClassDB::bind_method(D_METHOD("get_max_rpc_batch_size"), &SceneMultiplayer::get_max_rpc_batch_size);
+	ClassDB::bind_method(D_METHOD("get_rpc_stats"), &SceneMultiplayer::get_rpc_stats);
+	ClassDB::bind_method(D_METHOD("reset_rpc_stats"), &SceneMultiplayer::reset_rpc_stats);
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "auth_callback"), "set_auth_callback", "get_auth_callback");
@@ -669,6 +744,10 @@ void SceneMultiplayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_packet_size"), "set_max_sync_packet_size", "get_max_sync_packet_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_delta_packet_size"), "set_max_delta_packet_size", "get_max_delta_packet_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "sync_baseline_compression"), "set_sync_baseline_compression_enabled", "is_sync_baseline_compression_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_rpc_batch_size"), "set_max_rpc_batch_size", "get_max_rpc_batch_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_cell_size", PROPERTY_HINT_RANGE, "0.01,1000,0.01,or_greater,suffix:m"), "set_interest_cell_size", "get_interest_cell_size");
 
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
 
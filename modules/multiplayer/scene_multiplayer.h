@@ -201,6 +201,25 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_sync_baseline_compression_enabled(bool p_enabled);
+	bool is_sync_baseline_compression_enabled() const;
+
+	Error set_peer_viewpoint(int p_peer, const Vector3 &p_position, real_t p_radius);
+	void remove_peer_viewpoint(int p_peer);
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	Dictionary get_replication_stats() const;
+	void reset_replication_stats();
+
+	void set_rpc_batching_enabled(bool p_enabled);
+	bool is_rpc_batching_enabled() const;
+	void set_max_rpc_batch_size(int p_size);
+	int get_max_rpc_batch_size() const;
+
+	Dictionary get_rpc_stats() const;
+	void reset_rpc_stats();
+
 	SceneMultiplayer();
 	~SceneMultiplayer();
 };
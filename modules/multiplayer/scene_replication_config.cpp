@@ -56,6 +56,22 @@ bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_val
 			property_set_replication_mode(prop.name, mode);
 			return true;
 		}
+		if (what == "encoding") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			PropertyEncoding encoding = (PropertyEncoding)p_value.operator int();
+			ERR_FAIL_COND_V(encoding < PROPERTY_ENCODING_VARIANT || encoding > PROPERTY_ENCODING_QUATERNION, false);
+			property_set_encoding(prop.name, encoding);
+			return true;
+		} else if (what == "encoding_bits") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			property_set_encoding_bits(prop.name, p_value);
+			return true;
+		} else if (what == "encoding_range") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::VECTOR2, false);
+			const Vector2 range = p_value;
+			property_set_encoding_range(prop.name, range.x, range.y);
+			return true;
+		}
 		ERR_FAIL_COND_V(p_value.get_type() != Variant::BOOL, false);
 		if (what == "spawn") {
 			property_set_spawn(prop.name, p_value);
@@ -90,16 +106,32 @@ bool SceneReplicationConfig::_get(const StringName &p_name, Variant &r_ret) cons
 		} else if (what == "replication_mode") {
 			r_ret = prop.mode;
 			return true;
+		} else if (what == "encoding") {
+			r_ret = prop.encoding.encoding;
+			return true;
+		} else if (what == "encoding_bits") {
+			r_ret = prop.encoding.bits;
+			return true;
+		} else if (what == "encoding_range") {
+			r_ret = Vector2(prop.encoding.min, prop.encoding.max);
+			return true;
 		}
 	}
 	return false;
 }
 
 void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) const {
-	for (int i = 0; i < properties.size(); i++) {
+	int i = 0;
+	for (List<ReplicationProperty>::ConstIterator itr = properties.begin(); itr != properties.end(); ++itr, ++i) {
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/spawn", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/replication_mode", PROPERTY_HINT_ENUM, "Never,Always,On Change", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		if (itr->encoding.encoding == PROPERTY_ENCODING_VARIANT) {
+			continue; // Only store encodings when customized.
+		}
+		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/encoding", PROPERTY_HINT_ENUM, "Variant,Bool,Bits,Varint,Quantized,Half,Quaternion", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/encoding_bits", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::VECTOR2, "properties/" + itos(i) + "/encoding_range", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 	}
 }
 
@@ -109,6 +141,8 @@ void SceneReplicationConfig::reset_state() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_encodings.clear();
+	sync_schema = false;
 }
 
 TypedArray<NodePath> SceneReplicationConfig::get_properties() const {
@@ -225,6 +259,54 @@ void SceneReplicationConfig::property_set_replication_mode(const NodePath &p_pat
 	dirty = true;
 }
 
+SceneReplicationConfig::PropertyEncoding SceneReplicationConfig::property_get_encoding(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, PROPERTY_ENCODING_VARIANT);
+	return E->get().encoding.encoding;
+}
+
+void SceneReplicationConfig::property_set_encoding(const NodePath &p_path, PropertyEncoding p_encoding) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().encoding.encoding == p_encoding) {
+		return;
+	}
+	E->get().encoding.encoding = p_encoding;
+	dirty = true;
+}
+
+int SceneReplicationConfig::property_get_encoding_bits(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0);
+	return E->get().encoding.bits;
+}
+
+void SceneReplicationConfig::property_set_encoding_bits(const NodePath &p_path, int p_bits) {
+	ERR_FAIL_COND_MSG(p_bits < 0 || p_bits > 32, "Encoding bits must be between 0 (default) and 32.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().encoding.bits == p_bits) {
+		return;
+	}
+	E->get().encoding.bits = p_bits;
+	dirty = true;
+}
+
+Vector2 SceneReplicationConfig::property_get_encoding_range(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, Vector2());
+	return Vector2(E->get().encoding.min, E->get().encoding.max);
+}
+
+void SceneReplicationConfig::property_set_encoding_range(const NodePath &p_path, real_t p_min, real_t p_max) {
+	ERR_FAIL_COND_MSG(p_min >= p_max, "Encoding range minimum must be lower than its maximum.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	E->get().encoding.min = p_min;
+	E->get().encoding.max = p_max;
+	dirty = true;
+}
+
 void SceneReplicationConfig::_update() {
 	if (!dirty) {
 		return;
@@ -233,6 +315,8 @@ void SceneReplicationConfig::_update() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_encodings.clear();
+	sync_schema = false;
 	for (const ReplicationProperty &prop : properties) {
 		if (prop.spawn) {
 			spawn_props.push_back(prop.name);
@@ -240,6 +324,8 @@ void SceneReplicationConfig::_update() {
 		switch (prop.mode) {
 			case REPLICATION_MODE_ALWAYS:
 				sync_props.push_back(prop.name);
+				sync_encodings.push_back(prop.encoding);
+				sync_schema = sync_schema || prop.encoding.encoding != PROPERTY_ENCODING_VARIANT;
 				break;
 			case REPLICATION_MODE_ON_CHANGE:
 				watch_props.push_back(prop.name);
@@ -271,6 +357,20 @@ const List<NodePath> &SceneReplicationConfig::get_watch_properties() {
 	return watch_props;
 }
 
+bool SceneReplicationConfig::has_sync_schema() {
+	if (dirty) {
+		_update();
+	}
+	return sync_schema;
+}
+
+const LocalVector<SceneReplicationConfig::EncodingInfo> &SceneReplicationConfig::get_sync_encodings() {
+	if (dirty) {
+		_update();
+	}
+	return sync_encodings;
+}
+
 void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_properties"), &SceneReplicationConfig::get_properties);
 	ClassDB::bind_method(D_METHOD("add_property", "path", "index"), &SceneReplicationConfig::add_property, DEFVAL(-1));
@@ -282,10 +382,25 @@ void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("property_get_replication_mode", "path"), &SceneReplicationConfig::property_get_replication_mode);
 	ClassDB::bind_method(D_METHOD("property_set_replication_mode", "path", "mode"), &SceneReplicationConfig::property_set_replication_mode);
 
+	ClassDB::bind_method(D_METHOD("property_get_encoding", "path"), &SceneReplicationConfig::property_get_encoding);
+	ClassDB::bind_method(D_METHOD("property_set_encoding", "path", "encoding"), &SceneReplicationConfig::property_set_encoding);
+	ClassDB::bind_method(D_METHOD("property_get_encoding_bits", "path"), &SceneReplicationConfig::property_get_encoding_bits);
+	ClassDB::bind_method(D_METHOD("property_set_encoding_bits", "path", "bits"), &SceneReplicationConfig::property_set_encoding_bits);
+	ClassDB::bind_method(D_METHOD("property_get_encoding_range", "path"), &SceneReplicationConfig::property_get_encoding_range);
+	ClassDB::bind_method(D_METHOD("property_set_encoding_range", "path", "min", "max"), &SceneReplicationConfig::property_set_encoding_range);
+
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_NEVER);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ON_CHANGE);
 
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_VARIANT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_BOOL);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_BITS);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_VARINT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_QUANTIZED);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_HALF);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_QUATERNION);
+
 	// Deprecated.
 	ClassDB::bind_method(D_METHOD("property_get_sync", "path"), &SceneReplicationConfig::property_get_sync);
 	ClassDB::bind_method(D_METHOD("property_set_sync", "path", "enabled"), &SceneReplicationConfig::property_set_sync);
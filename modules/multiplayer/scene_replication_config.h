@@ -32,6 +32,7 @@
 #define SCENE_REPLICATION_CONFIG_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 
 class SceneReplicationConfig : public Resource {
@@ -46,11 +47,29 @@ public:
 		REPLICATION_MODE_ON_CHANGE,
 	};
 
+	enum PropertyEncoding {
+		PROPERTY_ENCODING_VARIANT,
+		PROPERTY_ENCODING_BOOL,
+		PROPERTY_ENCODING_BITS,
+		PROPERTY_ENCODING_VARINT,
+		PROPERTY_ENCODING_QUANTIZED,
+		PROPERTY_ENCODING_HALF,
+		PROPERTY_ENCODING_QUATERNION,
+	};
+
+	struct EncodingInfo {
+		PropertyEncoding encoding = PROPERTY_ENCODING_VARIANT;
+		int bits = 0; // 0 means the default for the encoding.
+		real_t min = 0;
+		real_t max = 1;
+	};
+
 private:
 	struct ReplicationProperty {
 		NodePath name;
 		bool spawn = true;
 		ReplicationMode mode = REPLICATION_MODE_ALWAYS;
+		EncodingInfo encoding;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -67,6 +86,8 @@ private:
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
+	LocalVector<EncodingInfo> sync_encodings;
+	bool sync_schema = false;
 	bool dirty = false;
 
 	void _update();
@@ -100,13 +121,27 @@ public:
 	ReplicationMode property_get_replication_mode(const NodePath &p_path);
 	void property_set_replication_mode(const NodePath &p_path, ReplicationMode p_mode);
 
+	PropertyEncoding property_get_encoding(const NodePath &p_path);
+	void property_set_encoding(const NodePath &p_path, PropertyEncoding p_encoding);
+
+	int property_get_encoding_bits(const NodePath &p_path);
+	void property_set_encoding_bits(const NodePath &p_path, int p_bits);
+
+	Vector2 property_get_encoding_range(const NodePath &p_path);
+	void property_set_encoding_range(const NodePath &p_path, real_t p_min, real_t p_max);
+
 	const List<NodePath> &get_spawn_properties();
 	const List<NodePath> &get_sync_properties();
 	const List<NodePath> &get_watch_properties();
 
+	// Encodings of the sync properties, only meaningful when has_sync_schema() is true.
+	bool has_sync_schema();
+	const LocalVector<EncodingInfo> &get_sync_encodings();
+
 	SceneReplicationConfig() {}
 };
 
 VARIANT_ENUM_CAST(SceneReplicationConfig::ReplicationMode);
+VARIANT_ENUM_CAST(SceneReplicationConfig::PropertyEncoding);
 
 #endif // SCENE_REPLICATION_CONFIG_H
@@ -31,6 +31,7 @@
 #include "scene_replication_interface.h"
 
 #include "scene_multiplayer.h"
+#include "scene_replication_schema.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
@@ -40,6 +41,21 @@
 	if (packet_cache.size() < m_amount) \
 		packet_cache.resize(m_amount);
 
+// Sync states use the bit-packed schema when the configuration customizes the encoding of any sync property.
+static Error _encode_sync_state(SceneReplicationConfig *p_config, const Variant **p_variants, int p_count, uint8_t *p_buffer, int &r_len) {
+	if (p_config->has_sync_schema()) {
+		return SceneReplicationSchema::encode(p_config->get_sync_encodings(), p_variants, p_count, p_buffer, r_len);
+	}
+	return MultiplayerAPI::encode_and_compress_variants(p_variants, p_count, p_buffer, r_len);
+}
+
+static Error _decode_sync_state(SceneReplicationConfig *p_config, Vector<Variant> &r_variants, const uint8_t *p_buffer, int p_len, int &r_len) {
+	if (p_config->has_sync_schema()) {
+		return SceneReplicationSchema::decode(p_config->get_sync_encodings(), r_variants, p_buffer, p_len, r_len);
+	}
+	return MultiplayerAPI::decode_and_decompress_variants(r_variants, p_buffer, p_len, r_len);
+}
+
 #ifdef DEBUG_ENABLED
 _FORCE_INLINE_ void SceneReplicationInterface::_profile_node_data(const String &p_what, ObjectID p_id, int p_size) {
 	if (EngineDebugger::is_profiling("multiplayer:replication")) {
@@ -104,6 +120,12 @@ void SceneReplicationInterface::on_peer_change(int p_id, bool p_connected) {
 	} else {
 		ERR_FAIL_COND(!peers_info.has(p_id));
 		_free_remotes(peers_info[p_id]);
+		for (const ObjectID &sid : peers_info[p_id].interest_nodes) {
+			MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+			if (sync) {
+				sync->set_interest_relevant(p_id, false);
+			}
+		}
 		peers_info.erase(p_id);
 	}
 }
@@ -124,6 +146,7 @@ void SceneReplicationInterface::on_reset() {
 		ERR_CONTINUE(!sync);
 		sync->reset();
 	}
+	interest_grid.clear();
 	last_net_id = 0;
 }
 
@@ -141,10 +164,18 @@ void SceneReplicationInterface::on_network_process() {
 		spawn_queue.clear();
 	}
 
+	// Acknowledge the sync states received since the last frame.
+	_send_sync_acks();
+
+	// Update relevancy before sending, so nodes entering the interest area are spawned first.
+	_update_interest();
+
 	// Process syncs.
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
+	sync_snapshots.clear();
+	snapshot_buffer.clear();
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
-		const HashSet<ObjectID> to_sync = E.value.sync_nodes;
+		const HashSet<ObjectID> &to_sync = E.value.sync_nodes;
 		if (to_sync.is_empty()) {
 			continue; // Nothing to sync
 		}
@@ -280,7 +311,13 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	TrackedNode &tobj = _track(oid);
 	tobj.synchronizers.erase(sid);
 	sync_nodes.erase(sid);
+	interest_grid.remove(sid);
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		E.value.sync_baselines.erase(sid);
+		E.value.recv_sync_history.erase(sid);
+		if (E.value.interest_nodes.erase(sid)) {
+			sync->set_interest_relevant(E.key, false);
+		}
 		E.value.sync_nodes.erase(sid);
 		E.value.last_watch_usecs.erase(sid);
 		if (sync->get_net_id()) {
@@ -302,6 +339,87 @@ void SceneReplicationInterface::_visibility_changed(int p_peer, ObjectID p_sid)
 	_update_sync_visibility(p_peer, sync);
 }
 
+void SceneReplicationInterface::_update_interest() {
+	// Refresh the position of the synchronizers we control which use interest management.
+	// Those which stopped using it leave the grid, so both their side and the peers' side are cleared below.
+	for (const ObjectID &sid : sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		Vector3 position;
+		if (sync && sync->is_interest_enabled() && _has_authority(sync) && sync->get_interest_position(position)) {
+			interest_grid.update(sid, position, sync->get_interest_radius());
+		} else {
+			interest_grid.remove(sid);
+		}
+	}
+
+	// Collect relevancy changes, each peer only sees the synchronizers near its viewpoint.
+	LocalVector<Pair<int, ObjectID>> entered;
+	LocalVector<Pair<int, ObjectID>> exited;
+	HashSet<ObjectID> relevant;
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		PeerInfo &info = E.value;
+		if (info.interest_nodes.is_empty() && (!info.has_viewpoint || interest_grid.is_empty())) {
+			continue; // Nothing was or will be relevant.
+		}
+		relevant.clear();
+		if (info.has_viewpoint) {
+			interest_grid.query(info.viewpoint, info.view_radius, relevant);
+		}
+		for (const ObjectID &sid : info.interest_nodes) {
+			if (!relevant.has(sid)) {
+				exited.push_back(Pair<int, ObjectID>(E.key, sid));
+			}
+		}
+		for (const ObjectID &sid : relevant) {
+			if (!info.interest_nodes.has(sid)) {
+				entered.push_back(Pair<int, ObjectID>(E.key, sid));
+			}
+		}
+	}
+
+	// Apply them, only the pairs that changed need a visibility update.
+	for (const Pair<int, ObjectID> &change : exited) {
+		peers_info[change.first].interest_nodes.erase(change.second);
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(change.second);
+		if (sync) {
+			sync->set_interest_relevant(change.first, false);
+			_visibility_changed(change.first, change.second);
+		}
+	}
+	for (const Pair<int, ObjectID> &change : entered) {
+		peers_info[change.first].interest_nodes.insert(change.second);
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(change.second);
+		if (sync) {
+			sync->set_interest_relevant(change.first, true);
+			_visibility_changed(change.first, change.second);
+		}
+	}
+	interest_changes += entered.size() + exited.size();
+}
+
+Error SceneReplicationInterface::set_peer_viewpoint(int p_peer, const Vector3 &p_position, real_t p_radius) {
+	ERR_FAIL_COND_V_MSG(!peers_info.has(p_peer), ERR_INVALID_PARAMETER, vformat("Unknown peer %d.", p_peer));
+	ERR_FAIL_COND_V_MSG(p_radius < 0, ERR_INVALID_PARAMETER, "Viewpoint radius must be greater or equal to 0.");
+	PeerInfo &info = peers_info[p_peer];
+	info.has_viewpoint = true;
+	info.viewpoint = p_position;
+	info.view_radius = p_radius;
+	return OK;
+}
+
+void SceneReplicationInterface::remove_peer_viewpoint(int p_peer) {
+	ERR_FAIL_COND_MSG(!peers_info.has(p_peer), vformat("Unknown peer %d.", p_peer));
+	peers_info[p_peer].has_viewpoint = false;
+}
+
+void SceneReplicationInterface::set_interest_cell_size(real_t p_size) {
+	interest_grid.set_cell_size(p_size);
+}
+
+real_t SceneReplicationInterface::get_interest_cell_size() const {
+	return interest_grid.get_cell_size();
+}
+
 bool SceneReplicationInterface::is_rpc_visible(const ObjectID &p_oid, int p_peer) const {
 	if (!tracked_nodes.has(p_oid)) {
 		return true; // Untracked nodes are always visible to RPCs.
@@ -745,6 +863,7 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 		if (ofs + 4 + 8 + 4 + size > delta_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+			delta_bytes_sent += ofs;
 			ofs = 1;
 		}
 		if (size) {
@@ -753,6 +872,7 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			ofs += encode_uint32(size, &ptr[ofs]);
 			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
 			ofs += size;
+			delta_bytes_encoded += size;
 		}
 #ifdef DEBUG_ENABLED
 		_profile_node_data("delta_out", oid, size);
@@ -762,6 +882,7 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 	if (ofs > 1) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+		delta_bytes_sent += ofs;
 	}
 }
 
@@ -800,14 +921,85 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 	return OK;
 }
 
+SceneReplicationInterface::SyncSnapshot SceneReplicationInterface::_get_sync_snapshot(const ObjectID &p_oid, MultiplayerSynchronizer *p_sync, Node *p_node) {
+	const SyncSnapshot *cached = sync_snapshots.getptr(p_oid);
+	if (cached) {
+		return *cached;
+	}
+	// Store a failed snapshot first, so errors are only reported once per frame.
+	SyncSnapshot &snapshot = sync_snapshots[p_oid];
+	int size;
+	Vector<Variant> vars;
+	Vector<const Variant *> varp;
+	SceneReplicationConfig *config = p_sync->get_replication_config_ptr();
+	const List<NodePath> props = config->get_sync_properties();
+	Error err = MultiplayerSynchronizer::get_state(props, p_node, vars, varp);
+	ERR_FAIL_COND_V_MSG(err != OK, snapshot, "Unable to retrieve sync state.");
+	err = _encode_sync_state(config, varp.ptrw(), varp.size(), nullptr, size);
+	ERR_FAIL_COND_V_MSG(err != OK, snapshot, "Unable to encode sync state.");
+	// TODO Handle single state above MTU.
+	ERR_FAIL_COND_V_MSG(size > sync_mtu, snapshot, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, p_node->get_path()));
+	snapshot.offset = snapshot_buffer.size();
+	snapshot_buffer.resize(snapshot.offset + size);
+	if (size) {
+		_encode_sync_state(config, varp.ptrw(), varp.size(), &snapshot_buffer[snapshot.offset], size);
+	}
+	snapshot.size = size;
+	sync_snapshots_encoded++;
+	sync_bytes_encoded += size;
+	return snapshot;
+}
+
+const uint8_t *SceneReplicationInterface::_get_sync_baseline(PeerInfo &p_info, const ObjectID &p_oid, uint32_t p_size, uint16_t p_sync_net_time, uint16_t &r_time) {
+	const SyncBaseline *baseline = p_info.sync_baselines.getptr(p_oid);
+	if (!baseline || !baseline->acked) {
+		return nullptr;
+	}
+	const uint16_t age = p_sync_net_time - baseline->acked_time;
+	if (age == 0 || age >= SYNC_HISTORY_SIZE) {
+		return nullptr; // Too old, the receiver might not have it anymore.
+	}
+	const SentSync &sent = p_info.sent_syncs[baseline->acked_time % SYNC_HISTORY_SIZE];
+	if (!sent.valid || sent.time != baseline->acked_time) {
+		return nullptr;
+	}
+	const SentState *state = sent.states.getptr(p_oid);
+	if (!state || state->size != p_size) {
+		return nullptr; // Only states of the same size can be encoded against each other.
+	}
+	r_time = baseline->acked_time;
+	return &sent.data[state->offset];
+}
+
 void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
-	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
+	MAKE_ROOM(/* header */ 4 + /* element */ 4 + 4 + 2 + sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
-	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (baseline_compression ? (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT) : 0);
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	// With baseline compression, a frame split over multiple packets numbers them, so they are acknowledged separately.
+	uint32_t packet = 0;
+	if (baseline_compression) {
+		ptr[ofs++] = 0;
+	}
+	const int header_end = ofs;
+
+	// With baseline compression, remember what is sent, so it can be used as a baseline once acknowledged.
+	PeerInfo &info = peers_info[p_peer];
+	SentSync *sent = nullptr;
+	if (baseline_compression) {
+		if (info.sent_syncs.is_empty()) {
+			info.sent_syncs.resize(SYNC_HISTORY_SIZE);
+		}
+		sent = &info.sent_syncs[p_sync_net_time % SYNC_HISTORY_SIZE];
+		sent->time = p_sync_net_time;
+		sent->valid = true;
+		sent->states.clear();
+		sent->data.clear();
+	}
+
 	// Can only send updates for already notified nodes.
-	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
+	// The state of each synchronizer is encoded once per frame (see _get_sync_snapshot), then copied in each peer packet.
 	for (const ObjectID &oid : p_synchronizers) {
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
 		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
@@ -822,50 +1014,179 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 			// The path based sync is not yet confirmed, skipping.
 			continue;
 		}
-		int size;
-		Vector<Variant> vars;
-		Vector<const Variant *> varp;
-		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
-		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
-		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
-		// TODO Handle single state above MTU.
-		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
-		if (ofs + 4 + 4 + size > sync_mtu) {
+		const SyncSnapshot snapshot = _get_sync_snapshot(oid, sync, node);
+		if (snapshot.size < 0) {
+			continue; // Error already reported.
+		}
+		int size = snapshot.size;
+		const uint8_t *payload = size ? &snapshot_buffer[snapshot.offset] : nullptr;
+		int payload_size = size;
+		int header_size = 4 + 4;
+		uint16_t baseline_time = 0;
+		uint32_t data_ofs = 0;
+		if (sent && size) {
+			data_ofs = sent->data.size();
+			sent->data.resize(data_ofs + size);
+			memcpy(&sent->data[data_ofs], payload, size);
+
+			const uint8_t *baseline = nullptr;
+			if (info.baseline_resets.erase(sync->get_net_id())) {
+				// The peer could not rebuild the state, send it in full and ignore older acknowledgments.
+				SyncBaseline &sb = info.sync_baselines[oid];
+				sb.acked = false;
+				sb.min_time = p_sync_net_time;
+				sb.has_min_time = true;
+			} else {
+				baseline = _get_sync_baseline(info, oid, size, p_sync_net_time, baseline_time);
+			}
+			if (baseline) {
+				SceneReplicationSchema::encode_baseline_delta(baseline, payload, size, baseline_buffer);
+				if (int(baseline_buffer.size()) < size) {
+					payload = baseline_buffer.ptr();
+					payload_size = baseline_buffer.size();
+					header_size += 2;
+					sync_baseline_deltas++;
+				}
+			}
+		}
+		if (ofs > header_end && ofs + header_size + payload_size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
-			ofs = 3;
+			sync_bytes_sent += ofs;
+			ofs = header_end;
+			if (baseline_compression) {
+				packet++;
+				ptr[3] = MIN(packet, 255u);
+			}
+		}
+		if (sent && size) {
+			SentState &state = sent->states[oid];
+			state.offset = data_ofs;
+			state.size = size;
+			state.packet = packet;
 		}
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
-			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
-			ofs += size;
+			if (header_size > 8) {
+				// States encoded against a baseline have the high bit of their size set, followed by the baseline time.
+				ofs += encode_uint32(payload_size | 0x80000000, &ptr[ofs]);
+				ofs += encode_uint16(baseline_time, &ptr[ofs]);
+			} else {
+				ofs += encode_uint32(payload_size, &ptr[ofs]);
+			}
+			if (payload_size) {
+				memcpy(&ptr[ofs], payload, payload_size);
+			}
+			ofs += payload_size;
 		}
 #ifdef DEBUG_ENABLED
-		_profile_node_data("sync_out", oid, size);
+		_profile_node_data("sync_out", oid, payload_size);
 #endif
 	}
-	if (ofs > 3) {
+	if (ofs > header_end) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+		sync_bytes_sent += ofs;
+	}
+}
+
+void SceneReplicationInterface::_send_sync_acks() {
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		PeerInfo &info = E.value;
+		if (!info.has_pending_sync_ack) {
+			continue;
+		}
+		info.has_pending_sync_ack = false;
+		// Acknowledge the packets received for the last sync time, and request full states for the ones we failed to rebuild.
+		MAKE_ROOM(sync_mtu);
+		uint8_t *ptr = packet_cache.ptrw();
+		ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT) | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+		int ofs = 1;
+		ofs += encode_uint16(info.pending_sync_ack, &ptr[ofs]);
+		ofs += encode_uint32(info.pending_sync_ack_packets, &ptr[ofs]);
+		for (const uint32_t &net_id : info.pending_baseline_resets) {
+			if (ofs + 4 > sync_mtu) {
+				break; // The others will be requested again.
+			}
+			ofs += encode_uint32(net_id, &ptr[ofs]);
+		}
+		info.pending_baseline_resets.clear();
+		_send_raw(packet_cache.ptr(), ofs, E.key, false);
+	}
+}
+
+Error SceneReplicationInterface::_on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 7 || (p_buffer_len - 7) % 4, ERR_INVALID_DATA, "Invalid sync acknowledgment received");
+	PeerInfo *info = peers_info.getptr(p_from);
+	ERR_FAIL_NULL_V(info, ERR_INVALID_DATA);
+	const uint16_t time = decode_uint16(&p_buffer[1]);
+	const uint32_t packets = decode_uint32(&p_buffer[3]);
+	for (int ofs = 7; ofs < p_buffer_len; ofs += 4) {
+		info->baseline_resets.insert(decode_uint32(&p_buffer[ofs]));
+	}
+	if (info->sent_syncs.is_empty()) {
+		return OK;
+	}
+	const SentSync &sent = info->sent_syncs[time % SYNC_HISTORY_SIZE];
+	if (!sent.valid || sent.time != time) {
+		return OK; // Too old.
+	}
+	for (const KeyValue<ObjectID, SentState> &E : sent.states) {
+		if (E.value.packet >= 32 || !(packets & (1u << E.value.packet))) {
+			continue; // Sent in a packet of the frame that was lost.
+		}
+		SyncBaseline &baseline = info->sync_baselines[E.key];
+		if (baseline.has_min_time && uint16_t(time - baseline.min_time) >= 32768) {
+			continue; // Older than the last full state sent after a reset.
+		}
+		if (!baseline.acked || uint16_t(time - baseline.acked_time) < 32768) {
+			baseline.acked_time = time;
+			baseline.acked = true;
+		}
 	}
+	return OK;
 }
 
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
-	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 1, ERR_INVALID_DATA, "Invalid sync packet received");
 	bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
+	bool has_baselines = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT)) != 0;
+	if (is_delta && has_baselines) {
+		return _on_sync_ack_receive(p_from, p_buffer, p_buffer_len);
+	}
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
 	if (is_delta) {
 		return on_delta_receive(p_from, p_buffer, p_buffer_len);
 	}
 	uint16_t time = decode_uint16(&p_buffer[1]);
+	PeerInfo *info = nullptr;
 	int ofs = 3;
+	if (has_baselines) {
+		info = peers_info.getptr(p_from);
+		ERR_FAIL_NULL_V(info, ERR_INVALID_DATA);
+		const uint8_t packet = p_buffer[ofs++];
+		if (!info->has_pending_sync_ack || (time != info->pending_sync_ack && uint16_t(time - info->pending_sync_ack) < 32768)) {
+			info->pending_sync_ack = time;
+			info->pending_sync_ack_packets = 0;
+			info->has_pending_sync_ack = true;
+		}
+		if (time == info->pending_sync_ack && packet < 32) {
+			info->pending_sync_ack_packets |= 1u << packet;
+		}
+	}
 	while (ofs + 8 < p_buffer_len) {
 		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
 		uint32_t size = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
+		const bool from_baseline = has_baselines && (size & 0x80000000);
+		uint16_t baseline_time = 0;
+		if (from_baseline) {
+			size &= 0x7FFFFFFF;
+			ERR_FAIL_COND_V(ofs + 2 > p_buffer_len, ERR_INVALID_DATA);
+			baseline_time = decode_uint16(&p_buffer[ofs]);
+			ofs += 2;
+		}
 		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
 		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
 		if (!sync) {
@@ -879,20 +1200,51 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 			ofs += size;
 			ERR_CONTINUE_MSG(true, "Ignoring sync data from non-authority or for missing node.");
 		}
+		const uint8_t *state = &p_buffer[ofs];
+		int state_size = size;
+		ofs += size;
+		if (has_baselines) {
+			LocalVector<ReceivedSync> &history = info->recv_sync_history[sync->get_instance_id()];
+			if (history.is_empty()) {
+				history.resize(SYNC_HISTORY_SIZE);
+			}
+			ReceivedSync &received = history[time % SYNC_HISTORY_SIZE];
+			if (from_baseline) {
+				const ReceivedSync &baseline = history[baseline_time % SYNC_HISTORY_SIZE];
+				Error err = ERR_UNAVAILABLE;
+				if (baseline.valid && baseline.time == baseline_time) {
+					err = SceneReplicationSchema::apply_baseline_delta(baseline.data.ptr(), baseline.data.size(), state, state_size, baseline_buffer);
+				}
+				if (err != OK) {
+					// Missing or invalid baseline, ask the authority for the full state.
+					info->pending_baseline_resets.insert(net_id);
+					continue;
+				}
+				received.data = baseline_buffer;
+			} else {
+				received.data.resize(state_size);
+				if (state_size) {
+					memcpy(received.data.ptr(), state, state_size);
+				}
+			}
+			received.time = time;
+			received.valid = true;
+			state = received.data.ptr();
+			state_size = received.data.size();
+		}
 		if (!sync->update_inbound_sync_time(time)) {
 			// State is too old.
-			ofs += size;
 			continue;
 		}
-		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		const List<NodePath> props = config->get_sync_properties();
 		Vector<Variant> vars;
 		vars.resize(props.size());
 		int consumed;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
+		Error err = _decode_sync_state(config, vars, state, state_size, consumed);
 		ERR_FAIL_COND_V(err, err);
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err, err);
-		ofs += size;
 		sync->emit_signal(SNAME("synchronized"));
 #ifdef DEBUG_ENABLED
 		_profile_node_data("sync_in", sync->get_instance_id(), size);
@@ -901,6 +1253,14 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 	return OK;
 }
 
+void SceneReplicationInterface::set_sync_baseline_compression_enabled(bool p_enabled) {
+	baseline_compression = p_enabled;
+}
+
+bool SceneReplicationInterface::is_sync_baseline_compression_enabled() const {
+	return baseline_compression;
+}
+
 void SceneReplicationInterface::set_max_sync_packet_size(int p_size) {
 	ERR_FAIL_COND_MSG(p_size < 128, "Sync maximum packet size must be at least 128 bytes.");
 	sync_mtu = p_size;
@@ -918,3 +1278,25 @@ void SceneReplicationInterface::set_max_delta_packet_size(int p_size) {
 int SceneReplicationInterface::get_max_delta_packet_size() const {
 	return delta_mtu;
 }
+
+Dictionary SceneReplicationInterface::get_stats() const {
+	Dictionary stats;
+	stats["sync_snapshots_encoded"] = sync_snapshots_encoded;
+	stats["sync_bytes_encoded"] = sync_bytes_encoded;
+	stats["sync_bytes_sent"] = sync_bytes_sent;
+	stats["delta_bytes_encoded"] = delta_bytes_encoded;
+	stats["delta_bytes_sent"] = delta_bytes_sent;
+	stats["interest_changes"] = interest_changes;
+	stats["sync_baseline_deltas"] = sync_baseline_deltas;
+	return stats;
+}
+
+void SceneReplicationInterface::reset_stats() {
+	sync_snapshots_encoded = 0;
+	sync_bytes_encoded = 0;
+	sync_bytes_sent = 0;
+	delta_bytes_encoded = 0;
+	delta_bytes_sent = 0;
+	interest_changes = 0;
+	sync_baseline_deltas = 0;
+}
@@ -33,8 +33,10 @@
 
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
+#include "scene_interest_grid.h"
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class SceneMultiplayer;
 class SceneCacheInterface;
@@ -60,6 +62,40 @@ private:
 		}
 	};
 
+	enum {
+		SYNC_HISTORY_SIZE = 32, // Sync states kept as baselines, per peer.
+	};
+
+	// A sync state sent to a peer, and the packet of its frame it was sent in.
+	struct SentState {
+		uint32_t offset = 0; // In SentSync::data.
+		uint32_t size = 0;
+		uint32_t packet = 0;
+	};
+
+	// Sync states sent to a peer at a given sync time.
+	struct SentSync {
+		uint16_t time = 0;
+		bool valid = false;
+		HashMap<ObjectID, SentState> states;
+		LocalVector<uint8_t> data;
+	};
+
+	// Last sync state of a synchronizer acknowledged by a peer.
+	struct SyncBaseline {
+		uint16_t acked_time = 0;
+		bool acked = false;
+		uint16_t min_time = 0; // Acknowledgments older than the last full state are ignored after a reset.
+		bool has_min_time = false;
+	};
+
+	// Sync state received from a peer at a given sync time.
+	struct ReceivedSync {
+		uint16_t time = 0;
+		bool valid = false;
+		LocalVector<uint8_t> data;
+	};
+
 	struct PeerInfo {
 		HashSet<ObjectID> sync_nodes;
 		HashSet<ObjectID> spawn_nodes;
@@ -67,6 +103,20 @@ private:
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
+		bool has_viewpoint = false;
+		Vector3 viewpoint;
+		real_t view_radius = 0;
+		HashSet<ObjectID> interest_nodes; // Synchronizers within reach of the viewpoint.
+		// Baseline compression, as the authority.
+		LocalVector<SentSync> sent_syncs; // Indexed by sync time modulo SYNC_HISTORY_SIZE.
+		HashMap<ObjectID, SyncBaseline> sync_baselines;
+		HashSet<uint32_t> baseline_resets; // Net IDs the peer failed to rebuild, sent in full next time.
+		// Baseline compression, as the receiver.
+		HashMap<ObjectID, LocalVector<ReceivedSync>> recv_sync_history;
+		uint16_t pending_sync_ack = 0;
+		uint32_t pending_sync_ack_packets = 0; // Bit mask of the packets of that frame which were received.
+		bool has_pending_sync_ack = false;
+		HashSet<uint32_t> pending_baseline_resets;
 	};
 
 	// Replication state.
@@ -86,12 +136,34 @@ private:
 	int pending_buffer_size = 0;
 	List<uint32_t> pending_sync_net_ids;
 
+	// Sync state snapshots, encoded once per network frame and shared by all peers.
+	struct SyncSnapshot {
+		uint32_t offset = 0;
+		int size = -1; // Negative when the state could not be encoded.
+	};
+	HashMap<ObjectID, SyncSnapshot> sync_snapshots;
+	LocalVector<uint8_t> snapshot_buffer;
+
+	// Spatial interest management.
+	SceneInterestGrid interest_grid;
+
+	// Replication metrics.
+	uint64_t sync_snapshots_encoded = 0;
+	uint64_t sync_bytes_encoded = 0;
+	uint64_t sync_bytes_sent = 0;
+	uint64_t delta_bytes_encoded = 0;
+	uint64_t delta_bytes_sent = 0;
+	uint64_t interest_changes = 0;
+	uint64_t sync_baseline_deltas = 0;
+
 	// Replicator config.
 	SceneMultiplayer *multiplayer = nullptr;
 	SceneCacheInterface *multiplayer_cache = nullptr;
 	PackedByteArray packet_cache;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 	int delta_mtu = 65535;
+	bool baseline_compression = false;
+	LocalVector<uint8_t> baseline_buffer;
 
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
@@ -101,7 +173,11 @@ private:
 	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
+	SyncSnapshot _get_sync_snapshot(const ObjectID &p_oid, MultiplayerSynchronizer *p_sync, Node *p_node);
 	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
+	const uint8_t *_get_sync_baseline(PeerInfo &p_info, const ObjectID &p_oid, uint32_t p_size, uint16_t p_sync_net_time, uint16_t &r_time);
+	void _send_sync_acks();
+	Error _on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
@@ -111,6 +187,7 @@ private:
 	Error _update_sync_visibility(int p_peer, MultiplayerSynchronizer *p_sync);
 	Error _update_spawn_visibility(int p_peer, const ObjectID &p_oid);
 	void _free_remotes(const PeerInfo &p_info);
+	void _update_interest();
 
 	template <typename T>
 	static T *get_id_as(const ObjectID &p_id) {
@@ -146,6 +223,17 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_sync_baseline_compression_enabled(bool p_enabled);
+	bool is_sync_baseline_compression_enabled() const;
+
+	Error set_peer_viewpoint(int p_peer, const Vector3 &p_position, real_t p_radius);
+	void remove_peer_viewpoint(int p_peer);
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	Dictionary get_stats() const;
+	void reset_stats();
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
@@ -0,0 +1,403 @@
+/**************************************************************************/
+/*  scene_replication_schema.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_replication_schema.h"
+
+#include "core/math/math_funcs.h"
+#include "scene/main/multiplayer_api.h"
+
+namespace {
+
+// Writes bits LSB first. When no buffer is given, only the size is computed.
+class BitWriter {
+	uint8_t *buffer = nullptr;
+	uint64_t bit_ofs = 0;
+
+public:
+	void write(uint64_t p_value, int p_bits) {
+		if (!buffer) {
+			bit_ofs += p_bits;
+			return;
+		}
+		while (p_bits > 0) {
+			const int shift = bit_ofs & 7;
+			const int count = MIN(8 - shift, p_bits);
+			uint8_t &byte = buffer[bit_ofs >> 3];
+			if (shift == 0) {
+				byte = 0;
+			}
+			byte |= uint8_t((p_value & ((1u << count) - 1)) << shift);
+			p_value >>= count;
+			p_bits -= count;
+			bit_ofs += count;
+		}
+	}
+
+	void align() {
+		bit_ofs = (bit_ofs + 7) & ~uint64_t(7);
+	}
+
+	uint8_t *get_aligned_ptr() {
+		align();
+		return buffer ? buffer + (bit_ofs >> 3) : nullptr;
+	}
+
+	void skip_bytes(int p_bytes) {
+		bit_ofs += uint64_t(p_bytes) * 8;
+	}
+
+	int get_size() const {
+		return int((bit_ofs + 7) >> 3);
+	}
+
+	BitWriter(uint8_t *p_buffer) {
+		buffer = p_buffer;
+	}
+};
+
+class BitReader {
+	const uint8_t *buffer = nullptr;
+	uint64_t bit_len = 0;
+	uint64_t bit_ofs = 0;
+
+public:
+	bool overflow = false;
+
+	uint64_t read(int p_bits) {
+		if (bit_ofs + p_bits > bit_len) {
+			overflow = true;
+			return 0;
+		}
+		uint64_t value = 0;
+		int read = 0;
+		while (read < p_bits) {
+			const int shift = bit_ofs & 7;
+			const int count = MIN(8 - shift, p_bits - read);
+			const uint64_t bits = (buffer[bit_ofs >> 3] >> shift) & ((1u << count) - 1);
+			value |= bits << read;
+			read += count;
+			bit_ofs += count;
+		}
+		return value;
+	}
+
+	void align() {
+		bit_ofs = MIN((bit_ofs + 7) & ~uint64_t(7), bit_len);
+	}
+
+	const uint8_t *get_aligned_ptr() {
+		align();
+		return buffer + (bit_ofs >> 3);
+	}
+
+	int get_remaining_bytes() const {
+		return int((bit_len - bit_ofs) >> 3);
+	}
+
+	void skip_bytes(int p_bytes) {
+		bit_ofs += uint64_t(p_bytes) * 8;
+	}
+
+	int get_size() const {
+		return int((bit_ofs + 7) >> 3);
+	}
+
+	BitReader(const uint8_t *p_buffer, int p_len) {
+		buffer = p_buffer;
+		bit_len = uint64_t(p_len) * 8;
+	}
+};
+
+// Returns the number of components (1 to 4) of numeric scalars and vectors, or 0 for other types.
+int get_components(const Variant &p_value, real_t *r_components) {
+	switch (p_value.get_type()) {
+		case Variant::FLOAT: {
+			r_components[0] = p_value;
+			return 1;
+		}
+		case Variant::VECTOR2: {
+			const Vector2 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			return 2;
+		}
+		case Variant::VECTOR3: {
+			const Vector3 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			return 3;
+		}
+		case Variant::VECTOR4: {
+			const Vector4 v = p_value;
+			for (int i = 0; i < 4; i++) {
+				r_components[i] = v[i];
+			}
+			return 4;
+		}
+		default:
+			return 0;
+	}
+}
+
+Variant make_from_components(int p_count, const real_t *p_components) {
+	switch (p_count) {
+		case 1:
+			return p_components[0];
+		case 2:
+			return Vector2(p_components[0], p_components[1]);
+		case 3:
+			return Vector3(p_components[0], p_components[1], p_components[2]);
+		default:
+			return Vector4(p_components[0], p_components[1], p_components[2], p_components[3]);
+	}
+}
+
+uint64_t quantize(real_t p_value, real_t p_min, real_t p_max, int p_bits) {
+	const double steps = double((uint64_t(1) << p_bits) - 1);
+	const double ratio = (CLAMP(p_value, p_min, p_max) - p_min) / double(p_max - p_min);
+	return uint64_t(Math::round(ratio * steps));
+}
+
+real_t dequantize(uint64_t p_value, real_t p_min, real_t p_max, int p_bits) {
+	const double steps = double((uint64_t(1) << p_bits) - 1);
+	return real_t(p_min + (p_max - p_min) * (double(p_value) / steps));
+}
+
+int get_bits(const SceneReplicationConfig::EncodingInfo &p_info) {
+	if (p_info.bits > 0) {
+		return p_info.bits;
+	}
+	switch (p_info.encoding) {
+		case SceneReplicationConfig::PROPERTY_ENCODING_BITS:
+			return 8;
+		case SceneReplicationConfig::PROPERTY_ENCODING_QUATERNION:
+			return 10;
+		default:
+			return 16;
+	}
+}
+
+} // namespace
+
+Error SceneReplicationSchema::encode(const LocalVector<SceneReplicationConfig::EncodingInfo> &p_encodings, const Variant **p_variants, int p_count, uint8_t *p_buffer, int &r_len) {
+	ERR_FAIL_COND_V(uint32_t(p_count) != p_encodings.size(), ERR_INVALID_PARAMETER);
+	r_len = 0;
+	BitWriter writer(p_buffer);
+	for (int i = 0; i < p_count; i++) {
+		const SceneReplicationConfig::EncodingInfo &info = p_encodings[i];
+		const Variant &value = *p_variants[i];
+		const int bits = get_bits(info);
+		switch (info.encoding) {
+			case SceneReplicationConfig::PROPERTY_ENCODING_VARIANT: {
+				int len = 0;
+				Error err = MultiplayerAPI::encode_and_compress_variant(value, writer.get_aligned_ptr(), len, false);
+				ERR_FAIL_COND_V(err != OK, err);
+				writer.skip_bytes(len);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_BOOL: {
+				ERR_FAIL_COND_V_MSG(value.get_type() != Variant::BOOL, ERR_INVALID_DATA, "Bool encoding requires a bool property.");
+				writer.write(value.operator bool() ? 1 : 0, 1);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_BITS: {
+				ERR_FAIL_COND_V_MSG(value.get_type() != Variant::INT, ERR_INVALID_DATA, "Bits encoding requires an int property.");
+				const int64_t v = value;
+				ERR_FAIL_COND_V_MSG(v < 0 || uint64_t(v) >= (uint64_t(1) << bits), ERR_INVALID_DATA, vformat("Value %d does not fit in %d bits.", v, bits));
+				writer.write(uint64_t(v), bits);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_VARINT: {
+				ERR_FAIL_COND_V_MSG(value.get_type() != Variant::INT, ERR_INVALID_DATA, "Varint encoding requires an int property.");
+				const int64_t v = value;
+				uint64_t zigzag = (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+				while (zigzag >= 0x80) {
+					writer.write((zigzag & 0x7F) | 0x80, 8);
+					zigzag >>= 7;
+				}
+				writer.write(zigzag, 8);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED:
+			case SceneReplicationConfig::PROPERTY_ENCODING_HALF: {
+				real_t components[4];
+				const int count = get_components(value, components);
+				ERR_FAIL_COND_V_MSG(count == 0, ERR_INVALID_DATA, vformat("%s encoding requires a float or vector property.", info.encoding == SceneReplicationConfig::PROPERTY_ENCODING_HALF ? "Half" : "Quantized"));
+				writer.write(count - 1, 2);
+				for (int j = 0; j < count; j++) {
+					if (info.encoding == SceneReplicationConfig::PROPERTY_ENCODING_HALF) {
+						writer.write(Math::make_half_float(components[j]), 16);
+					} else {
+						writer.write(quantize(components[j], info.min, info.max, bits), bits);
+					}
+				}
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_QUATERNION: {
+				ERR_FAIL_COND_V_MSG(value.get_type() != Variant::QUATERNION, ERR_INVALID_DATA, "Quaternion encoding requires a quaternion property.");
+				Quaternion q = value;
+				q = q.length_squared() > CMP_EPSILON ? q.normalized() : Quaternion();
+				// Smallest three: skip the largest component, which can be recomputed since the quaternion is normalized.
+				int largest = 0;
+				for (int j = 1; j < 4; j++) {
+					if (Math::abs(q[j]) > Math::abs(q[largest])) {
+						largest = j;
+					}
+				}
+				if (q[largest] < 0) {
+					q = -q;
+				}
+				writer.write(largest, 2);
+				for (int j = 0; j < 4; j++) {
+					if (j != largest) {
+						writer.write(quantize(q[j], -Math_SQRT12, Math_SQRT12, bits), bits);
+					}
+				}
+			} break;
+		}
+	}
+	r_len = writer.get_size();
+	return OK;
+}
+
+Error SceneReplicationSchema::decode(const LocalVector<SceneReplicationConfig::EncodingInfo> &p_encodings, Vector<Variant> &r_variants, const uint8_t *p_buffer, int p_len, int &r_len) {
+	ERR_FAIL_COND_V(uint32_t(r_variants.size()) != p_encodings.size(), ERR_INVALID_PARAMETER);
+	r_len = 0;
+	BitReader reader(p_buffer, p_len);
+	Variant *ptr = r_variants.ptrw();
+	for (uint32_t i = 0; i < p_encodings.size(); i++) {
+		const SceneReplicationConfig::EncodingInfo &info = p_encodings[i];
+		const int bits = get_bits(info);
+		switch (info.encoding) {
+			case SceneReplicationConfig::PROPERTY_ENCODING_VARIANT: {
+				const uint8_t *data = reader.get_aligned_ptr();
+				const int remaining = reader.get_remaining_bytes();
+				ERR_FAIL_COND_V_MSG(remaining <= 0, ERR_INVALID_DATA, "Invalid packet received. Size too small.");
+				int len = 0;
+				Error err = MultiplayerAPI::decode_and_decompress_variant(ptr[i], data, remaining, &len, false);
+				ERR_FAIL_COND_V_MSG(err != OK, err, "Invalid packet received. Unable to decode state variable.");
+				reader.skip_bytes(len);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_BOOL: {
+				ptr[i] = reader.read(1) != 0;
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_BITS: {
+				ptr[i] = int64_t(reader.read(bits));
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_VARINT: {
+				uint64_t zigzag = 0;
+				for (int shift = 0; shift < 64; shift += 7) {
+					const uint64_t byte = reader.read(8);
+					zigzag |= (byte & 0x7F) << shift;
+					if (!(byte & 0x80) || reader.overflow) {
+						break;
+					}
+				}
+				ptr[i] = int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED:
+			case SceneReplicationConfig::PROPERTY_ENCODING_HALF: {
+				const int count = int(reader.read(2)) + 1;
+				real_t components[4];
+				for (int j = 0; j < count; j++) {
+					if (info.encoding == SceneReplicationConfig::PROPERTY_ENCODING_HALF) {
+						components[j] = Math::half_to_float(uint16_t(reader.read(16)));
+					} else {
+						components[j] = dequantize(reader.read(bits), info.min, info.max, bits);
+					}
+				}
+				ptr[i] = make_from_components(count, components);
+			} break;
+			case SceneReplicationConfig::PROPERTY_ENCODING_QUATERNION: {
+				const int largest = int(reader.read(2));
+				Quaternion q;
+				real_t sum = 0;
+				for (int j = 0; j < 4; j++) {
+					if (j != largest) {
+						q[j] = dequantize(reader.read(bits), -Math_SQRT12, Math_SQRT12, bits);
+						sum += q[j] * q[j];
+					}
+				}
+				q[largest] = Math::sqrt(MAX(1 - sum, 0));
+				ptr[i] = q.normalized();
+			} break;
+		}
+		ERR_FAIL_COND_V_MSG(reader.overflow, ERR_INVALID_DATA, "Invalid packet received. Size too small.");
+	}
+	r_len = reader.get_size();
+	return OK;
+}
+
+void SceneReplicationSchema::encode_baseline_delta(const uint8_t *p_baseline, const uint8_t *p_state, int p_size, LocalVector<uint8_t> &r_delta) {
+	r_delta.clear();
+	int i = 0;
+	while (i < p_size) {
+		int copy = 0;
+		while (i < p_size && copy < 255 && p_state[i] == p_baseline[i]) {
+			copy++;
+			i++;
+		}
+		// Short matching runs are cheaper as literals than as a new token.
+		const int start = i;
+		int literal = 0;
+		while (i < p_size && literal < 255) {
+			if (p_state[i] == p_baseline[i] && (i + 2 >= p_size || (p_state[i + 1] == p_baseline[i + 1] && p_state[i + 2] == p_baseline[i + 2]))) {
+				break;
+			}
+			literal++;
+			i++;
+		}
+		r_delta.push_back(copy);
+		r_delta.push_back(literal);
+		for (int j = 0; j < literal; j++) {
+			r_delta.push_back(p_state[start + j]);
+		}
+	}
+}
+
+Error SceneReplicationSchema::apply_baseline_delta(const uint8_t *p_baseline, int p_baseline_size, const uint8_t *p_delta, int p_delta_size, LocalVector<uint8_t> &r_state) {
+	r_state.resize(p_baseline_size);
+	int out = 0;
+	int ofs = 0;
+	while (ofs < p_delta_size) {
+		ERR_FAIL_COND_V(ofs + 2 > p_delta_size, ERR_INVALID_DATA);
+		const int copy = p_delta[ofs];
+		const int literal = p_delta[ofs + 1];
+		ofs += 2;
+		ERR_FAIL_COND_V(out + copy + literal > p_baseline_size || ofs + literal > p_delta_size, ERR_INVALID_DATA);
+		if (copy) {
+			memcpy(&r_state[out], &p_baseline[out], copy);
+			out += copy;
+		}
+		if (literal) {
+			memcpy(&r_state[out], &p_delta[ofs], literal);
+			out += literal;
+			ofs += literal;
+		}
+	}
+	ERR_FAIL_COND_V(out != p_baseline_size, ERR_INVALID_DATA);
+	return OK;
+}
@@ -0,0 +1,49 @@
+/**************************************************************************/
+/*  scene_replication_schema.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SCENE_REPLICATION_SCHEMA_H
+#define SCENE_REPLICATION_SCHEMA_H
+
+#include "scene_replication_config.h"
+
+// Bit-packed encoding of replicated states, driven by the per-property encodings of a SceneReplicationConfig.
+// Unlike MultiplayerAPI::encode_and_compress_variants, no type header is written for custom encodings,
+// so both ends must use the same configuration.
+class SceneReplicationSchema {
+public:
+	static Error encode(const LocalVector<SceneReplicationConfig::EncodingInfo> &p_encodings, const Variant **p_variants, int p_count, uint8_t *p_buffer, int &r_len);
+	static Error decode(const LocalVector<SceneReplicationConfig::EncodingInfo> &p_encodings, Vector<Variant> &r_variants, const uint8_t *p_buffer, int p_len, int &r_len);
+
+	// Encodes p_state as runs of bytes copied from p_baseline and literal bytes. Both must have the same size.
+	static void encode_baseline_delta(const uint8_t *p_baseline, const uint8_t *p_state, int p_size, LocalVector<uint8_t> &r_delta);
+	static Error apply_baseline_delta(const uint8_t *p_baseline, int p_baseline_size, const uint8_t *p_delta, int p_delta_size, LocalVector<uint8_t> &r_state);
+};
+
+#endif // SCENE_REPLICATION_SCHEMA_H
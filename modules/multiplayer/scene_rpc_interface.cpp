@@ -43,6 +43,8 @@
 // - `NetworkNodeIdCompression` in the next 2 bits.
 // - `NetworkNameIdCompression` in the next 1 bit.
 // - `byte_only_or_no_args` in the next 1 bit.
+// When the node id compression is `NETWORK_NODE_ID_COMPRESSION_BATCH`, the packet is instead a batch of RPCs,
+// each one encoded as its size (16 bits) followed by a regular RPC packet (including its own meta).
 #define NODE_ID_COMPRESSION_SHIFT SceneMultiplayer::CMD_FLAG_0_SHIFT
 #define NAME_ID_COMPRESSION_SHIFT SceneMultiplayer::CMD_FLAG_2_SHIFT
 #define BYTE_ONLY_OR_NO_ARGS_SHIFT SceneMultiplayer::CMD_FLAG_3_SHIFT
@@ -164,6 +166,11 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	int node_id_compression = (p_packet[0] & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT;
 	int name_id_compression = (p_packet[0] & NAME_ID_COMPRESSION_FLAG) >> NAME_ID_COMPRESSION_SHIFT;
 
+	if (node_id_compression == NETWORK_NODE_ID_COMPRESSION_BATCH) {
+		_process_batch(p_from, p_packet, p_packet_len);
+		return;
+	}
+
 	switch (node_id_compression) {
 		case NETWORK_NODE_ID_COMPRESSION_8:
 			packet_min_size += 1;
@@ -228,6 +235,28 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	_process_rpc(node, name_id, p_from, p_packet, packet_len, packet_min_size);
 }
 
+void SceneRPCInterface::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	// Validate the whole batch first, so a malformed one doesn't get partially executed.
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+		ERR_FAIL_COND_MSG(ofs + 2 > p_packet_len, "Invalid RPC batch received. Size too small.");
+		const int len = decode_uint16(&p_packet[ofs]);
+		ofs += 2;
+		ERR_FAIL_COND_MSG(len < 1 || ofs + len > p_packet_len, "Invalid RPC batch received. Size too small.");
+		const uint8_t meta = p_packet[ofs];
+		ERR_FAIL_COND_MSG((meta & SceneMultiplayer::CMD_MASK) != SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL, "Invalid RPC batch received. Only RPCs can be batched.");
+		ERR_FAIL_COND_MSG(((meta & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT) == NETWORK_NODE_ID_COMPRESSION_BATCH, "Invalid RPC batch received. Batches cannot be nested.");
+		ofs += len;
+	}
+	ofs = 1;
+	while (ofs < p_packet_len) {
+		const int len = decode_uint16(&p_packet[ofs]);
+		ofs += 2;
+		process_rpc(p_from, &p_packet[ofs], len);
+		ofs += len;
+	}
+}
+
 void SceneRPCInterface::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset) {
 	ERR_FAIL_COND_MSG(p_offset > p_packet_len, "Invalid packet received. Size too small.");
 
@@ -413,7 +442,7 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 	}
 
 	ERR_FAIL_COND(command_type > 7);
-	ERR_FAIL_COND(node_id_compression > 3);
+	ERR_FAIL_COND(node_id_compression > 2);
 	ERR_FAIL_COND(name_id_compression > 1);
 
 #ifdef DEBUG_ENABLED
@@ -429,7 +458,7 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 
 	if (has_all_peers) {
 		for (const int P : targets) {
-			multiplayer->send_command(P, packet_cache.ptr(), ofs);
+			_send_command(P, p_config, packet_cache.ptr(), ofs);
 		}
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
@@ -449,16 +478,160 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 			if (confirmed) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc_id, &(packet_cache.write[1]));
-				multiplayer->send_command(P, packet_cache.ptr(), ofs);
+				_send_command(P, p_config, packet_cache.ptr(), ofs);
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				multiplayer->send_command(P, packet_cache.ptr(), ofs + path_len);
+				_send_command(P, p_config, packet_cache.ptr(), ofs + path_len);
 			}
 		}
 	}
 }
 
+void SceneRPCInterface::_send_command(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len) {
+	rpc_packets++;
+	if (!batching) {
+		_send_now(p_to, p_packet, p_packet_len);
+		return;
+	}
+
+	// Find (or create) the batch for this peer, channel, and transfer mode.
+	LocalVector<RPCBatch> &peer_batches = batches[p_to];
+	RPCBatch *batch = nullptr;
+	for (RPCBatch &B : peer_batches) {
+		if (B.channel == p_config.channel && B.transfer_mode == p_config.transfer_mode) {
+			batch = &B;
+			break;
+		}
+	}
+	if (!batch) {
+		peer_batches.push_back(RPCBatch());
+		batch = &peer_batches[peer_batches.size() - 1];
+		batch->channel = p_config.channel;
+		batch->transfer_mode = p_config.transfer_mode;
+	}
+
+	const int entry_size = 2 + p_packet_len;
+	if (batch->count && (int)batch->buffer.size() + entry_size > batch_mtu) {
+		_flush_batch(p_to, *batch);
+	}
+	if (1 + entry_size > batch_mtu) {
+		// Too big to fit in a batch, send it right away (after the pending ones, to preserve ordering).
+		_send_now(p_to, p_packet, p_packet_len);
+		return;
+	}
+	if (batch->buffer.is_empty()) {
+		batch->buffer.push_back(SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL | (NETWORK_NODE_ID_COMPRESSION_BATCH << NODE_ID_COMPRESSION_SHIFT));
+	}
+	const uint32_t ofs = batch->buffer.size();
+	batch->buffer.resize(ofs + entry_size);
+	encode_uint16(p_packet_len, &batch->buffer[ofs]);
+	memcpy(&batch->buffer[ofs + 2], p_packet, p_packet_len);
+	batch->count++;
+	rpc_batched++;
+}
+
+void SceneRPCInterface::_flush_batch(int p_to, RPCBatch &r_batch) {
+	if (r_batch.count == 0) {
+		return;
+	}
+	// We might be flushing before another command is sent, restore its transfer settings afterwards.
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	const int channel = peer->get_transfer_channel();
+	const MultiplayerPeer::TransferMode transfer_mode = peer->get_transfer_mode();
+	peer->set_transfer_channel(r_batch.channel);
+	peer->set_transfer_mode(r_batch.transfer_mode);
+	if (r_batch.count == 1) {
+		// A single RPC, no need for the batch header.
+		_send_now(p_to, &r_batch.buffer[3], r_batch.buffer.size() - 3);
+	} else {
+		_send_now(p_to, r_batch.buffer.ptr(), r_batch.buffer.size());
+		batch_packets++;
+		packets_saved += r_batch.count - 1;
+	}
+	r_batch.buffer.clear();
+	r_batch.count = 0;
+	peer->set_transfer_channel(channel);
+	peer->set_transfer_mode(transfer_mode);
+}
+
+void SceneRPCInterface::_send_now(int p_to, const uint8_t *p_packet, int p_packet_len) {
+	// Skip the flush SceneMultiplayer does before sending, our own ordering is already handled.
+	sending = true;
+	multiplayer->send_command(p_to, p_packet, p_packet_len);
+	sending = false;
+}
+
+void SceneRPCInterface::flush_batches(int p_to) {
+	if (sending || batches.is_empty()) {
+		return;
+	}
+	if (p_to <= 0) {
+		on_network_process(); // Broadcast, flush them all.
+		return;
+	}
+	LocalVector<RPCBatch> *peer_batches = batches.getptr(p_to);
+	if (peer_batches) {
+		for (RPCBatch &batch : *peer_batches) {
+			_flush_batch(p_to, batch);
+		}
+	}
+}
+
+void SceneRPCInterface::on_peer_change(int p_id, bool p_connected) {
+	if (!p_connected) {
+		batches.erase(p_id);
+	}
+}
+
+void SceneRPCInterface::on_reset() {
+	batches.clear();
+}
+
+void SceneRPCInterface::on_network_process() {
+	for (KeyValue<int, LocalVector<RPCBatch>> &E : batches) {
+		for (RPCBatch &batch : E.value) {
+			_flush_batch(E.key, batch);
+		}
+	}
+}
+
+void SceneRPCInterface::set_batching_enabled(bool p_enabled) {
+	if (batching && !p_enabled) {
+		on_network_process(); // Do not leave pending RPCs behind.
+	}
+	batching = p_enabled;
+}
+
+bool SceneRPCInterface::is_batching_enabled() const {
+	return batching;
+}
+
+void SceneRPCInterface::set_max_batch_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 128 || p_size > UINT16_MAX, "RPC batch maximum size must be between 128 and 65535 bytes.");
+	batch_mtu = p_size;
+}
+
+int SceneRPCInterface::get_max_batch_size() const {
+	return batch_mtu;
+}
+
+Dictionary SceneRPCInterface::get_stats() const {
+	Dictionary stats;
+	stats["rpc_packets"] = rpc_packets;
+	stats["rpc_batched"] = rpc_batched;
+	stats["batch_packets"] = batch_packets;
+	stats["packets_saved"] = packets_saved;
+	return stats;
+}
+
+void SceneRPCInterface::reset_stats() {
+	rpc_packets = 0;
+	rpc_batched = 0;
+	batch_packets = 0;
+	packets_saved = 0;
+}
+
 Error SceneRPCInterface::rpcp(Object *p_obj, int p_peer_id, const StringName &p_method, const Variant **p_arg, int p_argcount) {
 	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
 	ERR_FAIL_COND_V_MSG(!peer.is_valid(), ERR_UNCONFIGURED, "Trying to call an RPC while no multiplayer peer is active.");
@@ -32,6 +32,7 @@
 #define SCENE_RPC_INTERFACE_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/multiplayer_api.h"
 
 class SceneMultiplayer;
@@ -71,6 +72,7 @@ private:
 		NETWORK_NODE_ID_COMPRESSION_8 = 0,
 		NETWORK_NODE_ID_COMPRESSION_16,
 		NETWORK_NODE_ID_COMPRESSION_32,
+		NETWORK_NODE_ID_COMPRESSION_BATCH, // Not an actual compression, the packet contains multiple RPCs.
 	};
 
 	enum NetworkNameIdCompression {
@@ -78,6 +80,13 @@ private:
 		NETWORK_NAME_ID_COMPRESSION_16,
 	};
 
+	struct RPCBatch {
+		int channel = 0;
+		MultiplayerPeer::TransferMode transfer_mode = MultiplayerPeer::TRANSFER_MODE_RELIABLE;
+		LocalVector<uint8_t> buffer;
+		int count = 0;
+	};
+
 	SceneMultiplayer *multiplayer = nullptr;
 	SceneCacheInterface *multiplayer_cache = nullptr;
 	SceneReplicationInterface *multiplayer_replicator = nullptr;
@@ -86,6 +95,18 @@ private:
 
 	HashMap<ObjectID, RPCConfigCache> rpc_cache;
 
+	// Outgoing RPC batches, by target peer.
+	bool batching = false;
+	bool sending = false;
+	int batch_mtu = 1350;
+	HashMap<int, LocalVector<RPCBatch>> batches;
+
+	// Stats.
+	uint64_t rpc_packets = 0;
+	uint64_t rpc_batched = 0;
+	uint64_t batch_packets = 0;
+	uint64_t packets_saved = 0;
+
 #ifdef DEBUG_ENABLED
 	_FORCE_INLINE_ void _profile_node_data(const String &p_what, ObjectID p_id, int p_size);
 #endif
@@ -94,6 +115,10 @@ protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 
 	void _send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const RPCConfig &p_config, const StringName &p_name, const Variant **p_arg, int p_argcount);
+	void _send_command(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len);
+	void _flush_batch(int p_to, RPCBatch &r_batch);
+	void _send_now(int p_to, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
 	Node *_process_get_node(int p_from, const uint8_t *p_packet, uint32_t p_node_target, int p_packet_len);
 
 	void _parse_rpc_config(const Variant &p_config, bool p_for_node, RPCConfigCache &r_cache);
@@ -104,6 +129,19 @@ public:
 	void process_rpc(int p_from, const uint8_t *p_packet, int p_packet_len);
 	String get_rpc_md5(const Object *p_obj);
 
+	void on_peer_change(int p_id, bool p_connected);
+	void on_reset();
+	void on_network_process();
+	void flush_batches(int p_to);
+
+	void set_batching_enabled(bool p_enabled);
+	bool is_batching_enabled() const;
+	void set_max_batch_size(int p_size);
+	int get_max_batch_size() const;
+
+	Dictionary get_stats() const;
+	void reset_stats();
+
 	SceneRPCInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache, SceneReplicationInterface *p_replicator) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
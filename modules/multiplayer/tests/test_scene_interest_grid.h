@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  test_scene_interest_grid.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_INTEREST_GRID_H
+#define TEST_SCENE_INTEREST_GRID_H
+
+#include "../scene_interest_grid.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneInterestGrid {
+
+TEST_CASE("[SceneInterestGrid] Query") {
+	SceneInterestGrid grid;
+	grid.set_cell_size(10);
+	const ObjectID near_id = ObjectID(uint64_t(1));
+	const ObjectID far_id = ObjectID(uint64_t(2));
+	const ObjectID big_id = ObjectID(uint64_t(3));
+	grid.update(near_id, Vector3(5, 0, 0), 0);
+	grid.update(far_id, Vector3(100, 0, 0), 0);
+	grid.update(big_id, Vector3(0, 60, 0), 45);
+	CHECK(grid.size() == 3);
+
+	HashSet<ObjectID> result;
+	grid.query(Vector3(), 20, result);
+	CHECK(result.size() == 2);
+	CHECK(result.has(near_id));
+	CHECK_MESSAGE(result.has(big_id), "The radius of registered objects extends their reach.");
+
+	result.clear();
+	grid.query(Vector3(), 1000, result);
+	CHECK(result.size() == 3);
+
+	result.clear();
+	grid.query(Vector3(-100, 0, 0), 20, result);
+	CHECK(result.is_empty());
+}
+
+TEST_CASE("[SceneInterestGrid] Update and remove") {
+	SceneInterestGrid grid;
+	grid.set_cell_size(10);
+	const ObjectID id = ObjectID(uint64_t(1));
+	grid.update(id, Vector3(), 0);
+
+	HashSet<ObjectID> result;
+	grid.query(Vector3(50, 50, 0), 5, result);
+	CHECK(result.is_empty());
+
+	// Move across several cells.
+	grid.update(id, Vector3(52, 48, 0), 0);
+	grid.query(Vector3(50, 50, 0), 5, result);
+	CHECK(result.has(id));
+
+	// Changing the cell size keeps the registered objects.
+	grid.set_cell_size(3);
+	result.clear();
+	grid.query(Vector3(50, 50, 0), 5, result);
+	CHECK(result.has(id));
+
+	grid.remove(id);
+	CHECK(grid.is_empty());
+	result.clear();
+	grid.query(Vector3(50, 50, 0), 5, result);
+	CHECK(result.is_empty());
+}
+
+} // namespace TestSceneInterestGrid
+
+#endif // TEST_SCENE_INTEREST_GRID_H
@@ -0,0 +1,536 @@
+/**************************************************************************/
+/*  test_scene_multiplayer.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_MULTIPLAYER_H
+#define TEST_SCENE_MULTIPLAYER_H
+
+#include "../multiplayer_synchronizer.h"
+#include "../scene_multiplayer.h"
+
+#include "core/io/marshalls.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneMultiplayer {
+
+// One side of a connection, keeps what is sent and delivers the packets queued with `receive()`.
+class TestMultiplayerPeer : public MultiplayerPeer {
+	GDCLASS(TestMultiplayerPeer, MultiplayerPeer);
+
+public:
+	struct Packet {
+		int peer = 0;
+		Vector<uint8_t> data;
+	};
+
+	List<Packet> incoming;
+	Packet current;
+	LocalVector<Packet> sent;
+	int target_peer = 0;
+	int unique_id = TARGET_PEER_SERVER;
+
+	void connect_peer(int p_id) { emit_signal(SNAME("peer_connected"), p_id); }
+
+	// Moves the packets sent to the other peer into its incoming queue.
+	void deliver(TestMultiplayerPeer *p_peer) {
+		LocalVector<Packet> kept;
+		for (const Packet &packet : sent) {
+			if (packet.peer == p_peer->unique_id) {
+				p_peer->receive(unique_id, packet.data);
+			} else {
+				kept.push_back(packet);
+			}
+		}
+		sent = kept;
+	}
+
+	void receive(int p_from, const Vector<uint8_t> &p_data) {
+		Packet packet;
+		packet.peer = p_from;
+		packet.data = p_data;
+		incoming.push_back(packet);
+	}
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.data.ptr();
+		r_buffer_size = current.data.size();
+		return OK;
+	}
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		Packet packet;
+		packet.peer = target_peer;
+		packet.data.resize(p_buffer_size);
+		memcpy(packet.data.ptrw(), p_buffer, p_buffer_size);
+		sent.push_back(packet);
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override { target_peer = p_peer_id; }
+	virtual int get_packet_peer() const override { return incoming.is_empty() ? 0 : incoming.front()->get().peer; }
+	virtual TransferMode get_packet_mode() const override { return TRANSFER_MODE_RELIABLE; }
+	virtual int get_packet_channel() const override { return 0; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return unique_id == TARGET_PEER_SERVER; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return unique_id; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+};
+
+class RPCTestNode : public Node {
+	GDCLASS(RPCTestNode, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("record", "value"), &RPCTestNode::record);
+	}
+
+public:
+	Vector<Variant> received;
+
+	void record(const Variant &p_value) { received.push_back(p_value); }
+};
+
+TEST_CASE("[SceneMultiplayer] RPC batching settings") {
+	Ref<SceneMultiplayer> multiplayer;
+	multiplayer.instantiate();
+	CHECK_FALSE(multiplayer->is_rpc_batching_enabled());
+	CHECK(multiplayer->get_max_rpc_batch_size() == 1350);
+
+	multiplayer->set_rpc_batching_enabled(true);
+	CHECK(multiplayer->is_rpc_batching_enabled());
+
+	multiplayer->set_max_rpc_batch_size(512);
+	CHECK(multiplayer->get_max_rpc_batch_size() == 512);
+
+	ERR_PRINT_OFF;
+	multiplayer->set_max_rpc_batch_size(16);
+	CHECK_MESSAGE(multiplayer->get_max_rpc_batch_size() == 512, "Batch sizes too small to be useful are rejected.");
+	multiplayer->set_max_rpc_batch_size(70000);
+	CHECK_MESSAGE(multiplayer->get_max_rpc_batch_size() == 512, "Batch sizes that cannot be encoded are rejected.");
+	ERR_PRINT_ON;
+
+	multiplayer->set_rpc_batching_enabled(false);
+	CHECK_FALSE(multiplayer->is_rpc_batching_enabled());
+}
+
+TEST_CASE("[SceneMultiplayer] RPC stats") {
+	Ref<SceneMultiplayer> multiplayer;
+	multiplayer.instantiate();
+	const Dictionary stats = multiplayer->get_rpc_stats();
+	CHECK(stats.has("rpc_packets"));
+	CHECK(stats.has("rpc_batched"));
+	CHECK(stats.has("batch_packets"));
+	CHECK(stats.has("packets_saved"));
+	CHECK(int64_t(stats["rpc_packets"]) == 0);
+	CHECK(int64_t(stats["packets_saved"]) == 0);
+
+	multiplayer->reset_rpc_stats();
+	CHECK(int64_t(multiplayer->get_rpc_stats()["batch_packets"]) == 0);
+}
+
+TEST_CASE("[SceneTree][SceneMultiplayer] Interest management") {
+	GDREGISTER_CLASS(TestMultiplayerPeer);
+	Ref<TestMultiplayerPeer> peer;
+	peer.instantiate();
+	Ref<SceneMultiplayer> multiplayer;
+	multiplayer.instantiate();
+	multiplayer->set_multiplayer_peer(peer);
+
+	Node *root = memnew(Node);
+	root->set_name("InterestTest");
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	SceneTree::get_singleton()->set_multiplayer(multiplayer, root->get_path());
+	peer->connect_peer(2);
+
+	Node2D *node = memnew(Node2D);
+	root->add_child(node);
+	MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	sync->set_replication_config(config);
+	sync->set_interest_enabled(true);
+	sync->set_interest_radius(1);
+	node->add_child(sync);
+
+	CHECK_FALSE_MESSAGE(sync->is_visible_to(2), "Without a viewpoint, the peer has no interest in anything.");
+	CHECK(multiplayer->set_peer_viewpoint(2, Vector3(), 10) == OK);
+	multiplayer->poll();
+	CHECK(sync->is_visible_to(2));
+
+	SUBCASE("Toggling interest before the next network frame") {
+		sync->set_interest_enabled(false);
+		sync->set_interest_enabled(true);
+		multiplayer->poll();
+		CHECK_MESSAGE(sync->is_visible_to(2), "The synchronizer should stay visible to peers it is relevant to.");
+	}
+
+	SUBCASE("Disabling then enabling interest over several frames") {
+		sync->set_interest_enabled(false);
+		multiplayer->poll();
+		CHECK(sync->is_visible_to(2));
+		sync->set_interest_enabled(true);
+		multiplayer->poll();
+		CHECK(sync->is_visible_to(2));
+	}
+
+	SUBCASE("Leaving the viewpoint") {
+		node->set_position(Vector2(100, 0));
+		multiplayer->poll();
+		CHECK_FALSE(sync->is_visible_to(2));
+	}
+
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), root->get_path());
+	memdelete(root);
+}
+
+static LocalVector<Vector<uint8_t>> _get_sent_commands(const Ref<TestMultiplayerPeer> &p_peer, uint8_t p_command) {
+	LocalVector<Vector<uint8_t>> commands;
+	for (const TestMultiplayerPeer::Packet &packet : p_peer->sent) {
+		if ((packet.data[0] & SceneMultiplayer::CMD_MASK) == p_command) {
+			commands.push_back(packet.data);
+		}
+	}
+	return commands;
+}
+
+static bool _is_rpc_batch(const Vector<uint8_t> &p_packet) {
+	// Batches are marked with the otherwise unused node ID compression value.
+	return ((p_packet[0] >> SceneMultiplayer::CMD_FLAG_0_SHIFT) & 3) == 3;
+}
+
+TEST_CASE("[SceneTree][SceneMultiplayer] RPC batching") {
+	GDREGISTER_CLASS(TestMultiplayerPeer);
+	GDREGISTER_CLASS(RPCTestNode);
+
+	Ref<TestMultiplayerPeer> server_peer;
+	server_peer.instantiate();
+	Ref<TestMultiplayerPeer> client_peer;
+	client_peer.instantiate();
+	client_peer->unique_id = 2;
+	Ref<SceneMultiplayer> server;
+	server.instantiate();
+	server->set_multiplayer_peer(server_peer);
+	server->set_rpc_batching_enabled(true);
+	Ref<SceneMultiplayer> client;
+	client.instantiate();
+	client->set_multiplayer_peer(client_peer);
+
+	// Both sides live in the same tree, each one with its own branch.
+	Window *tree_root = SceneTree::get_singleton()->get_root();
+	Node *server_root = memnew(Node);
+	server_root->set_name("Server");
+	tree_root->add_child(server_root);
+	Node *client_root = memnew(Node);
+	client_root->set_name("Client");
+	tree_root->add_child(client_root);
+	SceneTree::get_singleton()->set_multiplayer(server, server_root->get_path());
+	SceneTree::get_singleton()->set_multiplayer(client, client_root->get_path());
+	server_peer->connect_peer(2);
+	client_peer->connect_peer(1);
+
+	Dictionary rpc_config;
+	rpc_config["rpc_mode"] = MultiplayerAPI::RPC_MODE_ANY_PEER;
+	RPCTestNode *sender = memnew(RPCTestNode);
+	sender->set_name("Target");
+	sender->rpc_config("record", rpc_config);
+	server_root->add_child(sender);
+	RPCTestNode *receiver = memnew(RPCTestNode);
+	receiver->set_name("Target");
+	receiver->rpc_config("record", rpc_config);
+	client_root->add_child(receiver);
+
+	SUBCASE("Multiple RPCs are sent as a single packet") {
+		CHECK(sender->rpc_id(2, "record", 1) == OK);
+		CHECK(sender->rpc_id(2, "record", 2) == OK);
+		CHECK(sender->rpc_id(2, "record", 3) == OK);
+		CHECK_MESSAGE(_get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL).is_empty(), "RPCs are held until the end of the network frame.");
+		server->poll();
+		const LocalVector<Vector<uint8_t>> rpcs = _get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+		REQUIRE(rpcs.size() == 1);
+		CHECK(_is_rpc_batch(rpcs[0]));
+		const Dictionary stats = server->get_rpc_stats();
+		CHECK(int64_t(stats["rpc_packets"]) == 3);
+		CHECK(int64_t(stats["batch_packets"]) == 1);
+		CHECK(int64_t(stats["packets_saved"]) == 2);
+
+		server_peer->deliver(client_peer.ptr());
+		client->poll();
+		CHECK(receiver->received == varray(1, 2, 3));
+	}
+
+	SUBCASE("A single RPC is sent as a regular RPC") {
+		CHECK(sender->rpc_id(2, "record", 1) == OK);
+		server->poll();
+		const LocalVector<Vector<uint8_t>> rpcs = _get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+		REQUIRE(rpcs.size() == 1);
+		CHECK_FALSE(_is_rpc_batch(rpcs[0]));
+		CHECK(int64_t(server->get_rpc_stats()["batch_packets"]) == 0);
+
+		server_peer->deliver(client_peer.ptr());
+		client->poll();
+		CHECK(receiver->received == varray(1));
+	}
+
+	SUBCASE("RPCs too big for a batch are sent right away, after the pending ones") {
+		server->set_max_rpc_batch_size(128);
+		PackedByteArray big;
+		big.resize(200);
+		big.fill(7);
+		CHECK(sender->rpc_id(2, "record", 1) == OK);
+		CHECK(sender->rpc_id(2, "record", big) == OK);
+		const LocalVector<Vector<uint8_t>> rpcs = _get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+		REQUIRE(rpcs.size() == 2);
+		CHECK_FALSE(_is_rpc_batch(rpcs[0]));
+		CHECK_FALSE(_is_rpc_batch(rpcs[1]));
+		CHECK(rpcs[1].size() > 128);
+
+		server_peer->deliver(client_peer.ptr());
+		client->poll();
+		CHECK(receiver->received == varray(1, big));
+	}
+
+	SUBCASE("Pending RPCs are sent before other commands") {
+		CHECK(sender->rpc_id(2, "record", 1) == OK);
+		CHECK(sender->rpc_id(2, "record", 2) == OK);
+		PackedByteArray bytes;
+		bytes.push_back(42);
+		CHECK(server->send_bytes(bytes, 2, MultiplayerPeer::TRANSFER_MODE_UNRELIABLE, 1) == OK);
+		REQUIRE(server_peer->sent.size() >= 2);
+		const Vector<uint8_t> &batch = server_peer->sent[server_peer->sent.size() - 2].data;
+		CHECK((batch[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+		CHECK(_is_rpc_batch(batch));
+		const Vector<uint8_t> &raw = server_peer->sent[server_peer->sent.size() - 1].data;
+		CHECK((raw[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_RAW);
+		CHECK_MESSAGE(server_peer->get_transfer_mode() == MultiplayerPeer::TRANSFER_MODE_UNRELIABLE, "The transfer settings of the command are restored after flushing.");
+		CHECK(server_peer->get_transfer_channel() == 1);
+
+		server->poll();
+		CHECK(_get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL).size() == 1);
+	}
+
+	SUBCASE("Malformed batches are rejected") {
+		CHECK(sender->rpc_id(2, "record", 1) == OK);
+		CHECK(sender->rpc_id(2, "record", 2) == OK);
+		server->poll();
+		const LocalVector<Vector<uint8_t>> rpcs = _get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+		REQUIRE(rpcs.size() == 1);
+		const Vector<uint8_t> batch = rpcs[0];
+		REQUIRE(_is_rpc_batch(batch));
+
+		// Drop the batch, only deliver the path cache.
+		for (uint32_t i = 0; i < server_peer->sent.size(); i++) {
+			if (server_peer->sent[i].data == batch) {
+				server_peer->sent.remove_at(i);
+				break;
+			}
+		}
+		server_peer->deliver(client_peer.ptr());
+
+		Vector<uint8_t> truncated = batch;
+		truncated.resize(batch.size() - 1);
+		client_peer->receive(1, truncated);
+
+		Vector<uint8_t> nested;
+		nested.resize(3 + batch.size());
+		nested.write[0] = batch[0];
+		encode_uint16(batch.size(), &nested.write[1]);
+		memcpy(&nested.write[3], batch.ptr(), batch.size());
+		client_peer->receive(1, nested);
+
+		ERR_PRINT_OFF;
+		client->poll();
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(receiver->received.is_empty(), "No RPC of a malformed batch should be called.");
+
+		client_peer->receive(1, batch);
+		client->poll();
+		CHECK(receiver->received == varray(1, 2));
+	}
+
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), server_root->get_path());
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), client_root->get_path());
+	memdelete(server_root);
+	memdelete(client_root);
+}
+
+// Returns the number of states in a sync packet sent with baseline compression.
+static int _count_sync_states(const Vector<uint8_t> &p_packet) {
+	int count = 0;
+	int ofs = 4;
+	while (ofs + 8 < p_packet.size()) {
+		uint32_t size = decode_uint32(&p_packet[ofs + 4]);
+		ofs += 8;
+		if (size & 0x80000000) {
+			size &= 0x7FFFFFFF;
+			ofs += 2;
+		}
+		ofs += size;
+		count++;
+	}
+	return count;
+}
+
+TEST_CASE("[SceneTree][SceneMultiplayer] Sync baseline acknowledgment") {
+	GDREGISTER_CLASS(TestMultiplayerPeer);
+
+	Ref<TestMultiplayerPeer> server_peer;
+	server_peer.instantiate();
+	Ref<TestMultiplayerPeer> client_peer;
+	client_peer.instantiate();
+	client_peer->unique_id = 2;
+	Ref<SceneMultiplayer> server;
+	server.instantiate();
+	server->set_multiplayer_peer(server_peer);
+	server->set_sync_baseline_compression_enabled(true);
+	server->set_max_sync_packet_size(128); // Split each frame over multiple packets.
+	Ref<SceneMultiplayer> client;
+	client.instantiate();
+	client->set_multiplayer_peer(client_peer);
+
+	Window *tree_root = SceneTree::get_singleton()->get_root();
+	Node *server_root = memnew(Node);
+	server_root->set_name("Server");
+	tree_root->add_child(server_root);
+	Node *client_root = memnew(Node);
+	client_root->set_name("Client");
+	tree_root->add_child(client_root);
+	SceneTree::get_singleton()->set_multiplayer(server, server_root->get_path());
+	SceneTree::get_singleton()->set_multiplayer(client, client_root->get_path());
+	server_peer->connect_peer(2);
+	client_peer->connect_peer(1);
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":position"));
+	const int count = 10;
+	for (int i = 0; i < count; i++) {
+		for (Node *root : { server_root, client_root }) {
+			Node2D *node = memnew(Node2D);
+			node->set_name(vformat("Body%d", i));
+			node->set_position(Vector2(i, 0));
+			root->add_child(node);
+			MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+			sync->set_replication_config(config);
+			node->add_child(sync);
+		}
+	}
+
+	// Confirm the synchronizer paths, then send the first frame of full states.
+	server->poll();
+	server_peer->deliver(client_peer.ptr());
+	client->poll();
+	client_peer->deliver(server_peer.ptr());
+	server->poll();
+	const LocalVector<Vector<uint8_t>> syncs = _get_sent_commands(server_peer, SceneMultiplayer::NETWORK_COMMAND_SYNC);
+	REQUIRE(syncs.size() >= 2);
+	const uint16_t time = decode_uint16(&syncs[0][1]);
+	int dropped = 0;
+	for (uint32_t i = 0; i < syncs.size(); i++) {
+		CHECK(syncs[i][3] == i);
+		if (i == syncs.size() - 1) {
+			dropped = _count_sync_states(syncs[i]); // Lost on the way.
+		} else {
+			client_peer->receive(1, syncs[i]);
+		}
+	}
+	REQUIRE(dropped > 0);
+	server_peer->sent.clear();
+	client->poll();
+
+	SUBCASE("Only the states of the received packets are acknowledged") {
+		LocalVector<Vector<uint8_t>> acks = _get_sent_commands(client_peer, SceneMultiplayer::NETWORK_COMMAND_SYNC);
+		REQUIRE(acks.size() == 1);
+		CHECK(acks[0].size() == 7);
+		CHECK(decode_uint16(&acks[0][1]) == time);
+		CHECK(decode_uint32(&acks[0][3]) == (1u << (syncs.size() - 1)) - 1);
+		client_peer->deliver(server_peer.ptr());
+
+		server->reset_replication_stats();
+		server->poll();
+		CHECK_MESSAGE(int(server->get_replication_stats()["sync_baseline_deltas"]) == count - dropped, "The states of the lost packet must be sent in full.");
+		server_peer->deliver(client_peer.ptr());
+		client->poll();
+		acks = _get_sent_commands(client_peer, SceneMultiplayer::NETWORK_COMMAND_SYNC);
+		REQUIRE(acks.size() == 1);
+		CHECK_MESSAGE(acks[0].size() == 7, "No full state should be requested.");
+	}
+
+	SUBCASE("States that could not be rebuilt are requested in full") {
+		// Acknowledge the whole frame, as if the lost packet was received.
+		Vector<uint8_t> ack;
+		ack.resize(7);
+		ack.write[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT) | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+		encode_uint16(time, &ack.write[1]);
+		encode_uint32(UINT32_MAX, &ack.write[3]);
+		client_peer->sent.clear();
+		server_peer->receive(2, ack);
+
+		server->reset_replication_stats();
+		server->poll();
+		CHECK(int(server->get_replication_stats()["sync_baseline_deltas"]) == count);
+		server_peer->deliver(client_peer.ptr());
+		client->poll();
+		LocalVector<Vector<uint8_t>> acks = _get_sent_commands(client_peer, SceneMultiplayer::NETWORK_COMMAND_SYNC);
+		REQUIRE(acks.size() == 1);
+		CHECK_MESSAGE(acks[0].size() == 7 + 4 * dropped, "The states without a baseline should be requested in full.");
+		client_peer->deliver(server_peer.ptr());
+
+		server->reset_replication_stats();
+		server->poll();
+		CHECK(int(server->get_replication_stats()["sync_baseline_deltas"]) == count - dropped);
+		server_peer->deliver(client_peer.ptr());
+		client->poll();
+		acks = _get_sent_commands(client_peer, SceneMultiplayer::NETWORK_COMMAND_SYNC);
+		REQUIRE(acks.size() == 1);
+		CHECK(acks[0].size() == 7);
+		client_peer->deliver(server_peer.ptr());
+
+		server->reset_replication_stats();
+		server->poll();
+		CHECK(int(server->get_replication_stats()["sync_baseline_deltas"]) == count);
+	}
+
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), server_root->get_path());
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), client_root->get_path());
+	memdelete(server_root);
+	memdelete(client_root);
+}
+
+} // namespace TestSceneMultiplayer
+
+#endif // TEST_SCENE_MULTIPLAYER_H
@@ -0,0 +1,172 @@
+/**************************************************************************/
+/*  test_scene_replication_schema.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_SCHEMA_H
+#define TEST_SCENE_REPLICATION_SCHEMA_H
+
+#include "../scene_replication_schema.h"
+
+#include "scene/main/multiplayer_api.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationSchema {
+
+static SceneReplicationConfig::EncodingInfo _make_encoding(SceneReplicationConfig::PropertyEncoding p_encoding, int p_bits = 0, real_t p_min = 0, real_t p_max = 1) {
+	SceneReplicationConfig::EncodingInfo info;
+	info.encoding = p_encoding;
+	info.bits = p_bits;
+	info.min = p_min;
+	info.max = p_max;
+	return info;
+}
+
+static Vector<Variant> _roundtrip(const LocalVector<SceneReplicationConfig::EncodingInfo> &p_encodings, const Vector<Variant> &p_values, int &r_size) {
+	Vector<const Variant *> ptrs;
+	for (int i = 0; i < p_values.size(); i++) {
+		ptrs.push_back(&p_values[i]);
+	}
+	Vector<Variant> out;
+	r_size = 0;
+	if (SceneReplicationSchema::encode(p_encodings, ptrs.ptrw(), ptrs.size(), nullptr, r_size) != OK) {
+		return out;
+	}
+	Vector<uint8_t> buffer;
+	buffer.resize(r_size);
+	int written = 0;
+	SceneReplicationSchema::encode(p_encodings, ptrs.ptrw(), ptrs.size(), buffer.ptrw(), written);
+	CHECK(written == r_size);
+
+	out.resize(p_values.size());
+	int consumed = 0;
+	CHECK(SceneReplicationSchema::decode(p_encodings, out, buffer.ptr(), buffer.size(), consumed) == OK);
+	CHECK(consumed == r_size);
+	return out;
+}
+
+TEST_CASE("[SceneReplicationSchema] Encoding roundtrip") {
+	LocalVector<SceneReplicationConfig::EncodingInfo> encodings;
+	Vector<Variant> values;
+
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_BOOL));
+	values.push_back(true);
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_BITS, 3));
+	values.push_back(5);
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_VARINT));
+	values.push_back(-300);
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_VARIANT));
+	values.push_back("generic");
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED, 12, -100, 100));
+	values.push_back(Vector3(-50, 0, 99.5));
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_HALF));
+	values.push_back(Vector2(1.5, -0.25));
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_QUATERNION));
+	const Quaternion rotation = Quaternion(Vector3(1, 2, 3).normalized(), 0.7);
+	values.push_back(rotation);
+
+	int size = 0;
+	Vector<Variant> out = _roundtrip(encodings, values, size);
+	REQUIRE(out.size() == values.size());
+
+	CHECK(out[0] == Variant(true));
+	CHECK(out[1] == Variant(5));
+	CHECK(out[2] == Variant(-300));
+	CHECK(out[3] == Variant("generic"));
+	const Vector3 position = out[4];
+	CHECK_MESSAGE(position.distance_to(Vector3(-50, 0, 99.5)) < 0.1, "Quantized values are within one step.");
+	CHECK(out[5] == Variant(Vector2(1.5, -0.25)));
+	const Quaternion decoded = out[6];
+	CHECK(Math::abs(decoded.dot(rotation)) > 0.999);
+
+	// No type headers, and fewer bytes per component than the generic encoding.
+	int generic_size = 0;
+	Vector<const Variant *> ptrs;
+	for (int i = 0; i < values.size(); i++) {
+		ptrs.push_back(&values[i]);
+	}
+	MultiplayerAPI::encode_and_compress_variants(ptrs.ptrw(), ptrs.size(), nullptr, generic_size);
+	CHECK(size < generic_size);
+}
+
+TEST_CASE("[SceneReplicationSchema] Invalid values") {
+	LocalVector<SceneReplicationConfig::EncodingInfo> encodings;
+	encodings.push_back(_make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_BITS, 2));
+	Variant value = 4;
+	const Variant *ptr = &value;
+	int size = 0;
+	ERR_PRINT_OFF;
+	CHECK(SceneReplicationSchema::encode(encodings, &ptr, 1, nullptr, size) == ERR_INVALID_DATA);
+	value = "not an int";
+	CHECK(SceneReplicationSchema::encode(encodings, &ptr, 1, nullptr, size) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+
+	// Truncated data.
+	Vector<Variant> out;
+	out.resize(1);
+	const uint8_t data = 0;
+	int consumed = 0;
+	encodings[0] = _make_encoding(SceneReplicationConfig::PROPERTY_ENCODING_QUATERNION);
+	ERR_PRINT_OFF;
+	CHECK(SceneReplicationSchema::decode(encodings, out, &data, 1, consumed) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneReplicationSchema] Baseline delta") {
+	uint8_t baseline[64];
+	uint8_t state[64];
+	for (int i = 0; i < 64; i++) {
+		baseline[i] = i;
+		state[i] = i;
+	}
+	LocalVector<uint8_t> delta;
+	LocalVector<uint8_t> rebuilt;
+
+	SceneReplicationSchema::encode_baseline_delta(baseline, state, 64, delta);
+	CHECK_MESSAGE(delta.size() == 2, "Unchanged states only need a single copy token.");
+	CHECK(SceneReplicationSchema::apply_baseline_delta(baseline, 64, delta.ptr(), delta.size(), rebuilt) == OK);
+	CHECK(memcmp(rebuilt.ptr(), state, 64) == 0);
+
+	state[10] = 200;
+	state[11] = 201;
+	state[63] = 0;
+	SceneReplicationSchema::encode_baseline_delta(baseline, state, 64, delta);
+	CHECK(delta.size() < 16);
+	CHECK(SceneReplicationSchema::apply_baseline_delta(baseline, 64, delta.ptr(), delta.size(), rebuilt) == OK);
+	CHECK(memcmp(rebuilt.ptr(), state, 64) == 0);
+
+	// Deltas for another baseline size are rejected.
+	ERR_PRINT_OFF;
+	CHECK(SceneReplicationSchema::apply_baseline_delta(baseline, 32, delta.ptr(), delta.size(), rebuilt) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestSceneReplicationSchema
+
+#endif // TEST_SCENE_REPLICATION_SCHEMA_H
@@ -158,35 +158,20 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
+	// Only consider the polygons in a region with compatible layers.
+	auto layers_filter = [&](uint32_t p_polygon) {
+		return (p_navigation_layers & polygons[p_polygon].owner->get_navigation_layers()) != 0;
+	};
+	NavPolygonBVH::ClosestFace begin_face;
+	if (polygons_bvh.get_closest_face(p_origin, begin_face, layers_filter)) {
+		begin_poly = &polygons[begin_face.polygon];
+		begin_point = begin_face.point;
+	}
+	NavPolygonBVH::ClosestFace end_face;
+	if (polygons_bvh.get_closest_face(p_destination, end_face, layers_filter)) {
+		end_poly = &polygons[end_face.polygon];
+		end_point = end_face.point;
 	}
 
 	// Check for trivial cases
@@ -687,21 +672,12 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+	NavPolygonBVH::ClosestFace closest;
+	if (polygons_bvh.get_closest_face(p_point, closest, [](uint32_t) { return true; })) {
+		result.point = closest.point;
+		result.normal = closest.face.get_plane().normal;
+		result.owner = polygons[closest.polygon].owner->get_self();
 	}
 
 	return result;
@@ -949,6 +925,8 @@ void NavMap::sync() {
 
 		_new_pm_polygon_count = polygons.size();
 
+		polygons_bvh.build(polygons);
+
 		// Group all edges per key.
 		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
 		for (gd::Polygon &poly : polygons) {
@@ -1071,48 +1049,23 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
+			// Pick the polygons closest to the start and end points, within the search radius.
+			// The search only keeps faces strictly closer than its initial distance, so the radius is checked afterwards to include faces right at it.
+			const real_t link_connection_radius_sqr = link_connection_radius * link_connection_radius;
 			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
 			Vector3 closest_start_point;
+			NavPolygonBVH::ClosestFace start_face;
+			if (polygons_bvh.get_closest_face(start, start_face, [](uint32_t) { return true; }) && start_face.distance_squared <= link_connection_radius_sqr) {
+				closest_start_polygon = &polygons[start_face.polygon];
+				closest_start_point = start_face.point;
+			}
 
 			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			NavPolygonBVH::ClosestFace end_face;
+			if (polygons_bvh.get_closest_face(end, end_face, [](uint32_t) { return true; }) && end_face.distance_squared <= link_connection_radius_sqr) {
+				closest_end_polygon = &polygons[end_face.polygon];
+				closest_end_point = end_face.point;
 			}
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
@@ -31,6 +31,7 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -84,6 +85,9 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Spatial index over the map polygons, used by closest point queries.
+	NavPolygonBVH polygons_bvh;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "core/templates/sort_array.h"
+
+static _FORCE_INLINE_ Vector3 _get_face_center(const Face3 &p_face) {
+	return (p_face.vertex[0] + p_face.vertex[1] + p_face.vertex[2]) / 3.0;
+}
+
+uint32_t NavPolygonBVH::_build_node(uint32_t p_from, uint32_t p_to, uint32_t p_depth) {
+	const uint32_t index = nodes.size();
+	nodes.push_back(Node());
+
+	AABB aabb = faces[p_from].face.get_aabb();
+	AABB centers(_get_face_center(faces[p_from].face), Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		aabb.merge_with(faces[i].face.get_aabb());
+		centers.expand_to(_get_face_center(faces[i].face));
+	}
+	nodes[index].aabb = aabb;
+
+	// Leaves are also forced before the traversal stack could overflow.
+	if (p_to - p_from <= LEAF_SIZE || p_depth + 2 >= MAX_DEPTH) {
+		nodes[index].first = p_from;
+		nodes[index].count = p_to - p_from;
+		return index;
+	}
+
+	// Median split along the longest axis of the face centers keeps the tree balanced.
+	const uint32_t middle = p_from + (p_to - p_from) / 2;
+	SortArray<Face, FaceAxisCompare> sorter;
+	sorter.compare.axis = centers.get_longest_axis_index();
+	sorter.nth_element(0, p_to - p_from, middle - p_from, faces.ptr() + p_from);
+
+	_build_node(p_from, middle, p_depth + 1);
+	const uint32_t right = _build_node(middle, p_to, p_depth + 1);
+	nodes[index].first = right;
+
+	return index;
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	uint32_t face_count = 0;
+	for (const gd::Polygon &p : p_polygons) {
+		if (p.points.size() > 2) {
+			face_count += p.points.size() - 2;
+		}
+	}
+	if (face_count == 0) {
+		return;
+	}
+
+	faces.reserve(face_count);
+	for (uint32_t polygon_index = 0; polygon_index < p_polygons.size(); polygon_index++) {
+		const gd::Polygon &p = p_polygons[polygon_index];
+		for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+			Face face;
+			face.face = Face3(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			face.polygon = polygon_index;
+			face.order = faces.size();
+			faces.push_back(face);
+		}
+	}
+
+	nodes.reserve(2 * (face_count / LEAF_SIZE + 1));
+	_build_node(0, faces.size(), 0);
+}
+
+void NavPolygonBVH::clear() {
+	faces.clear();
+	nodes.clear();
+}
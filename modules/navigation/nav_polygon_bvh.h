@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+#include "core/math/face3.h"
+#include "core/templates/local_vector.h"
+
+/// Static bounding volume hierarchy over the triangle fans of the map polygons.
+/// Rebuilt by the map whenever its polygons are regenerated, and used to answer
+/// closest point queries without scanning every polygon.
+class NavPolygonBVH {
+public:
+	struct ClosestFace {
+		Vector3 point;
+		Face3 face;
+		uint32_t polygon = UINT32_MAX; // Index of the polygon in the map polygons.
+		real_t distance_squared = FLT_MAX; // Only faces closer than the initial value are considered.
+	};
+
+private:
+	static const uint32_t LEAF_SIZE = 4;
+	static const uint32_t MAX_DEPTH = 64;
+
+	struct Face {
+		Face3 face;
+		uint32_t polygon = 0;
+		uint32_t order = 0; // Position in the polygon/fan order, breaks ties the same way as a linear scan.
+	};
+
+	struct FaceAxisCompare {
+		int axis = 0;
+		_FORCE_INLINE_ bool operator()(const Face &p_a, const Face &p_b) const {
+			return (p_a.face.vertex[0][axis] + p_a.face.vertex[1][axis] + p_a.face.vertex[2][axis]) < (p_b.face.vertex[0][axis] + p_b.face.vertex[1][axis] + p_b.face.vertex[2][axis]);
+		}
+	};
+
+	struct Node {
+		AABB aabb;
+		uint32_t first = 0; // First face for leaves, right child for internal nodes (the left child is always the next node).
+		uint32_t count = 0; // Face count for leaves, zero for internal nodes.
+	};
+
+	LocalVector<Face> faces;
+	LocalVector<Node> nodes;
+
+	uint32_t _build_node(uint32_t p_from, uint32_t p_to, uint32_t p_depth);
+
+	static _FORCE_INLINE_ real_t _get_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+		real_t ds = 0.0;
+		for (int i = 0; i < 3; i++) {
+			const real_t min = p_aabb.position[i];
+			const real_t max = min + p_aabb.size[i];
+			if (p_point[i] < min) {
+				ds += (min - p_point[i]) * (min - p_point[i]);
+			} else if (p_point[i] > max) {
+				ds += (p_point[i] - max) * (p_point[i] - max);
+			}
+		}
+		return ds;
+	}
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	uint32_t get_face_count() const { return faces.size(); }
+
+	/// Finds the face closest to p_point among the polygons accepted by p_filter (called with the polygon index).
+	/// Returns true and fills r_result if a face closer than r_result.distance_squared was found.
+	template <typename F>
+	bool get_closest_face(const Vector3 &p_point, ClosestFace &r_result, const F &p_filter) const {
+		if (nodes.is_empty()) {
+			return false;
+		}
+
+		bool found = false;
+		uint32_t found_order = UINT32_MAX;
+
+		uint32_t stack[MAX_DEPTH];
+		uint32_t stack_size = 0;
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0) {
+			const uint32_t node_index = stack[--stack_size];
+			const Node &node = nodes[node_index];
+			if (_get_distance_squared(node.aabb, p_point) > r_result.distance_squared) {
+				continue;
+			}
+
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					const Face &f = faces[i];
+					if (!p_filter(f.polygon)) {
+						continue;
+					}
+					const Vector3 point = f.face.get_closest_point_to(p_point);
+					const real_t ds = point.distance_squared_to(p_point);
+					if (ds < r_result.distance_squared || (found && ds == r_result.distance_squared && f.order < found_order)) {
+						r_result.point = point;
+						r_result.face = f.face;
+						r_result.polygon = f.polygon;
+						r_result.distance_squared = ds;
+						found_order = f.order;
+						found = true;
+					}
+				}
+				continue;
+			}
+
+			// Visit the nearest child first so the search radius shrinks as early as possible.
+			const uint32_t left = node_index + 1;
+			const uint32_t right = node.first;
+			if (_get_distance_squared(nodes[left].aabb, p_point) <= _get_distance_squared(nodes[right].aabb, p_point)) {
+				stack[stack_size++] = right;
+				stack[stack_size++] = left;
+			} else {
+				stack[stack_size++] = left;
+				stack[stack_size++] = right;
+			}
+		}
+
+		return found;
+	}
+};
+
+#endif // NAV_POLYGON_BVH_H
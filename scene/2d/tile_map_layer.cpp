@@ -31,6 +31,9 @@
 #include "tile_map_layer.h"
 
 #include "core/io/marshalls.h"
+#include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "scene/2d/tile_map.h"
 #include "scene/gui/control.h"
 #include "scene/resources/world_2d.h"
@@ -674,22 +677,89 @@ void TileMapLayer::_rendering_draw_cell_debug(const RID &p_canvas_item, const Ve
 void TileMapLayer::_physics_update(bool p_force_cleanup) {
 	// Check if we should cleanup everything.
 	bool forced_cleanup = p_force_cleanup || !enabled || !collision_enabled || !is_inside_tree() || tile_set.is_null();
-	if (forced_cleanup) {
+
+	// Changing the quadrant size switches between per-cell and per-quadrant bodies, so start from scratch.
+	if (forced_cleanup || dirty.flags[DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE]) {
 		// Clean everything.
 		for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
 			_physics_clear_cell(kv.value);
+			// Detach the cell from its quadrant, otherwise the freed quadrant would be marked dirty again on the next update.
+			kv.value.physics_quadrant = Ref<PhysicsQuadrant>();
 		}
-	} else {
-		if (_physics_was_cleaned_up || dirty.flags[DIRTY_FLAGS_TILE_SET] || dirty.flags[DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES] || dirty.flags[DIRTY_FLAGS_LAYER_IN_TREE]) {
-			// Update all cells.
-			for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
-				_physics_update_cell(kv.value);
+		for (KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
+			_physics_clear_quadrant(**kv.value);
+			kv.value->cells.clear();
+		}
+		physics_quadrant_map.clear();
+	}
+
+	if (!forced_cleanup) {
+		bool update_all = _physics_was_cleaned_up || dirty.flags[DIRTY_FLAGS_TILE_SET] || dirty.flags[DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES] || dirty.flags[DIRTY_FLAGS_LAYER_IN_TREE] || dirty.flags[DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE];
+		if (physics_quadrant_size > 1) {
+			// List all physics quadrants to update, creating new ones if needed.
+			SelfList<PhysicsQuadrant>::List dirty_physics_quadrant_list;
+			if (update_all) {
+				// Update all cells.
+				for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
+					_physics_quadrants_update_cell(kv.value, dirty_physics_quadrant_list);
+				}
+			} else {
+				// Update dirty cells.
+				for (SelfList<CellData> *cell_data_list_element = dirty.cell_list.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
+					CellData &cell_data = *cell_data_list_element->self();
+					_physics_quadrants_update_cell(cell_data, dirty_physics_quadrant_list);
+				}
+			}
+
+			// Gather the polygons of the dirty quadrants only.
+			for (SelfList<PhysicsQuadrant> *quadrant_list_element = dirty_physics_quadrant_list.first(); quadrant_list_element;) {
+				SelfList<PhysicsQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
+
+				PhysicsQuadrant &physics_quadrant = *quadrant_list_element->self();
+				if (physics_quadrant.cells.first()) {
+					_physics_gather_quadrant(physics_quadrant);
+					physics_quadrants_to_build.push_back(&physics_quadrant);
+				} else {
+					// Free the quadrant.
+					_physics_clear_quadrant(physics_quadrant);
+					quadrant_list_element->remove_from_list();
+					// Only erase the map entry if it is this quadrant, not another one created at the same coords since.
+					HashMap<Vector2i, Ref<PhysicsQuadrant>>::Iterator physics_quadrant_map_element = physics_quadrant_map.find(physics_quadrant.quadrant_coords);
+					if (physics_quadrant_map_element && physics_quadrant_map_element->value.ptr() == &physics_quadrant) {
+						physics_quadrant_map.remove(physics_quadrant_map_element);
+					}
+				}
+
+				quadrant_list_element = next_quadrant_list_element;
+			}
+
+			// Merging polygons is the expensive part, and only touches the gathered data, so it can run on worker threads.
+			if (physics_quadrants_to_build.size() > 1) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMapLayer::_physics_merge_quadrant_polygons, nullptr, physics_quadrants_to_build.size(), -1, true, SNAME("TileMapLayerMergePhysicsQuadrants"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else if (physics_quadrants_to_build.size() == 1) {
+				_physics_merge_quadrant_polygons(0, nullptr);
 			}
+
+			// Physics servers are not thread-safe, create the bodies on the main thread.
+			for (PhysicsQuadrant *physics_quadrant : physics_quadrants_to_build) {
+				_physics_commit_quadrant(*physics_quadrant);
+			}
+
+			physics_quadrants_to_build.clear();
+			dirty_physics_quadrant_list.clear();
 		} else {
-			// Update dirty cells.
-			for (SelfList<CellData> *cell_data_list_element = dirty.cell_list.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
-				CellData &cell_data = *cell_data_list_element->self();
-				_physics_update_cell(cell_data);
+			if (update_all) {
+				// Update all cells.
+				for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
+					_physics_update_cell(kv.value);
+				}
+			} else {
+				// Update dirty cells.
+				for (SelfList<CellData> *cell_data_list_element = dirty.cell_list.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
+					CellData &cell_data = *cell_data_list_element->self();
+					_physics_update_cell(cell_data);
+				}
 			}
 		}
 	}
@@ -718,6 +788,14 @@ void TileMapLayer::_physics_notification(int p_what) {
 						}
 					}
 				}
+
+				for (KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
+					Transform2D xform(0, tile_set->map_to_local(kv.key * physics_quadrant_size));
+					xform = gl_transform * xform;
+					for (const PhysicsQuadrant::Body &quadrant_body : kv.value->bodies) {
+						ps->body_set_state(quadrant_body.body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+					}
+				}
 			}
 			break;
 		case NOTIFICATION_ENTER_TREE:
@@ -734,6 +812,12 @@ void TileMapLayer::_physics_notification(int p_what) {
 						}
 					}
 				}
+
+				for (KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
+					for (const PhysicsQuadrant::Body &quadrant_body : kv.value->bodies) {
+						ps->body_set_space(quadrant_body.body, space);
+					}
+				}
 			}
 	}
 }
@@ -865,6 +949,232 @@ void TileMapLayer::_physics_update_cell(CellData &r_cell_data) {
 	_physics_clear_cell(r_cell_data);
 }
 
+void TileMapLayer::_physics_quadrants_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list) {
+	// Check if the cell is valid.
+	bool is_valid = false;
+	if (tile_set->has_source(r_cell_data.cell.source_id)) {
+		TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(r_cell_data.cell.source_id));
+		is_valid = atlas_source && atlas_source->has_tile(r_cell_data.cell.get_atlas_coords()) && atlas_source->has_alternative_tile(r_cell_data.cell.get_atlas_coords(), r_cell_data.cell.alternative_tile);
+	}
+
+	// Mark the old quadrant as dirty (if it exists), and remove the cell from it.
+	if (r_cell_data.physics_quadrant.is_valid()) {
+		if (!r_cell_data.physics_quadrant->dirty_quadrant_list_element.in_list()) {
+			r_dirty_physics_quadrant_list.add(&r_cell_data.physics_quadrant->dirty_quadrant_list_element);
+		}
+		if (r_cell_data.physics_quadrant_list_element.in_list()) {
+			r_cell_data.physics_quadrant->cells.remove(&r_cell_data.physics_quadrant_list_element);
+		}
+		r_cell_data.physics_quadrant = Ref<PhysicsQuadrant>();
+	}
+
+	if (!is_valid) {
+		return;
+	}
+
+	// Rounding down, instead of simply rounding towards zero (truncating).
+	const Vector2i &coords = r_cell_data.coords;
+	Vector2i quadrant_coords = Vector2i(
+			coords.x > 0 ? coords.x / physics_quadrant_size : (coords.x - (physics_quadrant_size - 1)) / physics_quadrant_size,
+			coords.y > 0 ? coords.y / physics_quadrant_size : (coords.y - (physics_quadrant_size - 1)) / physics_quadrant_size);
+
+	Ref<PhysicsQuadrant> physics_quadrant;
+	if (physics_quadrant_map.has(quadrant_coords)) {
+		// Reuse existing physics quadrant.
+		physics_quadrant = physics_quadrant_map[quadrant_coords];
+	} else {
+		// Create a new physics quadrant.
+		physics_quadrant.instantiate();
+		physics_quadrant->quadrant_coords = quadrant_coords;
+		physics_quadrant_map[quadrant_coords] = physics_quadrant;
+	}
+
+	// Add the cell to its new quadrant.
+	r_cell_data.physics_quadrant = physics_quadrant;
+	physics_quadrant->cells.add(&r_cell_data.physics_quadrant_list_element);
+
+	// Add the new quadrant to the dirty quadrant list.
+	if (!physics_quadrant->dirty_quadrant_list_element.in_list()) {
+		r_dirty_physics_quadrant_list.add(&physics_quadrant->dirty_quadrant_list_element);
+	}
+}
+
+void TileMapLayer::_physics_clear_quadrant(PhysicsQuadrant &r_physics_quadrant) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	// Clear bodies and the shapes they own.
+	for (PhysicsQuadrant::Body &quadrant_body : r_physics_quadrant.bodies) {
+		bodies_coords.erase(quadrant_body.body);
+		ps->free(quadrant_body.body);
+		for (const RID &shape : quadrant_body.shapes) {
+			ps->free(shape);
+		}
+	}
+	r_physics_quadrant.bodies.clear();
+}
+
+void TileMapLayer::_physics_gather_quadrant(PhysicsQuadrant &r_physics_quadrant) {
+	r_physics_quadrant.body_groups.clear();
+
+	// Sort the cells, so the generated shapes do not depend on the order cells were modified in.
+	r_physics_quadrant.cells.sort();
+
+	const Vector2 quadrant_pos = tile_set->map_to_local(r_physics_quadrant.quadrant_coords * physics_quadrant_size);
+
+	for (SelfList<CellData> *cell_data_list_element = r_physics_quadrant.cells.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
+		const CellData &cell_data = *cell_data_list_element->self();
+		const TileMapCell &c = cell_data.cell;
+
+		if (!tile_set->has_source(c.source_id)) {
+			continue;
+		}
+		TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(c.source_id));
+		if (!atlas_source || !atlas_source->has_tile(c.get_atlas_coords()) || !atlas_source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+			continue;
+		}
+
+		const TileData *tile_data;
+		if (cell_data.runtime_tile_data_cache) {
+			tile_data = cell_data.runtime_tile_data_cache;
+		} else {
+			tile_data = atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile);
+		}
+
+		// Transform flags.
+		bool flip_h = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
+		bool flip_v = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
+		bool transpose = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+
+		const Vector2 cell_offset = tile_set->map_to_local(cell_data.coords) - quadrant_pos;
+
+		for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < (uint32_t)tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+			int polygons_count = tile_data->get_collision_polygons_count(tile_set_physics_layer);
+			if (polygons_count == 0) {
+				continue;
+			}
+
+			Vector2 linear_velocity = tile_data->get_constant_linear_velocity(tile_set_physics_layer);
+			real_t angular_velocity = tile_data->get_constant_angular_velocity(tile_set_physics_layer);
+
+			PhysicsQuadrant::BodyGroup *body_group = nullptr;
+			for (PhysicsQuadrant::BodyGroup &E : r_physics_quadrant.body_groups) {
+				if (E.physics_layer == tile_set_physics_layer && E.linear_velocity == linear_velocity && E.angular_velocity == angular_velocity) {
+					body_group = &E;
+					break;
+				}
+			}
+			if (!body_group) {
+				r_physics_quadrant.body_groups.push_back(PhysicsQuadrant::BodyGroup());
+				body_group = &r_physics_quadrant.body_groups[r_physics_quadrant.body_groups.size() - 1];
+				body_group->physics_layer = tile_set_physics_layer;
+				body_group->linear_velocity = linear_velocity;
+				body_group->angular_velocity = angular_velocity;
+				body_group->first_coords = cell_data.coords;
+			}
+
+			for (int polygon_index = 0; polygon_index < polygons_count; polygon_index++) {
+				bool one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
+				float one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
+				int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+				for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
+					// Transformed shapes are lazily created by the TileData, so fetch them here rather than on worker threads.
+					Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index, flip_h, flip_v, transpose);
+					if (one_way_collision) {
+						// Merging one-way polygons would lose the edges they let bodies pass through, keep them as is.
+						PhysicsQuadrant::OneWayShape one_way_shape;
+						one_way_shape.shape = shape->get_rid();
+						one_way_shape.transform = Transform2D(0, cell_offset);
+						one_way_shape.margin = one_way_collision_margin;
+						body_group->one_way_shapes.push_back(one_way_shape);
+					} else {
+						Vector<Vector2> points = shape->get_points();
+						Vector2 *points_ptrw = points.ptrw();
+						for (int i = 0; i < points.size(); i++) {
+							points_ptrw[i] += cell_offset;
+						}
+						body_group->polygons.push_back(points);
+					}
+				}
+			}
+		}
+	}
+}
+
+void TileMapLayer::_physics_merge_quadrant_polygons(uint32_t p_index, void *p_userdata) {
+	PhysicsQuadrant *physics_quadrant = physics_quadrants_to_build[p_index];
+	for (PhysicsQuadrant::BodyGroup &body_group : physics_quadrant->body_groups) {
+		body_group.merged_polygons = Geometry2D::merge_and_decompose_polygons_in_convex(body_group.polygons);
+		body_group.polygons.clear();
+	}
+}
+
+void TileMapLayer::_physics_commit_quadrant(PhysicsQuadrant &r_physics_quadrant) {
+	Transform2D gl_transform = get_global_transform();
+	RID space = get_world_2d()->get_space();
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	// The whole quadrant is rebuilt, as merged shapes may span several cells.
+	_physics_clear_quadrant(r_physics_quadrant);
+
+	Transform2D xform(0, tile_set->map_to_local(r_physics_quadrant.quadrant_coords * physics_quadrant_size));
+	xform = gl_transform * xform;
+
+	// Create one body per group, with the merged polygons as shapes.
+	for (PhysicsQuadrant::BodyGroup &body_group : r_physics_quadrant.body_groups) {
+		Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(body_group.physics_layer);
+		uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(body_group.physics_layer);
+		uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(body_group.physics_layer);
+
+		PhysicsQuadrant::Body quadrant_body;
+		RID body = ps->body_create();
+		quadrant_body.body = body;
+		bodies_coords[body] = body_group.first_coords;
+
+		ps->body_set_mode(body, use_kinematic_bodies ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_set_space(body, space);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+
+		ps->body_attach_object_instance_id(body, tile_map_node ? tile_map_node->get_instance_id() : get_instance_id());
+		ps->body_set_collision_layer(body, physics_layer);
+		ps->body_set_collision_mask(body, physics_mask);
+		ps->body_set_pickable(body, false);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, body_group.linear_velocity);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, body_group.angular_velocity);
+
+		if (!physics_material.is_valid()) {
+			ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
+			ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
+		} else {
+			ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
+			ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
+		}
+
+		// Add the merged shapes.
+		int body_shape_index = 0;
+		for (Vector<Vector2> &polygon : body_group.merged_polygons) {
+			if (Geometry2D::is_polygon_clockwise(polygon)) { // Needs to be counter clockwise.
+				polygon.reverse();
+			}
+			RID shape = ps->convex_polygon_shape_create();
+			ps->shape_set_data(shape, polygon);
+			ps->body_add_shape(body, shape);
+			quadrant_body.shapes.push_back(shape);
+			body_shape_index++;
+		}
+
+		// Add the one-way shapes.
+		for (const PhysicsQuadrant::OneWayShape &one_way_shape : body_group.one_way_shapes) {
+			ps->body_add_shape(body, one_way_shape.shape, one_way_shape.transform);
+			ps->body_set_shape_as_one_way_collision(body, body_shape_index, true, one_way_shape.margin);
+			body_shape_index++;
+		}
+
+		r_physics_quadrant.bodies.push_back(quadrant_body);
+	}
+
+	r_physics_quadrant.body_groups.clear();
+}
+
 #ifdef DEBUG_ENABLED
 void TileMapLayer::_physics_draw_cell_debug(const RID &p_canvas_item, const Vector2 &p_quadrant_pos, const CellData &r_cell_data) {
 	// Draw the debug collision shapes.
@@ -900,6 +1210,44 @@ void TileMapLayer::_physics_draw_cell_debug(const RID &p_canvas_item, const Vect
 	Transform2D quadrant_to_local(0, p_quadrant_pos);
 	Transform2D global_to_quadrant = (get_global_transform() * quadrant_to_local).affine_inverse();
 
+	if (r_cell_data.physics_quadrant.is_valid()) {
+		// Merged quadrant bodies span several cells, so draw this cell's own collision polygons instead.
+		const TileMapCell &c = r_cell_data.cell;
+		if (!tile_set->has_source(c.source_id)) {
+			return;
+		}
+		TileSetSource *source = *tile_set->get_source(c.source_id);
+		if (!source->has_tile(c.get_atlas_coords()) || !source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+			return;
+		}
+		TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
+		if (!atlas_source) {
+			return;
+		}
+		const TileData *tile_data;
+		if (r_cell_data.runtime_tile_data_cache) {
+			tile_data = r_cell_data.runtime_tile_data_cache;
+		} else {
+			tile_data = atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile);
+		}
+
+		bool flip_h = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
+		bool flip_v = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
+		bool transpose = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+
+		rs->canvas_item_add_set_transform(p_canvas_item, Transform2D(0, tile_set->map_to_local(r_cell_data.coords) - p_quadrant_pos));
+		for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+			for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+				for (int shape_index = 0; shape_index < tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index); shape_index++) {
+					Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index, flip_h, flip_v, transpose);
+					rs->canvas_item_add_polygon(p_canvas_item, shape->get_points(), color);
+				}
+			}
+		}
+		rs->canvas_item_add_set_transform(p_canvas_item, Transform2D());
+		return;
+	}
+
 	for (RID body : r_cell_data.bodies) {
 		if (body.is_valid()) {
 			Transform2D body_to_quadrant = global_to_quadrant * Transform2D(ps->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM));
@@ -1637,6 +1985,84 @@ void TileMapLayer::_deferred_internal_update() {
 }
 
 void TileMapLayer::_internal_update(bool p_force_cleanup) {
+	// Layer-wide changes update every cell anyway, so they cannot be spread across frames.
+	bool use_budget = !p_force_cleanup && update_time_budget_usec > 0;
+	for (int i = 0; use_budget && i < DIRTY_FLAGS_MAX; i++) {
+		if (dirty.flags[i]) {
+			use_budget = false;
+		}
+	}
+
+	if (!use_budget) {
+		_flush_deferred_dirty_cells();
+		_internal_update_cells(p_force_cleanup);
+		pending_update = false;
+		set_process_internal(false);
+		return;
+	}
+
+	// Group the new dirty cells by rendering quadrant, so each batch rebuilds whole quadrants only once.
+	while (SelfList<CellData> *cell_data_list_element = dirty.cell_list.first()) {
+		const Vector2i &coords = cell_data_list_element->self()->coords;
+		Vector2i quadrant_coords = Vector2i(
+				coords.x > 0 ? coords.x / rendering_quadrant_size : (coords.x - (rendering_quadrant_size - 1)) / rendering_quadrant_size,
+				coords.y > 0 ? coords.y / rendering_quadrant_size : (coords.y - (rendering_quadrant_size - 1)) / rendering_quadrant_size);
+		SelfList<CellData>::List **deferred_cell_list = dirty.deferred_cell_lists.getptr(quadrant_coords);
+		if (!deferred_cell_list) {
+			deferred_cell_list = &dirty.deferred_cell_lists.insert(quadrant_coords, memnew(SelfList<CellData>::List))->value;
+		}
+		dirty.cell_list.remove(cell_data_list_element);
+		(*deferred_cell_list)->add(cell_data_list_element);
+	}
+
+	pending_update = false;
+
+	// When cells from previous frames are still waiting, the new ones wait for their turn in the next internal process.
+	if (!is_processing_internal()) {
+		_update_deferred_cells();
+	}
+}
+
+void TileMapLayer::_update_deferred_cells() {
+	// Update batches of quadrants, oldest first, until the time budget is exhausted.
+	uint64_t time_begin = OS::get_singleton()->get_ticks_usec();
+	while (!dirty.deferred_cell_lists.is_empty()) {
+		int batch_size = 0;
+		while (!dirty.deferred_cell_lists.is_empty() && batch_size < rendering_quadrant_size * rendering_quadrant_size) {
+			HashMap<Vector2i, SelfList<CellData>::List *>::Iterator E = dirty.deferred_cell_lists.begin();
+			while (SelfList<CellData> *cell_data_list_element = E->value->first()) {
+				E->value->remove(cell_data_list_element);
+				dirty.cell_list.add(cell_data_list_element);
+				batch_size++;
+			}
+			memdelete(E->value);
+			dirty.deferred_cell_lists.remove(E);
+		}
+
+		_internal_update_cells(false);
+
+		if (OS::get_singleton()->get_ticks_usec() - time_begin >= (uint64_t)update_time_budget_usec) {
+			break;
+		}
+	}
+
+	// Continue on the next frames. This can't use a deferred call, as the ones queued while the
+	// message queue is flushed also run in that flush, so everything would still be updated in one frame.
+	set_process_internal(!dirty.deferred_cell_lists.is_empty());
+}
+
+void TileMapLayer::_flush_deferred_dirty_cells() {
+	for (KeyValue<Vector2i, SelfList<CellData>::List *> &kv : dirty.deferred_cell_lists) {
+		while (SelfList<CellData> *cell_data_list_element = kv.value->first()) {
+			kv.value->remove(cell_data_list_element);
+			dirty.cell_list.add(cell_data_list_element);
+		}
+		memdelete(kv.value);
+	}
+	dirty.deferred_cell_lists.clear();
+}
+
+void TileMapLayer::_internal_update_cells(bool p_force_cleanup) {
 	// Find TileData that need a runtime modification.
 	// This may add cells to the dirty list if a runtime modification has been notified.
 	_build_runtime_update_tile_data(p_force_cleanup);
@@ -1674,8 +2100,6 @@ void TileMapLayer::_internal_update(bool p_force_cleanup) {
 
 	// Clear the dirty cells list.
 	dirty.cell_list.clear();
-
-	pending_update = false;
 }
 
 void TileMapLayer::_notification(int p_what) {
@@ -1711,6 +2135,11 @@ void TileMapLayer::_notification(int p_what) {
 			dirty.flags[DIRTY_FLAGS_LAYER_VISIBILITY] = true;
 			_queue_internal_update();
 		} break;
+
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			// Cells postponed by the update time budget.
+			_update_deferred_cells();
+		} break;
 	}
 
 	_rendering_notification(p_what);
@@ -1723,6 +2152,7 @@ void TileMapLayer::_bind_methods() {
 	// Generic cells manipulations and access.
 	ClassDB::bind_method(D_METHOD("set_cell", "coords", "source_id", "atlas_coords", "alternative_tile"), &TileMapLayer::set_cell, DEFVAL(TileSet::INVALID_SOURCE), DEFVAL(TileSetSource::INVALID_ATLAS_COORDS), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("erase_cell", "coords"), &TileMapLayer::erase_cell);
+	ClassDB::bind_method(D_METHOD("erase_region", "region"), &TileMapLayer::erase_region);
 	ClassDB::bind_method(D_METHOD("fix_invalid_tiles"), &TileMapLayer::fix_invalid_tiles);
 	ClassDB::bind_method(D_METHOD("clear"), &TileMapLayer::clear);
 
@@ -1750,6 +2180,9 @@ void TileMapLayer::_bind_methods() {
 	// --- Runtime ---
 	ClassDB::bind_method(D_METHOD("update_internals"), &TileMapLayer::update_internals);
 	ClassDB::bind_method(D_METHOD("notify_runtime_tile_data_update"), &TileMapLayer::notify_runtime_tile_data_update, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("set_update_time_budget_usec", "usec"), &TileMapLayer::set_update_time_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_update_time_budget_usec"), &TileMapLayer::get_update_time_budget_usec);
+	ClassDB::bind_method(D_METHOD("has_pending_updates"), &TileMapLayer::has_pending_updates);
 
 	// --- Shortcuts to methods defined in TileSet ---
 	ClassDB::bind_method(D_METHOD("map_pattern", "position_in_tilemap", "coords_in_pattern", "pattern"), &TileMapLayer::map_pattern);
@@ -1777,6 +2210,8 @@ void TileMapLayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_collision_enabled"), &TileMapLayer::is_collision_enabled);
 	ClassDB::bind_method(D_METHOD("set_use_kinematic_bodies", "use_kinematic_bodies"), &TileMapLayer::set_use_kinematic_bodies);
 	ClassDB::bind_method(D_METHOD("is_using_kinematic_bodies"), &TileMapLayer::is_using_kinematic_bodies);
+	ClassDB::bind_method(D_METHOD("set_physics_quadrant_size", "size"), &TileMapLayer::set_physics_quadrant_size);
+	ClassDB::bind_method(D_METHOD("get_physics_quadrant_size"), &TileMapLayer::get_physics_quadrant_size);
 	ClassDB::bind_method(D_METHOD("set_collision_visibility_mode", "visibility_mode"), &TileMapLayer::set_collision_visibility_mode);
 	ClassDB::bind_method(D_METHOD("get_collision_visibility_mode"), &TileMapLayer::get_collision_visibility_mode);
 
@@ -1794,12 +2229,14 @@ void TileMapLayer::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "tile_set", PROPERTY_HINT_RESOURCE_TYPE, "TileSet"), "set_tile_set", "get_tile_set");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_time_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater,suffix:µs"), "set_update_time_budget_usec", "get_update_time_budget_usec");
 	ADD_GROUP("Rendering", "");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "y_sort_origin"), "set_y_sort_origin", "get_y_sort_origin");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "rendering_quadrant_size"), "set_rendering_quadrant_size", "get_rendering_quadrant_size");
 	ADD_GROUP("Physics", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_enabled"), "set_collision_enabled", "is_collision_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_kinematic_bodies"), "set_use_kinematic_bodies", "is_using_kinematic_bodies");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_quadrant_size", PROPERTY_HINT_RANGE, "1,64,1,or_greater"), "set_physics_quadrant_size", "get_physics_quadrant_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_collision_visibility_mode", "get_collision_visibility_mode");
 	ADD_GROUP("Navigation", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_enabled"), "set_navigation_enabled", "is_navigation_enabled");
@@ -2296,6 +2733,23 @@ void TileMapLayer::erase_cell(const Vector2i &p_coords) {
 	set_cell(p_coords, TileSet::INVALID_SOURCE, TileSetSource::INVALID_ATLAS_COORDS, TileSetSource::INVALID_TILE_ALTERNATIVE);
 }
 
+void TileMapLayer::erase_region(const Rect2i &p_region) {
+	// Iterate over whichever is smaller, the region or the used cells.
+	if ((int64_t)p_region.size.x * p_region.size.y < (int64_t)tile_map_layer_data.size()) {
+		for (int y = p_region.position.y; y < p_region.get_end().y; y++) {
+			for (int x = p_region.position.x; x < p_region.get_end().x; x++) {
+				erase_cell(Vector2i(x, y));
+			}
+		}
+	} else {
+		for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
+			if (p_region.has_point(kv.key)) {
+				erase_cell(kv.key);
+			}
+		}
+	}
+}
+
 void TileMapLayer::fix_invalid_tiles() {
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot call fix_invalid_tiles() on a TileMapLayer without a valid TileSet.");
 
@@ -2581,7 +3035,24 @@ Vector2i TileMapLayer::get_coords_for_body_rid(RID p_physics_body) const {
 }
 
 void TileMapLayer::update_internals() {
-	_internal_update(false);
+	// Ignore the update time budget, everything must be up to date when this returns.
+	_flush_deferred_dirty_cells();
+	_internal_update_cells(false);
+	pending_update = false;
+	set_process_internal(false);
+}
+
+void TileMapLayer::set_update_time_budget_usec(int p_usec) {
+	ERR_FAIL_COND_MSG(p_usec < 0, "The update time budget cannot be negative.");
+	update_time_budget_usec = p_usec;
+}
+
+int TileMapLayer::get_update_time_budget_usec() const {
+	return update_time_budget_usec;
+}
+
+bool TileMapLayer::has_pending_updates() const {
+	return pending_update || dirty.cell_list.first() != nullptr || !dirty.deferred_cell_lists.is_empty();
 }
 
 void TileMapLayer::notify_runtime_tile_data_update() {
@@ -2850,6 +3321,22 @@ bool TileMapLayer::is_using_kinematic_bodies() const {
 	return use_kinematic_bodies;
 }
 
+void TileMapLayer::set_physics_quadrant_size(int p_size) {
+	if (physics_quadrant_size == p_size) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(p_size < 1, "Physics quadrant size cannot be smaller than 1.");
+	dirty.flags[DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE] = true;
+
+	physics_quadrant_size = p_size;
+	_queue_internal_update();
+	emit_signal(CoreStringName(changed));
+}
+
+int TileMapLayer::get_physics_quadrant_size() const {
+	return physics_quadrant_size;
+}
+
 void TileMapLayer::set_collision_visibility_mode(TileMapLayer::DebugVisibilityMode p_show_collision) {
 	if (collision_visibility_mode == p_show_collision) {
 		return;
@@ -97,6 +97,7 @@ public:
 class DebugQuadrant;
 #endif // DEBUG_ENABLED
 class RenderingQuadrant;
+class PhysicsQuadrant;
 
 struct CellData {
 	Vector2i coords;
@@ -112,6 +113,8 @@ struct CellData {
 
 	// Physics.
 	LocalVector<RID> bodies;
+	Ref<PhysicsQuadrant> physics_quadrant;
+	SelfList<CellData> physics_quadrant_list_element;
 
 	// Navigation.
 	LocalVector<RID> navigation_regions;
@@ -143,6 +146,7 @@ struct CellData {
 	CellData(const CellData &p_other) :
 			debug_quadrant_list_element(this),
 			rendering_quadrant_list_element(this),
+			physics_quadrant_list_element(this),
 			dirty_list_element(this) {
 		coords = p_other.coords;
 		cell = p_other.cell;
@@ -156,6 +160,7 @@ struct CellData {
 	CellData() :
 			debug_quadrant_list_element(this),
 			rendering_quadrant_list_element(this),
+			physics_quadrant_list_element(this),
 			dirty_list_element(this) {
 	}
 };
@@ -219,9 +224,53 @@ public:
 	}
 };
 
+class PhysicsQuadrant : public RefCounted {
+	GDCLASS(PhysicsQuadrant, RefCounted);
+
+public:
+	struct Body {
+		RID body;
+		LocalVector<RID> shapes; // Shapes created from merged polygons, owned by the quadrant.
+	};
+
+	struct OneWayShape {
+		RID shape;
+		Transform2D transform;
+		float margin = 0.0;
+	};
+
+	// Cells can only share a body if they use the same physics layer and constant velocities.
+	struct BodyGroup {
+		uint32_t physics_layer = 0;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2i first_coords;
+		Vector<Vector<Vector2>> polygons;
+		Vector<Vector<Vector2>> merged_polygons;
+		LocalVector<OneWayShape> one_way_shapes;
+	};
+
+	Vector2i quadrant_coords;
+	SelfList<CellData>::List cells;
+	LocalVector<Body> bodies;
+	LocalVector<BodyGroup> body_groups; // Gathered on the main thread, merged on worker threads, then turned into bodies.
+
+	SelfList<PhysicsQuadrant> dirty_quadrant_list_element;
+
+	PhysicsQuadrant() :
+			dirty_quadrant_list_element(this) {
+	}
+
+	~PhysicsQuadrant() {
+		cells.clear();
+	}
+};
+
 class TileMapLayer : public Node2D {
 	GDCLASS(TileMapLayer, Node2D);
 
+	friend class TestTileMapLayerInternalsAccessor;
+
 public:
 	enum HighlightMode {
 		HIGHLIGHT_MODE_DEFAULT,
@@ -252,6 +301,7 @@ public:
 		DIRTY_FLAGS_LAYER_RENDERING_QUADRANT_SIZE,
 		DIRTY_FLAGS_LAYER_COLLISION_ENABLED,
 		DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES,
+		DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE,
 		DIRTY_FLAGS_LAYER_COLLISION_VISIBILITY_MODE,
 		DIRTY_FLAGS_LAYER_NAVIGATION_ENABLED,
 		DIRTY_FLAGS_LAYER_NAVIGATION_MAP,
@@ -284,6 +334,7 @@ private:
 
 	bool collision_enabled = true;
 	bool use_kinematic_bodies = false;
+	int physics_quadrant_size = 1;
 	DebugVisibilityMode collision_visibility_mode = DEBUG_VISIBILITY_MODE_DEFAULT;
 
 	bool navigation_enabled = true;
@@ -292,6 +343,7 @@ private:
 
 	// Internal.
 	bool pending_update = false;
+	int update_time_budget_usec = 0;
 
 	// For keeping compatibility with TileMap.
 	TileMap *tile_map_node = nullptr;
@@ -301,6 +353,8 @@ private:
 	struct {
 		bool flags[DIRTY_FLAGS_MAX] = { false };
 		SelfList<CellData>::List cell_list;
+		// Dirty cells postponed to later frames when the update time budget is exceeded, grouped by rendering quadrant.
+		HashMap<Vector2i, SelfList<CellData>::List *> deferred_cell_lists;
 	} dirty;
 
 	// Rect cache.
@@ -338,11 +392,18 @@ private:
 #endif // DEBUG_ENABLED
 
 	HashMap<RID, Vector2i> bodies_coords; // Mapping for RID to coords.
+	HashMap<Vector2i, Ref<PhysicsQuadrant>> physics_quadrant_map;
 	bool _physics_was_cleaned_up = false;
 	void _physics_update(bool p_force_cleanup);
 	void _physics_notification(int p_what);
 	void _physics_clear_cell(CellData &r_cell_data);
 	void _physics_update_cell(CellData &r_cell_data);
+	void _physics_quadrants_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list);
+	void _physics_clear_quadrant(PhysicsQuadrant &r_physics_quadrant);
+	LocalVector<PhysicsQuadrant *> physics_quadrants_to_build;
+	void _physics_gather_quadrant(PhysicsQuadrant &r_physics_quadrant);
+	void _physics_merge_quadrant_polygons(uint32_t p_index, void *p_userdata);
+	void _physics_commit_quadrant(PhysicsQuadrant &r_physics_quadrant);
 #ifdef DEBUG_ENABLED
 	void _physics_draw_cell_debug(const RID &p_canvas_item, const Vector2 &p_quadrant_pos, const CellData &r_cell_data);
 #endif // DEBUG_ENABLED
@@ -378,6 +439,9 @@ private:
 	void _queue_internal_update();
 	void _deferred_internal_update();
 	void _internal_update(bool p_force_cleanup);
+	void _internal_update_cells(bool p_force_cleanup);
+	void _update_deferred_cells();
+	void _flush_deferred_dirty_cells();
 
 protected:
 	void _notification(int p_what);
@@ -417,6 +481,7 @@ public:
 	// Generic cells manipulations and data access.
 	void set_cell(const Vector2i &p_coords, int p_source_id = TileSet::INVALID_SOURCE, const Vector2i &p_atlas_coords = TileSetSource::INVALID_ATLAS_COORDS, int p_alternative_tile = 0);
 	void erase_cell(const Vector2i &p_coords);
+	void erase_region(const Rect2i &p_region);
 	void fix_invalid_tiles();
 	void clear();
 
@@ -444,6 +509,9 @@ public:
 	// --- Runtime ---
 	void update_internals();
 	void notify_runtime_tile_data_update();
+	void set_update_time_budget_usec(int p_usec);
+	int get_update_time_budget_usec() const;
+	bool has_pending_updates() const;
 	GDVIRTUAL1R(bool, _use_tile_data_runtime_update, Vector2i);
 	GDVIRTUAL2(_tile_data_runtime_update, Vector2i, TileData *);
 
@@ -479,6 +547,8 @@ public:
 	bool is_collision_enabled() const;
 	void set_use_kinematic_bodies(bool p_use_kinematic_bodies);
 	bool is_using_kinematic_bodies() const;
+	void set_physics_quadrant_size(int p_size);
+	int get_physics_quadrant_size() const;
 	void set_collision_visibility_mode(DebugVisibilityMode p_show_collision);
 	DebugVisibilityMode get_collision_visibility_mode() const;
 
@@ -50,6 +50,8 @@
 SceneState::InstantiationWarningNotify SceneState::instantiation_warn_notify = nullptr;
 #endif
 
+bool SceneState::instantiation_plans_enabled = true;
+
 bool SceneState::can_instantiate() const {
 	return nodes.size() > 0;
 }
@@ -125,6 +127,20 @@ Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, Ha
 }
 
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && instantiation_plans_enabled && !Engine::get_singleton()->is_editor_hint()) {
+		bool has_plan;
+		{
+			MutexLock lock(plan_mutex);
+			if (plan.status == InstantiationPlan::STATUS_NOT_COMPILED) {
+				plan.status = _compile_instantiation_plan() ? InstantiationPlan::STATUS_COMPILED : InstantiationPlan::STATUS_UNSUPPORTED;
+			}
+			has_plan = plan.status == InstantiationPlan::STATUS_COMPILED;
+		}
+		if (has_plan) {
+			return _instantiate_from_plan();
+		}
+	}
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -607,6 +623,236 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::_compile_instantiation_plan() const {
+	plan.nodes.clear();
+
+	// Node paths are only used to reference nodes inside of sub-scenes, which the plan does not handle.
+	if (nodes.is_empty() || base_scene_idx >= 0 || !node_paths.is_empty() || !editable_instances.is_empty()) {
+		return false;
+	}
+
+	const int nc = nodes.size();
+	const int sname_count = names.size();
+	const int prop_count = variants.size();
+	const bool create_missing_resources = ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled();
+
+	LocalVector<InstantiationPlan::NodePlan> plan_nodes;
+	plan_nodes.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodePlan &np = plan_nodes[i];
+
+		if (i == 0 ? n.parent != -1 : (n.parent < 0 || n.parent >= i)) {
+			return false;
+		}
+		if (n.owner >= i || n.name < 0 || n.name >= sname_count) {
+			return false;
+		}
+		np.name = names[n.name];
+		np.parent = n.parent;
+		np.owner = n.owner;
+		np.index = n.index;
+
+		if (n.instance >= 0) {
+			if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) {
+				return false;
+			}
+			int instance = n.instance & FLAG_MASK;
+			if (instance >= prop_count || Ref<PackedScene>(variants[instance]).is_null()) {
+				return false;
+			}
+			np.instance = instance;
+		} else {
+			// Nodes edited inside of a sub-scene have to be looked up by name.
+			if (n.type == TYPE_INSTANTIATED || n.type < 0 || n.type >= sname_count) {
+				return false;
+			}
+			np.type = names[n.type];
+			if (!ClassDB::class_exists(np.type) || !ClassDB::can_instantiate(np.type) || !ClassDB::is_parent_class(np.type, SNAME("Node"))) {
+				return false;
+			}
+			np.creation_func = ClassDB::get_native_creation_func(np.type);
+		}
+
+		for (const NodeData::Property &prop : n.properties) {
+			// Node references are resolved once the whole tree exists.
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name >= sname_count || prop.value < 0 || prop.value >= prop_count) {
+				return false;
+			}
+
+			np.properties.push_back(InstantiationPlan::Property());
+			InstantiationPlan::Property &pp = np.properties[np.properties.size() - 1];
+			pp.name = names[prop.name];
+			pp.value = prop.value;
+
+			const Variant &value = variants[prop.value];
+			switch (value.get_type()) {
+				case Variant::ARRAY:
+				case Variant::DICTIONARY: {
+					// May contain resources local to scene, or need converting to the typed collection of the property.
+					return false;
+				}
+				case Variant::OBJECT: {
+					Ref<Resource> res = value;
+					if (res.is_valid() && res->is_local_to_scene()) {
+						return false;
+					}
+					if (create_missing_resources && Object::cast_to<MissingResource>(value)) {
+						return false;
+					}
+				} break;
+				default: {
+				}
+			}
+
+			if (pp.name == CoreStringName(script)) {
+				if (n.instance >= 0) {
+					return false; // Needs the script state workaround of the generic path.
+				}
+				continue;
+			}
+
+			if (!np.creation_func) {
+				continue;
+			}
+
+			StringName setter_name = ClassDB::get_property_setter(np.type, pp.name);
+			if (setter_name == StringName()) {
+				continue;
+			}
+			MethodBind *setter = ClassDB::get_method(np.type, setter_name);
+			int index = ClassDB::get_property_index(np.type, pp.name);
+			int value_arg = index >= 0 ? 1 : 0;
+			if (!setter || setter->is_vararg() || setter->get_argument_count() != value_arg + 1) {
+				continue;
+			}
+
+			pp.setter = setter;
+			if (index >= 0) {
+				pp.index = index;
+			}
+			pp.validated = !setter->has_return() && value.get_type() != Variant::NIL && value.get_type() != Variant::OBJECT && setter->get_argument_type(value_arg) == value.get_type() && (index < 0 || setter->get_argument_type(0) == Variant::INT);
+		}
+
+		for (int group : n.groups) {
+			if (group < 0 || group >= sname_count) {
+				return false;
+			}
+			np.groups.push_back(names[group]);
+		}
+	}
+
+	for (const ConnectionData &c : connections) {
+		if (c.from < 0 || c.from >= nc || c.to < 0 || c.to >= nc || c.signal >= sname_count || c.method >= sname_count) {
+			return false;
+		}
+		for (int bind : c.binds) {
+			if (bind < 0 || bind >= prop_count) {
+				return false;
+			}
+		}
+	}
+
+	plan.nodes = plan_nodes;
+	return true;
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(plan_mutex);
+	plan.status = InstantiationPlan::STATUS_NOT_COMPILED;
+	plan.nodes.clear();
+}
+
+Node *SceneState::_instantiate_from_plan() const {
+	const int nc = plan.nodes.size();
+	const InstantiationPlan::NodePlan *plan_nodes = plan.nodes.ptr();
+	const Variant *props = variants.ptr();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	for (int i = 0; i < nc; i++) {
+		const InstantiationPlan::NodePlan &np = plan_nodes[i];
+
+		Node *node = nullptr;
+		if (np.instance >= 0) {
+			Ref<PackedScene> sdata = props[np.instance];
+			node = sdata->instantiate();
+		} else if (np.creation_func) {
+			node = static_cast<Node *>(np.creation_func());
+		} else {
+			node = Object::cast_to<Node>(ClassDB::instantiate(np.type));
+		}
+
+		if (!node) {
+			if (i > 0) {
+				memdelete(ret_nodes[0]);
+			}
+			ERR_FAIL_V_MSG(nullptr, vformat("Failed to instantiate node %s of scene \"%s\".", np.name, path));
+		}
+
+		for (const InstantiationPlan::Property &prop : np.properties) {
+			const Variant &value = props[prop.value];
+			if (!prop.setter || node->get_script_instance()) {
+				node->set(prop.name, value);
+				continue;
+			}
+
+			const Variant *args[2] = { &prop.index, &value };
+			const Variant **argptrs = prop.index.get_type() == Variant::NIL ? &args[1] : &args[0];
+			if (prop.validated) {
+				prop.setter->validated_call(node, argptrs, nullptr);
+			} else {
+				Callable::CallError ce;
+				prop.setter->call(node, argptrs, prop.index.get_type() == Variant::NIL ? 1 : 2, ce);
+			}
+		}
+
+		for (const StringName &group : np.groups) {
+			node->add_to_group(group, true);
+		}
+
+		if (i > 0) {
+			Node *parent = ret_nodes[np.parent];
+			parent->_add_child_nocheck(node, np.name);
+			if (np.index >= 0 && np.index < parent->get_child_count() - 1) {
+				parent->move_child(node, np.index);
+			}
+		} else {
+			node->_set_name_nocheck(np.name);
+		}
+
+		if (np.owner >= 0) {
+			node->_set_owner_nocheck(ret_nodes[np.owner]);
+			if (node->data.unique_name_in_owner) {
+				node->_acquire_unique_name_in_owner();
+			}
+		}
+
+		node->remove_meta("_edit_pinned_properties_");
+
+		ret_nodes[i] = node;
+	}
+
+	const StringName *snames = names.ptr();
+	for (const ConnectionData &c : connections) {
+		Callable callable(ret_nodes[c.to], snames[c.method]);
+		if (c.unbinds > 0) {
+			callable = callable.unbind(c.unbinds);
+		} else if (!c.binds.is_empty()) {
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++) {
+				argptrs[j] = &props[c.binds[j]];
+			}
+			callable = callable.bindp(argptrs, c.binds.size());
+		}
+
+		ret_nodes[c.from]->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags | CONNECT_INHERITED);
+	}
+
+	return ret_nodes[0];
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1215,6 +1461,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1270,6 +1517,8 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
 	ERR_FAIL_COND(p_packed_scene.is_null());
 
+	_clear_instantiation_plan();
+
 	for (const NodeData &nd : nodes) {
 		if (nd.instance >= 0) {
 			if (!(nd.instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
@@ -1383,6 +1632,10 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+void SceneState::set_instantiation_plans_enabled(bool p_enabled) {
+	instantiation_plans_enabled = p_enabled;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1425,6 +1678,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instantiation_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1883,21 +2138,26 @@ Vector<NodePath> SceneState::get_editable_instances() const {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiation_plan();
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiation_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
 
 int SceneState::add_node_path(const NodePath &p_path) {
+	_clear_instantiation_plan();
 	node_paths.push_back(p_path);
 	return (node_paths.size() - 1) | FLAG_ID_IS_PATH;
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_plan();
+
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1916,6 +2176,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_clear_instantiation_plan();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	if (p_deferred_node_path) {
@@ -1928,11 +2190,15 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 void SceneState::add_node_group(int p_node, int p_group) {
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_group, names.size());
+
+	_clear_instantiation_plan();
 	nodes.write[p_node].groups.push_back(p_group);
 }
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -1943,6 +2209,9 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	for (int i = 0; i < p_binds.size(); i++) {
 		ERR_FAIL_INDEX(p_binds[i], variants.size());
 	}
+
+	_clear_instantiation_plan();
+
 	ConnectionData c;
 	c.from = p_from;
 	c.to = p_to;
@@ -1955,10 +2224,13 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
+	_clear_instantiation_plan();
 	editable_instances.push_back(p_path);
 }
 
 bool SceneState::remove_group_references(const StringName &p_name) {
+	_clear_instantiation_plan();
+
 	bool edited = false;
 	for (NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -1973,6 +2245,8 @@ bool SceneState::remove_group_references(const StringName &p_name) {
 }
 
 bool SceneState::rename_group_references(const StringName &p_old_name, const StringName &p_new_name) {
+	_clear_instantiation_plan();
+
 	bool edited = false;
 	for (const NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -2056,6 +2330,7 @@ Error PackedScene::pack(Node *p_scene) {
 }
 
 void PackedScene::clear() {
+	clear_instance_pool();
 	state->clear();
 }
 
@@ -2077,6 +2352,8 @@ void PackedScene::reload_from_file() {
 	s->recreate_state();
 	// This has a side-effect to clear s->state
 	copy_from(s);
+	// Pooled instances were made from the previous version of the scene.
+	clear_instance_pool();
 	// Then, we copy the backed-up loaded_state to state
 	state->copy_from(loaded_state);
 }
@@ -2108,7 +2385,76 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+void PackedScene::set_instance_pool_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+	instance_pool_size = p_size;
+}
+
+int PackedScene::get_instance_pool_size() const {
+	return instance_pool_size;
+}
+
+Node *PackedScene::instantiate_pooled() {
+	{
+		MutexLock lock(instance_pool_mutex);
+		while (!instance_pool.is_empty()) {
+			ObjectID id = instance_pool[instance_pool.size() - 1];
+			instance_pool.resize(instance_pool.size() - 1);
+			// Skip instances that were freed or reparented while in the pool.
+			Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+			if (node && !node->get_parent() && !node->is_queued_for_deletion()) {
+				return node;
+			}
+		}
+	}
+
+	return instantiate();
+}
+
+void PackedScene::release_instance(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(!is_built_in() && p_node->get_scene_file_path() != get_path(), vformat("Node \"%s\" was not instantiated from \"%s\".", p_node->get_name(), get_path()));
+
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	{
+		MutexLock lock(instance_pool_mutex);
+		const ObjectID id = p_node->get_instance_id();
+		ERR_FAIL_COND_MSG(instance_pool.has(id), vformat("Node \"%s\" is already in the instance pool.", p_node->get_name()));
+		if ((int)instance_pool.size() < instance_pool_size) {
+			instance_pool.push_back(id);
+			return;
+		}
+	}
+
+	p_node->queue_free();
+}
+
+int PackedScene::get_pooled_instance_count() const {
+	MutexLock lock(instance_pool_mutex);
+	return instance_pool.size();
+}
+
+void PackedScene::clear_instance_pool() {
+	LocalVector<ObjectID> pooled;
+	{
+		MutexLock lock(instance_pool_mutex);
+		pooled = instance_pool;
+		instance_pool.clear();
+	}
+
+	for (const ObjectID &id : pooled) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (node && !node->get_parent()) {
+			memdelete(node);
+		}
+	}
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	clear_instance_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2117,6 +2463,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	clear_instance_pool();
 	state = Ref<SceneState>(memnew(SceneState));
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2145,11 +2492,18 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
+	ClassDB::bind_method(D_METHOD("set_instance_pool_size", "size"), &PackedScene::set_instance_pool_size);
+	ClassDB::bind_method(D_METHOD("get_instance_pool_size"), &PackedScene::get_instance_pool_size);
+	ClassDB::bind_method(D_METHOD("instantiate_pooled"), &PackedScene::instantiate_pooled);
+	ClassDB::bind_method(D_METHOD("release_instance", "node"), &PackedScene::release_instance);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &PackedScene::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("clear_instance_pool"), &PackedScene::clear_instance_pool);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "_bundled"), "_set_bundled_scene", "_get_bundled_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "instance_pool_size", PROPERTY_HINT_RANGE, "0,1024,1,or_greater", PROPERTY_USAGE_NONE), "set_instance_pool_size", "get_instance_pool_size");
 
 	BIND_ENUM_CONSTANT(GEN_EDIT_STATE_DISABLED);
 	BIND_ENUM_CONSTANT(GEN_EDIT_STATE_INSTANCE);
@@ -2160,3 +2514,7 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state = Ref<SceneState>(memnew(SceneState));
 }
+
+PackedScene::~PackedScene() {
+	clear_instance_pool();
+}
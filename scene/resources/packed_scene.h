@@ -32,6 +32,9 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +92,48 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Node data compiled down to what instantiating at runtime needs, with constructors and native
+	// setters resolved once instead of looked up by name for every instance. Only scenes without
+	// inheritance, node paths, placeholders, edited sub-scene nodes or per-instance resources qualify.
+	struct InstantiationPlan {
+		enum Status {
+			STATUS_NOT_COMPILED,
+			STATUS_COMPILED,
+			STATUS_UNSUPPORTED,
+		};
+
+		struct Property {
+			StringName name;
+			int value = 0;
+			MethodBind *setter = nullptr; // Only used while the node has no script, which could intercept the property.
+			Variant index; // First argument of indexed setters.
+			bool validated = false; // The value already has the argument type, so the setter can skip conversion.
+		};
+
+		struct NodePlan {
+			ClassDB::CreationFunc creation_func = nullptr;
+			StringName type;
+			StringName name;
+			int instance = -1;
+			int parent = -1;
+			int owner = -1;
+			int index = -1;
+			LocalVector<Property> properties;
+			LocalVector<StringName> groups;
+		};
+
+		Status status = STATUS_NOT_COMPILED;
+		LocalVector<NodePlan> nodes;
+	};
+
+	mutable InstantiationPlan plan;
+	mutable Mutex plan_mutex;
+	static bool instantiation_plans_enabled;
+
+	bool _compile_instantiation_plan() const;
+	void _clear_instantiation_plan();
+	Node *_instantiate_from_plan() const;
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -136,6 +181,7 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_instantiation_plans_enabled(bool p_enabled);
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -233,6 +279,10 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	int instance_pool_size = 0;
+	LocalVector<ObjectID> instance_pool;
+	mutable Mutex instance_pool_mutex;
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -256,6 +306,13 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	void set_instance_pool_size(int p_size);
+	int get_instance_pool_size() const;
+	Node *instantiate_pooled();
+	void release_instance(Node *p_node);
+	int get_pooled_instance_count() const;
+	void clear_instance_pool();
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -274,6 +331,7 @@ public:
 	Ref<SceneState> get_state() const;
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
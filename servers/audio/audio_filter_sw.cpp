@@ -30,6 +30,34 @@
 
 #include "audio_filter_sw.h"
 
+#include "servers/audio/audio_mix_kernels.h"
+
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+#include <emmintrin.h>
+
+static _ALWAYS_INLINE_ __m128 _pair(float p_left, float p_right) {
+	return _mm_setr_ps(p_left, p_right, 0.0f, 0.0f);
+}
+
+static _ALWAYS_INLINE_ void _unpair(__m128 p_pair, float &r_left, float &r_right) {
+	float lanes[4];
+	_mm_storeu_ps(lanes, p_pair);
+	r_left = lanes[0];
+	r_right = lanes[1];
+}
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+#include <arm_neon.h>
+
+static _ALWAYS_INLINE_ float32x2_t _pair(float p_left, float p_right) {
+	return vset_lane_f32(p_right, vdup_n_f32(p_left), 1);
+}
+
+static _ALWAYS_INLINE_ void _unpair(float32x2_t p_pair, float &r_left, float &r_right) {
+	r_left = vget_lane_f32(p_pair, 0);
+	r_right = vget_lane_f32(p_pair, 1);
+}
+#endif
+
 void AudioFilterSW::set_mode(Mode p_mode) {
 	mode = p_mode;
 }
@@ -258,3 +286,108 @@ void AudioFilterSW::Processor::process(float *p_samples, int p_amount, int p_str
 		}
 	}
 }
+
+void AudioFilterSW::Processor::process_stereo(Processor *p_left, Processor *p_right, AudioFrame *p_frames, int p_amount, bool p_interpolate) {
+	if (!p_left->filter || !p_right->filter) {
+		p_left->process(&p_frames->left, p_amount, 2, p_interpolate);
+		p_right->process(&p_frames->right, p_amount, 2, p_interpolate);
+		return;
+	}
+
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+	// Left and right are the two lower lanes, evaluated in the same order as process_one().
+	__m128 b0 = _pair(p_left->coeffs.b0, p_right->coeffs.b0);
+	__m128 b1 = _pair(p_left->coeffs.b1, p_right->coeffs.b1);
+	__m128 b2 = _pair(p_left->coeffs.b2, p_right->coeffs.b2);
+	__m128 a1 = _pair(p_left->coeffs.a1, p_right->coeffs.a1);
+	__m128 a2 = _pair(p_left->coeffs.a2, p_right->coeffs.a2);
+	const __m128 ib0 = _pair(p_left->incr_coeffs.b0, p_right->incr_coeffs.b0);
+	const __m128 ib1 = _pair(p_left->incr_coeffs.b1, p_right->incr_coeffs.b1);
+	const __m128 ib2 = _pair(p_left->incr_coeffs.b2, p_right->incr_coeffs.b2);
+	const __m128 ia1 = _pair(p_left->incr_coeffs.a1, p_right->incr_coeffs.a1);
+	const __m128 ia2 = _pair(p_left->incr_coeffs.a2, p_right->incr_coeffs.a2);
+	__m128 ha1 = _pair(p_left->ha1, p_right->ha1);
+	__m128 ha2 = _pair(p_left->ha2, p_right->ha2);
+	__m128 hb1 = _pair(p_left->hb1, p_right->hb1);
+	__m128 hb2 = _pair(p_left->hb2, p_right->hb2);
+
+	for (int i = 0; i < p_amount; i++) {
+		double *frame = (double *)&p_frames[i];
+		const __m128 pre = _mm_castpd_ps(_mm_load_sd(frame));
+		const __m128 sample = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pre, b0), _mm_mul_ps(hb1, b1)), _mm_mul_ps(hb2, b2)), _mm_mul_ps(ha1, a1)), _mm_mul_ps(ha2, a2));
+		_mm_store_sd(frame, _mm_castps_pd(sample));
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = pre;
+		ha1 = sample;
+
+		if (p_interpolate) {
+			b0 = _mm_add_ps(b0, ib0);
+			b1 = _mm_add_ps(b1, ib1);
+			b2 = _mm_add_ps(b2, ib2);
+			a1 = _mm_add_ps(a1, ia1);
+			a2 = _mm_add_ps(a2, ia2);
+		}
+	}
+
+	_unpair(b0, p_left->coeffs.b0, p_right->coeffs.b0);
+	_unpair(b1, p_left->coeffs.b1, p_right->coeffs.b1);
+	_unpair(b2, p_left->coeffs.b2, p_right->coeffs.b2);
+	_unpair(a1, p_left->coeffs.a1, p_right->coeffs.a1);
+	_unpair(a2, p_left->coeffs.a2, p_right->coeffs.a2);
+	_unpair(ha1, p_left->ha1, p_right->ha1);
+	_unpair(ha2, p_left->ha2, p_right->ha2);
+	_unpair(hb1, p_left->hb1, p_right->hb1);
+	_unpair(hb2, p_left->hb2, p_right->hb2);
+
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+	// Left and right are the two lanes, evaluated in the same order as process_one().
+	float32x2_t b0 = _pair(p_left->coeffs.b0, p_right->coeffs.b0);
+	float32x2_t b1 = _pair(p_left->coeffs.b1, p_right->coeffs.b1);
+	float32x2_t b2 = _pair(p_left->coeffs.b2, p_right->coeffs.b2);
+	float32x2_t a1 = _pair(p_left->coeffs.a1, p_right->coeffs.a1);
+	float32x2_t a2 = _pair(p_left->coeffs.a2, p_right->coeffs.a2);
+	const float32x2_t ib0 = _pair(p_left->incr_coeffs.b0, p_right->incr_coeffs.b0);
+	const float32x2_t ib1 = _pair(p_left->incr_coeffs.b1, p_right->incr_coeffs.b1);
+	const float32x2_t ib2 = _pair(p_left->incr_coeffs.b2, p_right->incr_coeffs.b2);
+	const float32x2_t ia1 = _pair(p_left->incr_coeffs.a1, p_right->incr_coeffs.a1);
+	const float32x2_t ia2 = _pair(p_left->incr_coeffs.a2, p_right->incr_coeffs.a2);
+	float32x2_t ha1 = _pair(p_left->ha1, p_right->ha1);
+	float32x2_t ha2 = _pair(p_left->ha2, p_right->ha2);
+	float32x2_t hb1 = _pair(p_left->hb1, p_right->hb1);
+	float32x2_t hb2 = _pair(p_left->hb2, p_right->hb2);
+
+	for (int i = 0; i < p_amount; i++) {
+		float *frame = p_frames[i].levels;
+		const float32x2_t pre = vld1_f32(frame);
+		const float32x2_t sample = vadd_f32(vadd_f32(vadd_f32(vadd_f32(vmul_f32(pre, b0), vmul_f32(hb1, b1)), vmul_f32(hb2, b2)), vmul_f32(ha1, a1)), vmul_f32(ha2, a2));
+		vst1_f32(frame, sample);
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = pre;
+		ha1 = sample;
+
+		if (p_interpolate) {
+			b0 = vadd_f32(b0, ib0);
+			b1 = vadd_f32(b1, ib1);
+			b2 = vadd_f32(b2, ib2);
+			a1 = vadd_f32(a1, ia1);
+			a2 = vadd_f32(a2, ia2);
+		}
+	}
+
+	_unpair(b0, p_left->coeffs.b0, p_right->coeffs.b0);
+	_unpair(b1, p_left->coeffs.b1, p_right->coeffs.b1);
+	_unpair(b2, p_left->coeffs.b2, p_right->coeffs.b2);
+	_unpair(a1, p_left->coeffs.a1, p_right->coeffs.a1);
+	_unpair(a2, p_left->coeffs.a2, p_right->coeffs.a2);
+	_unpair(ha1, p_left->ha1, p_right->ha1);
+	_unpair(ha2, p_left->ha2, p_right->ha2);
+	_unpair(hb1, p_left->hb1, p_right->hb1);
+	_unpair(hb2, p_left->hb2, p_right->hb2);
+
+#else
+	p_left->process(&p_frames->left, p_amount, 2, p_interpolate);
+	p_right->process(&p_frames->right, p_amount, 2, p_interpolate);
+#endif
+}
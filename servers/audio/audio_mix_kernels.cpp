@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  audio_mix_kernels.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_mix_kernels.h"
+
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+#include <emmintrin.h>
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+#include <arm_neon.h>
+#endif
+
+bool AudioMixKernels::has_simd() {
+#if defined(AUDIO_MIX_KERNELS_SSE2) || defined(AUDIO_MIX_KERNELS_NEON)
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AudioMixKernels::accumulate_scalar(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames, uint32_t p_from) {
+	for (uint32_t i = p_from; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+void AudioMixKernels::apply_ramp_scalar(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames, uint32_t p_from) {
+	for (uint32_t i = p_from; i < p_frames; i++) {
+		float lerp_param = (float)i / p_frames;
+		p_dst[i] = (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_src[i];
+	}
+}
+
+void AudioMixKernels::mix_ramp_scalar(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames, uint32_t p_from) {
+	for (uint32_t i = p_from; i < p_frames; i++) {
+		float lerp_param = (float)i / p_frames;
+		p_dst[i] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_src[i];
+	}
+}
+
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+
+// Each register holds two stereo frames: [left0, right0, left1, right1].
+
+void AudioMixKernels::accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames) {
+	uint32_t i = 0;
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].left;
+		_mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_loadu_ps(&p_src[i].left)));
+	}
+	accumulate_scalar(p_dst, p_src, p_frames, i);
+}
+
+// Volume for frames i and i + 1, computed in the same order as the scalar version.
+static _ALWAYS_INLINE_ __m128 _ramp_volume(__m128 p_index, __m128 p_length, __m128 p_vol_start, __m128 p_vol_final) {
+	const __m128 lerp_param = _mm_div_ps(p_index, p_length);
+	return _mm_add_ps(_mm_mul_ps(p_vol_final, lerp_param), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), lerp_param), p_vol_start));
+}
+
+void AudioMixKernels::apply_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	const __m128 vol_start = _mm_setr_ps(p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right);
+	const __m128 vol_final = _mm_setr_ps(p_vol_final.left, p_vol_final.right, p_vol_final.left, p_vol_final.right);
+	const __m128 length = _mm_set1_ps((float)p_frames);
+	const __m128 step = _mm_set1_ps(2.0f);
+	__m128 index = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+
+	uint32_t i = 0;
+	for (; i + 2 <= p_frames; i += 2) {
+		const __m128 vol = _ramp_volume(index, length, vol_start, vol_final);
+		_mm_storeu_ps(&p_dst[i].left, _mm_mul_ps(vol, _mm_loadu_ps(&p_src[i].left)));
+		index = _mm_add_ps(index, step);
+	}
+	apply_ramp_scalar(p_dst, p_src, p_vol_start, p_vol_final, p_frames, i);
+}
+
+void AudioMixKernels::mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	const __m128 vol_start = _mm_setr_ps(p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right);
+	const __m128 vol_final = _mm_setr_ps(p_vol_final.left, p_vol_final.right, p_vol_final.left, p_vol_final.right);
+	const __m128 length = _mm_set1_ps((float)p_frames);
+	const __m128 step = _mm_set1_ps(2.0f);
+	__m128 index = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+
+	uint32_t i = 0;
+	for (; i + 2 <= p_frames; i += 2) {
+		const __m128 vol = _ramp_volume(index, length, vol_start, vol_final);
+		float *dst = &p_dst[i].left;
+		_mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(vol, _mm_loadu_ps(&p_src[i].left))));
+		index = _mm_add_ps(index, step);
+	}
+	mix_ramp_scalar(p_dst, p_src, p_vol_start, p_vol_final, p_frames, i);
+}
+
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+
+// Each register holds two stereo frames: [left0, right0, left1, right1].
+
+void AudioMixKernels::accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames) {
+	uint32_t i = 0;
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].left;
+		vst1q_f32(dst, vaddq_f32(vld1q_f32(dst), vld1q_f32(&p_src[i].left)));
+	}
+	accumulate_scalar(p_dst, p_src, p_frames, i);
+}
+
+// Volume for frames i and i + 1, computed in the same order as the scalar version.
+// ARMv7 NEON has no vector division, so the lerp parameters are computed as scalars.
+static _ALWAYS_INLINE_ float32x4_t _ramp_volume(uint32_t p_index, uint32_t p_length, float32x4_t p_vol_start, float32x4_t p_vol_final) {
+	const float lerp_param_0 = (float)p_index / p_length;
+	const float lerp_param_1 = (float)(p_index + 1) / p_length;
+	const float32x4_t lerp_param = vcombine_f32(vdup_n_f32(lerp_param_0), vdup_n_f32(lerp_param_1));
+	return vaddq_f32(vmulq_f32(p_vol_final, lerp_param), vmulq_f32(vsubq_f32(vdupq_n_f32(1.0f), lerp_param), p_vol_start));
+}
+
+void AudioMixKernels::apply_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	const float32x4_t vol_start = vcombine_f32(vld1_f32(p_vol_start.levels), vld1_f32(p_vol_start.levels));
+	const float32x4_t vol_final = vcombine_f32(vld1_f32(p_vol_final.levels), vld1_f32(p_vol_final.levels));
+
+	uint32_t i = 0;
+	for (; i + 2 <= p_frames; i += 2) {
+		const float32x4_t vol = _ramp_volume(i, p_frames, vol_start, vol_final);
+		vst1q_f32(&p_dst[i].left, vmulq_f32(vol, vld1q_f32(&p_src[i].left)));
+	}
+	apply_ramp_scalar(p_dst, p_src, p_vol_start, p_vol_final, p_frames, i);
+}
+
+void AudioMixKernels::mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	const float32x4_t vol_start = vcombine_f32(vld1_f32(p_vol_start.levels), vld1_f32(p_vol_start.levels));
+	const float32x4_t vol_final = vcombine_f32(vld1_f32(p_vol_final.levels), vld1_f32(p_vol_final.levels));
+
+	uint32_t i = 0;
+	for (; i + 2 <= p_frames; i += 2) {
+		const float32x4_t vol = _ramp_volume(i, p_frames, vol_start, vol_final);
+		float *dst = &p_dst[i].left;
+		vst1q_f32(dst, vaddq_f32(vld1q_f32(dst), vmulq_f32(vol, vld1q_f32(&p_src[i].left))));
+	}
+	mix_ramp_scalar(p_dst, p_src, p_vol_start, p_vol_final, p_frames, i);
+}
+
+#else
+
+void AudioMixKernels::accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames) {
+	accumulate_scalar(p_dst, p_src, p_frames);
+}
+
+void AudioMixKernels::apply_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	apply_ramp_scalar(p_dst, p_src, p_vol_start, p_vol_final, p_frames);
+}
+
+void AudioMixKernels::mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	mix_ramp_scalar(p_dst, p_src, p_vol_start, p_vol_final, p_frames);
+}
+
+#endif
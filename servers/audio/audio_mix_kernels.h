@@ -0,0 +1,62 @@
+/**************************************************************************/
+/*  audio_mix_kernels.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_MIX_KERNELS_H
+#define AUDIO_MIX_KERNELS_H
+
+#include "core/math/audio_frame.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIX_KERNELS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define AUDIO_MIX_KERNELS_NEON
+#endif
+
+// Block kernels for the per-frame loops of the mixer. When SSE2 or NEON is available, two stereo
+// frames are processed per instruction, with the same arithmetic as the scalar fallback. Results can still differ
+// in the last bits where the compiler contracts the scalar code into fused multiply-adds (e.g. on arm64).
+class AudioMixKernels {
+public:
+	static bool has_simd();
+
+	// p_dst[i] += p_src[i]
+	static void accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames);
+	// p_dst[i] = p_src[i] * lerp(p_vol_start, p_vol_final, i / p_frames)
+	static void apply_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames);
+	// p_dst[i] += p_src[i] * lerp(p_vol_start, p_vol_final, i / p_frames)
+	static void mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames);
+
+	// Scalar versions, used as fallback and for the frames left over by the vectorized loops.
+	static void accumulate_scalar(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames, uint32_t p_from = 0);
+	static void apply_ramp_scalar(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames, uint32_t p_from = 0);
+	static void mix_ramp_scalar(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames, uint32_t p_from = 0);
+};
+
+#endif // AUDIO_MIX_KERNELS_H
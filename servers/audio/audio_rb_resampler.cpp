@@ -31,6 +31,7 @@
 #include "audio_rb_resampler.h"
 #include "core/math/math_funcs.h"
 #include "core/os/os.h"
+#include "servers/audio/audio_resampler_polyphase.h"
 #include "servers/audio_server.h"
 
 int AudioRBResampler::get_channel_count() const {
@@ -101,6 +102,42 @@ uint32_t AudioRBResampler::_resample(AudioFrame *p_dest, int p_todo, int32_t p_i
 	return read >> MIX_FRAC_BITS; //rb_read_pos = offset >> MIX_FRAC_BITS;
 }
 
+// Polyphase FIR sample rate conversion (high quality)
+// The filter looks ahead of the read position instead of behind it, since frames behind it may
+// already be overwritten by the writer. This delays the output by a few frames.
+template <int C>
+uint32_t AudioRBResampler::_resample_polyphase(AudioFrame *p_dest, int p_todo, int32_t p_increment) {
+	uint32_t read = offset & MIX_FRAC_MASK;
+	AudioFrame window[AudioResamplerPolyphase::TAPS];
+
+	for (int i = 0; i < p_todo; i++) {
+		offset = (offset + p_increment) & (((1 << (rb_bits + MIX_FRAC_BITS)) - 1));
+		read += p_increment;
+		uint32_t pos = offset >> MIX_FRAC_BITS;
+		float frac = float(offset & MIX_FRAC_MASK) / float(MIX_FRAC_LEN);
+		ERR_FAIL_COND_V(pos >= rb_len, 0);
+
+		const AudioFrame *frames = window;
+		if (C == 2 && pos + AudioResamplerPolyphase::TAPS <= rb_len) {
+			// Stereo frames are laid out like AudioFrame, read them in place.
+			frames = reinterpret_cast<const AudioFrame *>(&rb[pos << 1]);
+		} else {
+			for (int j = 0; j < AudioResamplerPolyphase::TAPS; j++) {
+				uint32_t tap_pos = (pos + j) & rb_mask;
+				if constexpr (C == 1) {
+					window[j] = AudioFrame(rb[tap_pos], rb[tap_pos]);
+				} else {
+					window[j] = AudioFrame(rb[tap_pos * C + 0], rb[tap_pos * C + 1]);
+				}
+			}
+		}
+
+		p_dest[i] = AudioResamplerPolyphase::interpolate(frames, frac);
+	}
+
+	return read >> MIX_FRAC_BITS; //rb_read_pos = offset >> MIX_FRAC_BITS;
+}
+
 bool AudioRBResampler::mix(AudioFrame *p_dest, int p_frames) {
 	if (!rb) {
 		return false;
@@ -112,19 +149,36 @@ bool AudioRBResampler::mix(AudioFrame *p_dest, int p_frames) {
 
 	{
 		int src_read = 0;
-		switch (channels) {
-			case 1:
-				src_read = _resample<1>(p_dest, target_todo, increment);
-				break;
-			case 2:
-				src_read = _resample<2>(p_dest, target_todo, increment);
-				break;
-			case 4:
-				src_read = _resample<4>(p_dest, target_todo, increment);
-				break;
-			case 6:
-				src_read = _resample<6>(p_dest, target_todo, increment);
-				break;
+		if (polyphase) {
+			switch (channels) {
+				case 1:
+					src_read = _resample_polyphase<1>(p_dest, target_todo, increment);
+					break;
+				case 2:
+					src_read = _resample_polyphase<2>(p_dest, target_todo, increment);
+					break;
+				case 4:
+					src_read = _resample_polyphase<4>(p_dest, target_todo, increment);
+					break;
+				case 6:
+					src_read = _resample_polyphase<6>(p_dest, target_todo, increment);
+					break;
+			}
+		} else {
+			switch (channels) {
+				case 1:
+					src_read = _resample<1>(p_dest, target_todo, increment);
+					break;
+				case 2:
+					src_read = _resample<2>(p_dest, target_todo, increment);
+					break;
+				case 4:
+					src_read = _resample<4>(p_dest, target_todo, increment);
+					break;
+				case 6:
+					src_read = _resample<6>(p_dest, target_todo, increment);
+					break;
+			}
 		}
 
 		if (src_read > read_space) {
@@ -155,6 +209,10 @@ int AudioRBResampler::get_num_of_ready_frames() {
 	}
 	int32_t increment = (src_mix_rate * MIX_FRAC_LEN) / target_mix_rate;
 	int read_space = get_reader_space();
+	if (polyphase) {
+		// The filter reads ahead of the read position.
+		read_space = MAX(read_space - (AudioResamplerPolyphase::TAPS - 1), 0);
+	}
 	return (int64_t(read_space) << MIX_FRAC_BITS) / increment;
 }
 
@@ -183,6 +241,7 @@ Error AudioRBResampler::setup(int p_channels, int p_src_mix_rate, int p_target_m
 
 	src_mix_rate = p_src_mix_rate;
 	target_mix_rate = p_target_mix_rate;
+	polyphase = AudioServer::get_singleton() && AudioServer::get_singleton()->get_resampling_mode() == AudioServer::RESAMPLING_MODE_POLYPHASE;
 	offset = 0;
 	rb_read_pos.set(0);
 	rb_write_pos.set(0);
@@ -58,8 +58,12 @@ struct AudioRBResampler {
 	float *read_buf = nullptr;
 	float *rb = nullptr;
 
+	bool polyphase = false; // Resampling mode, picked up from AudioServer on setup.
+
 	template <int C>
 	uint32_t _resample(AudioFrame *p_dest, int p_todo, int32_t p_increment);
+	template <int C>
+	uint32_t _resample_polyphase(AudioFrame *p_dest, int p_todo, int32_t p_increment);
 
 public:
 	_FORCE_INLINE_ void flush() {
@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  audio_resampler_polyphase.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_resampler_polyphase.h"
+
+#include "core/math/math_funcs.h"
+#include "servers/audio/audio_mix_kernels.h"
+
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+#include <emmintrin.h>
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+#include <arm_neon.h>
+#endif
+
+float AudioResamplerPolyphase::filter_bank[PHASES + 1][TAPS * 2];
+
+void AudioResamplerPolyphase::_initialize_filter_bank() {
+	// Cutoff slightly below the source Nyquist frequency, as a fraction of the source rate.
+	const double cutoff = 0.45;
+	const double half_width = TAPS / 2;
+
+	for (int phase = 0; phase <= PHASES; phase++) {
+		double coeffs[TAPS];
+		double sum = 0.0;
+
+		for (int tap = 0; tap < TAPS; tap++) {
+			const double distance = tap - (TAPS / 2 - 1) - double(phase) / PHASES;
+			const double x = 2.0 * cutoff * distance;
+			const double sinc = Math::is_zero_approx(x) ? 1.0 : Math::sin(Math_PI * x) / (Math_PI * x);
+			// Blackman window.
+			const double window = 0.42 + 0.5 * Math::cos(Math_PI * distance / half_width) + 0.08 * Math::cos(2.0 * Math_PI * distance / half_width);
+			coeffs[tap] = sinc * window;
+			sum += coeffs[tap];
+		}
+
+		// Normalize for unity gain at DC.
+		for (int tap = 0; tap < TAPS; tap++) {
+			filter_bank[phase][tap * 2 + 0] = coeffs[tap] / sum;
+			filter_bank[phase][tap * 2 + 1] = coeffs[tap] / sum;
+		}
+	}
+}
+
+void AudioResamplerPolyphase::initialize() {
+	static bool initialized = false;
+	if (!initialized) {
+		_initialize_filter_bank();
+		initialized = true;
+	}
+}
+
+AudioFrame AudioResamplerPolyphase::interpolate_scalar(const AudioFrame *p_frames, float p_phase) {
+	const float position = p_phase * PHASES;
+	const int phase = MIN(int(position), PHASES - 1);
+	const float frac = position - phase;
+	const float *coeffs = filter_bank[phase];
+	const float *coeffs_next = filter_bank[phase + 1];
+
+	AudioFrame result;
+	for (int tap = 0; tap < TAPS; tap++) {
+		const float coeff = coeffs[tap * 2] + frac * (coeffs_next[tap * 2] - coeffs[tap * 2]);
+		result += p_frames[tap] * coeff;
+	}
+	return result;
+}
+
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+
+AudioFrame AudioResamplerPolyphase::interpolate(const AudioFrame *p_frames, float p_phase) {
+	const float position = p_phase * PHASES;
+	const int phase = MIN(int(position), PHASES - 1);
+	const __m128 frac = _mm_set1_ps(position - phase);
+	const float *coeffs = filter_bank[phase];
+	const float *coeffs_next = filter_bank[phase + 1];
+
+	// Two taps per iteration, for both channels: [left0, right0, left1, right1].
+	__m128 sum = _mm_setzero_ps();
+	for (int tap = 0; tap < TAPS; tap += 2) {
+		const __m128 c0 = _mm_loadu_ps(coeffs + tap * 2);
+		const __m128 c1 = _mm_loadu_ps(coeffs_next + tap * 2);
+		const __m128 coeff = _mm_add_ps(c0, _mm_mul_ps(frac, _mm_sub_ps(c1, c0)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&p_frames[tap].left), coeff));
+	}
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+
+	float lanes[4];
+	_mm_storeu_ps(lanes, sum);
+	return AudioFrame(lanes[0], lanes[1]);
+}
+
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+
+AudioFrame AudioResamplerPolyphase::interpolate(const AudioFrame *p_frames, float p_phase) {
+	const float position = p_phase * PHASES;
+	const int phase = MIN(int(position), PHASES - 1);
+	const float32x4_t frac = vdupq_n_f32(position - phase);
+	const float *coeffs = filter_bank[phase];
+	const float *coeffs_next = filter_bank[phase + 1];
+
+	// Two taps per iteration, for both channels: [left0, right0, left1, right1].
+	float32x4_t sum = vdupq_n_f32(0.0f);
+	for (int tap = 0; tap < TAPS; tap += 2) {
+		const float32x4_t c0 = vld1q_f32(coeffs + tap * 2);
+		const float32x4_t c1 = vld1q_f32(coeffs_next + tap * 2);
+		const float32x4_t coeff = vaddq_f32(c0, vmulq_f32(frac, vsubq_f32(c1, c0)));
+		sum = vaddq_f32(sum, vmulq_f32(vld1q_f32(&p_frames[tap].left), coeff));
+	}
+	const float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+
+	return AudioFrame(vget_lane_f32(pair, 0), vget_lane_f32(pair, 1));
+}
+
+#else
+
+AudioFrame AudioResamplerPolyphase::interpolate(const AudioFrame *p_frames, float p_phase) {
+	return interpolate_scalar(p_frames, p_phase);
+}
+
+#endif
@@ -0,0 +1,64 @@
+/**************************************************************************/
+/*  audio_resampler_polyphase.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_RESAMPLER_POLYPHASE_H
+#define AUDIO_RESAMPLER_POLYPHASE_H
+
+#include "core/math/audio_frame.h"
+
+// Windowed-sinc polyphase FIR used by the polyphase resampling mode. The filter bank is computed
+// once and shared by every resampler, coefficients for a fractional position are interpolated
+// between the two nearest phases.
+class AudioResamplerPolyphase {
+public:
+	enum {
+		TAPS = 16,
+		PHASES = 128,
+		// Frames of extra delay compared to interpolating between the two frames before the last one.
+		DELAY = TAPS / 2 - 2,
+	};
+
+private:
+	// Each coefficient is stored twice, once for the left and once for the right channel.
+	// One extra phase makes interpolating up to a fractional position of 1.0 branchless.
+	static float filter_bank[PHASES + 1][TAPS * 2];
+
+	static void _initialize_filter_bank();
+
+public:
+	static void initialize();
+
+	// Returns the frame at p_phase (0 to 1) between p_frames[TAPS / 2 - 1] and p_frames[TAPS / 2].
+	// p_frames must hold TAPS consecutive frames.
+	static AudioFrame interpolate(const AudioFrame *p_frames, float p_phase);
+	static AudioFrame interpolate_scalar(const AudioFrame *p_frames, float p_phase);
+};
+
+#endif // AUDIO_RESAMPLER_POLYPHASE_H
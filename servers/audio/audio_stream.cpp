@@ -105,13 +105,12 @@ void AudioStreamPlayback::_bind_methods() {
 //////////////////////////////
 
 void AudioStreamPlaybackResampled::begin_resample() {
-	//clear cubic interpolation history
-	internal_buffer[0] = AudioFrame(0.0, 0.0);
-	internal_buffer[1] = AudioFrame(0.0, 0.0);
-	internal_buffer[2] = AudioFrame(0.0, 0.0);
-	internal_buffer[3] = AudioFrame(0.0, 0.0);
+	//clear interpolation history
+	for (int i = 0; i < INTERP_HISTORY; i++) {
+		internal_buffer[i] = AudioFrame(0.0, 0.0);
+	}
 	//mix buffer
-	_mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+	_mix_internal(internal_buffer + INTERP_HISTORY, INTERNAL_BUFFER_LEN);
 	mix_offset = 0;
 }
 
@@ -139,40 +138,49 @@ int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 
 	uint64_t mix_increment = uint64_t(((get_stream_sampling_rate() * p_rate_scale * playback_speed_scale) / double(target_rate)) * double(FP_LEN));
 
+	// Polyphase resampling looks further back, so the end of the stream is reached later.
+	bool polyphase = AudioServer::get_singleton()->get_resampling_mode() == AudioServer::RESAMPLING_MODE_POLYPHASE;
+	int64_t end_delay = polyphase ? AudioResamplerPolyphase::DELAY : 0;
+
 	int mixed_frames_total = -1;
 
 	int i;
 	for (i = 0; i < p_frames; i++) {
-		uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
-		//standard cubic interpolation (great quality/performance ratio)
-		//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
+		uint32_t pos = uint32_t(mix_offset >> FP_BITS);
+		uint32_t idx = INTERP_HISTORY + pos;
 		float mu = (mix_offset & FP_MASK) / float(FP_LEN);
-		AudioFrame y0 = internal_buffer[idx - 3];
-		AudioFrame y1 = internal_buffer[idx - 2];
-		AudioFrame y2 = internal_buffer[idx - 1];
-		AudioFrame y3 = internal_buffer[idx - 0];
 
-		if (idx >= internal_buffer_end && mixed_frames_total == -1) {
+		if (int64_t(pos) + CUBIC_INTERP_HISTORY - end_delay >= int64_t(internal_buffer_end) && mixed_frames_total == -1) {
 			// The internal buffer ends somewhere in this range, and we haven't yet recorded the number of good frames we have.
 			mixed_frames_total = i;
 		}
 
-		float mu2 = mu * mu;
-		AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
-		AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
-		AudioFrame a2 = y2 - y0;
-		AudioFrame a3 = 2 * y1;
-
-		p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+		if (polyphase) {
+			p_buffer[i] = AudioResamplerPolyphase::interpolate(&internal_buffer[idx + 1 - AudioResamplerPolyphase::TAPS], mu);
+		} else {
+			//standard cubic interpolation (great quality/performance ratio)
+			//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
+			AudioFrame y0 = internal_buffer[idx - 3];
+			AudioFrame y1 = internal_buffer[idx - 2];
+			AudioFrame y2 = internal_buffer[idx - 1];
+			AudioFrame y3 = internal_buffer[idx - 0];
+
+			float mu2 = mu * mu;
+			AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
+			AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
+			AudioFrame a2 = y2 - y0;
+			AudioFrame a3 = 2 * y1;
+
+			p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+		}
 
 		mix_offset += mix_increment;
 
 		while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
-			internal_buffer[0] = internal_buffer[INTERNAL_BUFFER_LEN + 0];
-			internal_buffer[1] = internal_buffer[INTERNAL_BUFFER_LEN + 1];
-			internal_buffer[2] = internal_buffer[INTERNAL_BUFFER_LEN + 2];
-			internal_buffer[3] = internal_buffer[INTERNAL_BUFFER_LEN + 3];
-			int mixed_frames = _mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+			for (int j = 0; j < INTERP_HISTORY; j++) {
+				internal_buffer[j] = internal_buffer[INTERNAL_BUFFER_LEN + j];
+			}
+			int mixed_frames = _mix_internal(internal_buffer + INTERP_HISTORY, INTERNAL_BUFFER_LEN);
 			if (mixed_frames != INTERNAL_BUFFER_LEN) {
 				// internal_buffer[mixed_frames] is the first frame of silence.
 				internal_buffer_end = mixed_frames;
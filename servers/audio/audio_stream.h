@@ -35,6 +35,7 @@
 #include "core/io/resource.h"
 #include "scene/property_list_helper.h"
 #include "servers/audio/audio_filter_sw.h"
+#include "servers/audio/audio_resampler_polyphase.h"
 #include "servers/audio_server.h"
 
 #include "core/object/gdvirtual.gen.inc"
@@ -85,10 +86,11 @@ class AudioStreamPlaybackResampled : public AudioStreamPlayback {
 		FP_LEN = (1 << FP_BITS),
 		FP_MASK = FP_LEN - 1,
 		INTERNAL_BUFFER_LEN = 128, // 128 warrants 3ms positional jitter at much at 44100hz
-		CUBIC_INTERP_HISTORY = 4
+		CUBIC_INTERP_HISTORY = 4,
+		INTERP_HISTORY = AudioResamplerPolyphase::TAPS, // Enough history for every resampling mode.
 	};
 
-	AudioFrame internal_buffer[INTERNAL_BUFFER_LEN + CUBIC_INTERP_HISTORY];
+	AudioFrame internal_buffer[INTERNAL_BUFFER_LEN + INTERP_HISTORY];
 	unsigned int internal_buffer_end = -1;
 	uint64_t mix_offset = 0;
 
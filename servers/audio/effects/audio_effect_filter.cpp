@@ -34,35 +34,19 @@
 template <int S>
 void AudioEffectFilterInstance::_process_filter(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count) {
 	for (int i = 0; i < p_frame_count; i++) {
-		float f = p_src_frames[i].left;
-		filter_process[0][0].process_one(f);
-		if constexpr (S > 1) {
-			filter_process[0][1].process_one(f);
-		}
-		if constexpr (S > 2) {
-			filter_process[0][2].process_one(f);
-		}
-		if constexpr (S > 3) {
-			filter_process[0][3].process_one(f);
-		}
-
-		p_dst_frames[i].left = f;
+		p_dst_frames[i] = p_src_frames[i];
 	}
 
-	for (int i = 0; i < p_frame_count; i++) {
-		float f = p_src_frames[i].right;
-		filter_process[1][0].process_one(f);
-		if constexpr (S > 1) {
-			filter_process[1][1].process_one(f);
-		}
-		if constexpr (S > 2) {
-			filter_process[1][2].process_one(f);
-		}
-		if constexpr (S > 3) {
-			filter_process[1][3].process_one(f);
-		}
-
-		p_dst_frames[i].right = f;
+	// Each stage only depends on the output of the previous one, so stages can run over the whole block.
+	AudioFilterSW::Processor::process_stereo(&filter_process[0][0], &filter_process[1][0], p_dst_frames, p_frame_count);
+	if constexpr (S > 1) {
+		AudioFilterSW::Processor::process_stereo(&filter_process[0][1], &filter_process[1][1], p_dst_frames, p_frame_count);
+	}
+	if constexpr (S > 2) {
+		AudioFilterSW::Processor::process_stereo(&filter_process[0][2], &filter_process[1][2], p_dst_frames, p_frame_count);
+	}
+	if constexpr (S > 3) {
+		AudioFilterSW::Processor::process_stereo(&filter_process[0][3], &filter_process[1][3], p_dst_frames, p_frame_count);
 	}
 }
 
@@ -36,12 +36,15 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/math/audio_frame.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
 #include "scene/resources/audio_stream_wav.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix_kernels.h"
+#include "servers/audio/audio_resampler_polyphase.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 
 #include <cstring>
@@ -357,6 +360,20 @@ void AudioServer::_mix_step() {
 			bus->soloed = false;
 		}
 	}
+
+	// Resolve sends once, so buses can be processed in any order that respects them.
+	for (int i = 0; i < buses.size(); i++) {
+		Bus *bus = buses[i];
+		if (i == 0) {
+			bus->send_index_cache = -1; //master bus sends nowhere
+		} else if (!bus_map.has(bus->send)) {
+			bus->send_index_cache = 0;
+		} else {
+			int send_index = bus_map[bus->send]->index_cache;
+			bus->send_index_cache = send_index < i ? send_index : 0; //invalid, send to master
+		}
+	}
+
 	for (CallbackItem *ci : mix_callback_list) {
 		ci->callback(ci->userdata);
 	}
@@ -499,131 +516,245 @@ void AudioServer::_mix_step() {
 		}
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
-		Bus *bus = buses[i];
+	uint64_t buses_ticks = OS::get_singleton()->get_ticks_usec();
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+	if (bus_parallel_threshold > 0 && buses.size() >= bus_parallel_threshold && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		_mix_buses_parallel(solo_mode);
+	} else {
+		for (int i = buses.size() - 1; i >= 0; i--) {
+			_mix_step_for_bus(i, solo_mode);
+		}
+	}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					buf[j] = AudioFrame(0, 0);
-				}
+	buses_process_time.set(OS::get_singleton()->get_ticks_usec() - buses_ticks);
+
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
+
+void AudioServer::_mix_step_for_bus(int p_bus, bool p_solo_mode) {
+	uint64_t bus_ticks = OS::get_singleton()->get_ticks_usec();
+
+	Bus *bus = buses[p_bus];
+
+	// Pull the output of every bus that sends here. Sources always have a higher index than their
+	// target, and are visited in the same order the serial mix used to push them, so the sum is identical.
+	for (int i = buses.size() - 1; i > p_bus; i--) {
+		const Bus *source = buses[i];
+		if (source->send_index_cache != p_bus) {
+			continue;
+		}
+
+		for (int k = 0; k < source->channels.size(); k++) {
+			if (!source->channels[k].active) {
+				continue;
 			}
+
+			AudioMixKernels::accumulate(_get_channel_mix_buffer(bus, k), source->channels[k].buffer.ptr(), buffer_size);
 		}
+	}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
-				if (!bus->effects[j].enabled) {
-					continue;
-				}
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (bus->channels[k].active && !bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+
+			for (uint32_t j = 0; j < buffer_size; j++) {
+				buf[j] = AudioFrame(0, 0);
+			}
+		}
+	}
+
+	//process effects
+	if (!bus->bypass) {
+		for (int j = 0; j < bus->effects.size(); j++) {
+			if (!bus->effects[j].enabled) {
+				continue;
+			}
 
 #ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
+				Bus::Channel &channel = bus->channels.write[k];
+				channel.effect_instances.write[j]->process(channel.buffer.ptr(), channel.temp_buffer.ptrw(), buffer_size);
+			}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+			//swap buffers, so internal buffer always has the right data
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
+				Bus::Channel &channel = bus->channels.write[k];
+				SWAP(channel.buffer, channel.temp_buffer);
+			}
 
 #ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+			bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
 #endif
-			}
 		}
+	}
 
-		//process send
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (!bus->channels[k].active) {
+			bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+			continue;
+		}
 
-		Bus *send = nullptr;
+		AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
+		AudioFrame peak = AudioFrame(0, 0);
+
+		float volume = Math::db_to_linear(bus->volume_db);
+
+		if (p_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (bus->mute) {
+				volume = 0.0;
 			}
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
-				continue;
-			}
+		//apply volume and compute peak
+		for (uint32_t j = 0; j < buffer_size; j++) {
+			buf[j] *= volume;
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+			float l = ABS(buf[j].left);
+			if (l > peak.left) {
+				peak.left = l;
+			}
+			float r = ABS(buf[j].right);
+			if (r > peak.right) {
+				peak.right = r;
+			}
+		}
 
-			AudioFrame peak = AudioFrame(0, 0);
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
 
-			float volume = Math::db_to_linear(bus->volume_db);
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
+			if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false; //went inactive, won't be sent.
 			}
+		}
+	}
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
-				buf[j] *= volume;
+	bus->process_time.set(OS::get_singleton()->get_ticks_usec() - bus_ticks);
+}
 
-				float l = ABS(buf[j].left);
-				if (l > peak.left) {
-					peak.left = l;
-				}
-				float r = ABS(buf[j].right);
-				if (r > peak.right) {
-					peak.right = r;
-				}
-			}
+void AudioServer::_mix_buses_parallel(bool p_solo_mode) {
+	uint32_t bus_count = buses.size();
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+	// Close the previous generation before touching its state. A helper of a previous mix that is late to claim
+	// a bus would otherwise see the new counts with the old claim counter, and claim a slot of the new mix.
+	bus_mix_generation++;
+	bus_ready_claim.store(((uint64_t)bus_mix_generation << 32) | UINT32_MAX);
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+	if (bus_pending_sends.size() != bus_count) {
+		bus_pending_sends.resize(bus_count);
+		bus_ready_queue.resize(bus_count);
+	}
 
-				if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
-			}
+	for (uint32_t i = 0; i < bus_count; i++) {
+		bus_pending_sends[i].set(0);
+		bus_ready_queue[i].set(-1);
+	}
+	for (uint32_t i = 1; i < bus_count; i++) {
+		bus_pending_sends[buses[i]->send_index_cache].increment();
+	}
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+	bus_ready_tail.set(0);
+	bus_mix_done.set(0);
+	bus_mix_count.set(bus_count);
+	bus_mix_solo_mode = p_solo_mode;
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+	// Buses nothing sends to can start right away, the rest are queued by the last bus sending to them.
+	for (int i = bus_count - 1; i >= 0; i--) {
+		if (bus_pending_sends[i].get() == 0) {
+			bus_ready_queue[bus_ready_tail.postincrement()].set(i);
+		}
+	}
+
+	// Open the new generation, helpers can start claiming buses from here.
+	void *generation = (void *)(uintptr_t)bus_mix_generation;
+	bus_ready_claim.store((uint64_t)bus_mix_generation << 32);
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (bus_mix_group >= 0 && pool->is_group_task_completed(bus_mix_group)) {
+		pool->wait_for_group_task_completion(bus_mix_group); // Does not block, just releases the group.
+		bus_mix_group = -1;
+	}
+	if (bus_mix_group < 0) {
+		uint32_t helpers = MIN((uint32_t)pool->get_thread_count(), bus_count) - 1;
+		if (helpers > 0) {
+			bus_mix_group = pool->add_template_group_task(this, &AudioServer::_mix_buses_worker, generation, helpers, helpers, true, SNAME("AudioServerBusMix"));
+		}
+	}
+	// Otherwise the helpers of a previous mix are still queued, so the pool is busy and the audio thread mixes on its own.
+
+	// The audio thread takes part in the mix instead of idling while the helpers run, and mixes everything nobody else picked up.
+	_mix_buses_worker(0, generation);
+
+	// Only wait for buses that are being mixed right now, never for helpers that did not start yet.
+	while (bus_mix_done.get() < bus_count) {
+		OS::get_singleton()->yield();
+	}
+}
+
+void AudioServer::_mix_buses_worker(uint32_t p_index, void *p_userdata) {
+	const uint64_t generation = (uint64_t)(uintptr_t)p_userdata;
+
+	while (true) {
+		// Every bus is queued exactly once, so claiming a slot past the end means all work is taken.
+		uint64_t claim = bus_ready_claim.load();
+		do {
+			if ((claim >> 32) != generation || (claim & UINT32_MAX) >= bus_mix_count.get()) {
+				return;
 			}
+		} while (!bus_ready_claim.compare_exchange_weak(claim, claim + 1));
+		uint32_t slot = claim & UINT32_MAX;
+
+		int bus_idx = bus_ready_queue[slot].get();
+		while (bus_idx < 0) {
+			// The slot was claimed before the bus feeding it finished, wait for it to be published.
+			OS::get_singleton()->yield();
+			bus_idx = bus_ready_queue[slot].get();
 		}
+
+		_mix_step_for_bus(bus_idx, bus_mix_solo_mode);
+
+		int send_idx = buses[bus_idx]->send_index_cache;
+		if (send_idx >= 0 && bus_pending_sends[send_idx].decrement() == 0) {
+			bus_ready_queue[bus_ready_tail.postincrement()].set(send_idx);
+		}
+		bus_mix_done.increment();
 	}
+}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+AudioFrame *AudioServer::_get_channel_mix_buffer(Bus *p_bus, int p_buffer) {
+	Bus::Channel &channel = p_bus->channels.write[p_buffer];
+
+	if (!channel.used) {
+		channel.used = true;
+		channel.active = true;
+		channel.last_mix_with_audio = mix_frames;
+
+		AudioFrame *data = channel.buffer.ptrw();
+		for (uint32_t i = 0; i < buffer_size; i++) {
+			data[i] = AudioFrame(0, 0);
+		}
+	}
+
+	return channel.buffer.ptrw();
 }
 
 void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r) {
@@ -645,22 +776,15 @@ void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_sou
 		p_processor_r->set_filter(&filter, /* clear_history= */ is_just_started);
 		p_processor_r->update_coeffs(buffer_size);
 
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			AudioFrame vol = p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start;
-			AudioFrame mixed = vol * p_source_buf[frame_idx];
-			p_processor_l->process_one_interp(mixed.left);
-			p_processor_r->process_one_interp(mixed.right);
-			p_out_buf[frame_idx] += mixed;
-		}
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		AudioFrame *filter_buf = mix_filter_buffer.ptrw();
+		AudioMixKernels::apply_ramp(filter_buf, p_source_buf, p_vol_start, p_vol_final, buffer_size);
+		AudioFilterSW::Processor::process_stereo(p_processor_l, p_processor_r, filter_buf, buffer_size, true);
+		AudioMixKernels::accumulate(p_out_buf, filter_buf, buffer_size);
 
 	} else {
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			p_out_buf[frame_idx] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_source_buf[frame_idx];
-		}
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		AudioMixKernels::mix_ramp(p_out_buf, p_source_buf, p_vol_start, p_vol_final, buffer_size);
 	}
 }
 
@@ -687,18 +811,7 @@ AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer)
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), nullptr);
 	ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), nullptr);
 
-	AudioFrame *data = buses.write[p_bus]->channels.write[p_buffer].buffer.ptrw();
-
-	if (!buses[p_bus]->channels[p_buffer].used) {
-		buses.write[p_bus]->channels.write[p_buffer].used = true;
-		buses.write[p_bus]->channels.write[p_buffer].active = true;
-		buses.write[p_bus]->channels.write[p_buffer].last_mix_with_audio = mix_frames;
-		for (uint32_t i = 0; i < buffer_size; i++) {
-			data[i] = AudioFrame(0, 0);
-		}
-	}
-
-	return data;
+	return _get_channel_mix_buffer(buses[p_bus], p_buffer);
 }
 
 int AudioServer::thread_get_mix_buffer_size() const {
@@ -755,6 +868,7 @@ void AudioServer::set_bus_count(int p_count) {
 		buses.write[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
@@ -824,6 +938,7 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
 		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels.write[j].temp_buffer.resize(buffer_size);
 	}
 	bus->name = attempt;
 	bus->solo = false;
@@ -1117,6 +1232,16 @@ float AudioServer::get_bus_peak_volume_right_db(int p_bus, int p_channel) const
 	return buses[p_bus]->channels[p_channel].peak_volume.right;
 }
 
+double AudioServer::get_bus_process_time(int p_bus) const {
+	ERR_FAIL_INDEX_V(p_bus, buses.size(), 0);
+
+	return buses[p_bus]->process_time.get() / 1000000.0;
+}
+
+double AudioServer::get_buses_process_time() const {
+	return buses_process_time.get() / 1000000.0;
+}
+
 bool AudioServer::is_bus_channel_active(int p_bus, int p_channel) const {
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), false);
 	ERR_FAIL_INDEX_V(p_channel, buses[p_bus]->channels.size(), false);
@@ -1134,6 +1259,10 @@ float AudioServer::get_playback_speed_scale() const {
 	return playback_speed_scale;
 }
 
+AudioServer::ResamplingMode AudioServer::get_resampling_mode() const {
+	return resampling_mode;
+}
+
 void AudioServer::start_playback_stream(Ref<AudioStreamPlayback> p_playback, const StringName &p_bus, Vector<AudioFrame> p_volume_db_vector, float p_start_time, float p_pitch_scale) {
 	ERR_FAIL_COND(p_playback.is_null());
 
@@ -1356,17 +1485,14 @@ void AudioServer::notify_listener_changed() {
 
 void AudioServer::init_channels_and_buffers() {
 	channel_count = get_channel_count();
-	temp_buffer.resize(channel_count);
 	mix_buffer.resize(buffer_size + LOOKAHEAD_BUFFER_SIZE);
-
-	for (int i = 0; i < temp_buffer.size(); i++) {
-		temp_buffer.write[i].resize(buffer_size);
-	}
+	mix_filter_buffer.resize(buffer_size);
 
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1375,6 +1501,9 @@ void AudioServer::init_channels_and_buffers() {
 void AudioServer::init() {
 	channel_disable_threshold_db = GLOBAL_DEF_RST("audio/buses/channel_disable_threshold_db", -60.0);
 	channel_disable_frames = float(GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "audio/buses/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 2.0)) * get_mix_rate();
+	bus_parallel_threshold = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "audio/buses/parallel_processing_threshold", PROPERTY_HINT_RANGE, "0,128,1,or_greater"), 16);
+	resampling_mode = ResamplingMode(int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "audio/general/resampling_mode", PROPERTY_HINT_ENUM, "Interpolated,Polyphase"), RESAMPLING_MODE_INTERPOLATED)));
+	AudioResamplerPolyphase::initialize();
 	buffer_size = 512; //hardcoded for now
 
 	init_channels_and_buffers();
@@ -1496,6 +1625,12 @@ void AudioServer::finish() {
 		AudioDriverManager::get_driver(i)->finish();
 	}
 
+	if (bus_mix_group >= 0) {
+		// Late helpers return right away, but they still reference the server.
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(bus_mix_group);
+		bus_mix_group = -1;
+	}
+
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1631,6 +1766,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1747,6 +1883,7 @@ void AudioServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_bus_peak_volume_left_db", "bus_idx", "channel"), &AudioServer::get_bus_peak_volume_left_db);
 	ClassDB::bind_method(D_METHOD("get_bus_peak_volume_right_db", "bus_idx", "channel"), &AudioServer::get_bus_peak_volume_right_db);
+	ClassDB::bind_method(D_METHOD("get_bus_process_time", "bus_idx"), &AudioServer::get_bus_process_time);
 
 	ClassDB::bind_method(D_METHOD("set_playback_speed_scale", "scale"), &AudioServer::set_playback_speed_scale);
 	ClassDB::bind_method(D_METHOD("get_playback_speed_scale"), &AudioServer::get_playback_speed_scale);
@@ -34,6 +34,7 @@
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_list.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
@@ -166,6 +167,12 @@ public:
 		SPEAKER_SURROUND_71,
 	};
 
+	// How streams are converted from their own sample rate to the mix rate.
+	enum ResamplingMode {
+		RESAMPLING_MODE_INTERPOLATED, // Cubic or linear interpolation.
+		RESAMPLING_MODE_POLYPHASE, // Windowed-sinc polyphase FIR, see AudioResamplerPolyphase.
+	};
+
 	enum {
 		AUDIO_DATA_INVALID_ID = -1,
 		MAX_CHANNELS_PER_BUS = 4,
@@ -193,6 +200,7 @@ private:
 	int to_mix = 0;
 
 	float playback_speed_scale = 1.0f;
+	ResamplingMode resampling_mode = RESAMPLING_MODE_INTERPOLATED;
 
 	bool tag_used_audio_streams = false;
 
@@ -210,6 +218,7 @@ private:
 			bool active = false;
 			AudioFrame peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> temp_buffer; // Effect output, swapped with buffer after each effect.
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio = 0;
 			Channel() {}
@@ -229,6 +238,8 @@ private:
 		float volume_db = 0.0f;
 		StringName send;
 		int index_cache = 0;
+		int send_index_cache = -1; // Resolved at the start of every mix step, -1 for the master bus.
+		SafeNumeric<uint64_t> process_time; // Usec spent on this bus during the last mix step, written by the mixing threads.
 	};
 
 	struct AudioStreamPlaybackBusDetails {
@@ -269,8 +280,8 @@ private:
 	// TODO document if this is necessary.
 	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard_frame_old;
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<AudioFrame> mix_buffer;
+	Vector<AudioFrame> mix_filter_buffer; // Ramped playback output, filtered before being mixed into a bus.
 	Vector<Bus *> buses;
 	HashMap<StringName, Bus *> bus_map;
 
@@ -280,7 +291,26 @@ private:
 
 	void init_channels_and_buffers();
 
+	// Buses only depend on the buses sending to them, so with enough of them the bus graph is mixed on the WorkerThreadPool.
+	int bus_parallel_threshold = 16;
+	bool bus_mix_solo_mode = false;
+	LocalVector<SafeNumeric<uint32_t>> bus_pending_sends;
+	LocalVector<SafeNumeric<int>> bus_ready_queue;
+	SafeNumeric<uint32_t> bus_ready_tail;
+	// Mix generation in the high 32 bits, next slot to claim in the low 32 bits. Helpers only claim slots from their own generation,
+	// so helpers that start late (e.g. when the pool is busy) never touch a later mix, and the audio thread never waits for them.
+	std::atomic<uint64_t> bus_ready_claim = { 0 };
+	SafeNumeric<uint32_t> bus_mix_count;
+	SafeNumeric<uint32_t> bus_mix_done;
+	uint32_t bus_mix_generation = 0;
+	int64_t bus_mix_group = -1;
+	SafeNumeric<uint64_t> buses_process_time;
+
 	void _mix_step();
+	void _mix_step_for_bus(int p_bus, bool p_solo_mode);
+	void _mix_buses_parallel(bool p_solo_mode);
+	void _mix_buses_worker(uint32_t p_index, void *p_userdata);
+	AudioFrame *_get_channel_mix_buffer(Bus *p_bus, int p_buffer);
 	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
 
 	// Should only be called on the main thread.
@@ -365,12 +395,16 @@ public:
 
 	float get_bus_peak_volume_left_db(int p_bus, int p_channel) const;
 	float get_bus_peak_volume_right_db(int p_bus, int p_channel) const;
+	double get_bus_process_time(int p_bus) const;
+	double get_buses_process_time() const;
 
 	bool is_bus_channel_active(int p_bus, int p_channel) const;
 
 	void set_playback_speed_scale(float p_scale);
 	float get_playback_speed_scale() const;
 
+	ResamplingMode get_resampling_mode() const;
+
 	// Convenience method.
 	void start_playback_stream(Ref<AudioStreamPlayback> p_playback, const StringName &p_bus, Vector<AudioFrame> p_volume_db_vector, float p_start_time = 0, float p_pitch_scale = 1);
 	// Expose all parameters.
@@ -152,6 +152,10 @@ class GodotBody2D : public GodotCollisionObject2D {
 
 	uint64_t island_step = 0;
 
+	// Shape motion computed by integrate_forces(), sent to the broadphase by finish_integrate_forces().
+	Vector2 integrated_motion;
+	bool integrated_motion_pending = false;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState2D; // i give up, too many functions to expose
@@ -315,8 +319,12 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// These only touch the body itself and may run in parallel for all bodies of a space.
+	// The matching finish_*() call must then be made serially, as it updates the broadphase and space lists.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
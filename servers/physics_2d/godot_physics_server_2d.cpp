@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1284,7 +1285,15 @@ void GodotPhysicsServer2D::set_active(bool p_active) {
 
 void GodotPhysicsServer2D::init() {
 	doing_sync = false;
-	stepper = memnew(GodotStep2D);
+	step_spaces_in_parallel = GLOBAL_GET("physics/2d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer2D::_step_space(uint32_t p_space_index, void *p_userdata) {
+	GodotSpace2D *space = spaces_to_step[p_space_index];
+	// Already on a pool thread, the step phases run inline. With as many spaces as threads,
+	// waiting on nested group tasks would leave no thread to run them.
+	space->get_stepper()->set_use_thread_pool(false);
+	space->get_stepper()->step(space, space_step);
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
@@ -1297,8 +1306,25 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	if (step_spaces_in_parallel && active_spaces.size() > 1) {
+		// Spaces never interact, so each can be stepped on its own thread with its own stepper.
+		spaces_to_step.clear();
+		for (const GodotSpace2D *E : active_spaces) {
+			spaces_to_step.push_back(const_cast<GodotSpace2D *>(E));
+		}
+		space_step = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer2D::_step_space, nullptr, spaces_to_step.size(), -1, true, SNAME("Physics2DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const GodotSpace2D *E : active_spaces) {
+			GodotSpace2D *space = const_cast<GodotSpace2D *>(E);
+			space->get_stepper()->set_use_thread_pool(true);
+			space->get_stepper()->step(space, p_step);
+		}
+	}
+
 	for (const GodotSpace2D *E : active_spaces) {
-		stepper->step(const_cast<GodotSpace2D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1329,10 +1355,13 @@ void GodotPhysicsServer2D::flush_queries() {
 		uint64_t total_time[GodotSpace2D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace2D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"update_broadphase",
 			"generate_islands",
 			"setup_constraints",
+			"pre_solve_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"check_sleep"
 		};
 
 		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
@@ -1364,7 +1393,6 @@ void GodotPhysicsServer2D::end_sync() {
 }
 
 void GodotPhysicsServer2D::finish() {
-	memdelete(stepper);
 }
 
 void GodotPhysicsServer2D::_update_shapes() {
@@ -55,7 +55,9 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 
 	bool flushing_queries = false;
 
-	GodotStep2D *stepper = nullptr;
+	bool step_spaces_in_parallel = false;
+	LocalVector<GodotSpace2D *> spaces_to_step;
+	real_t space_step = 0.0;
 	HashSet<const GodotSpace2D *> active_spaces;
 
 	mutable RID_PtrOwner<GodotShape2D, true> shape_owner;
@@ -69,6 +71,7 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	friend class GodotCollisionObject2D;
 	SelfList<GodotCollisionObject2D>::List pending_shape_update_list;
 	void _update_shapes();
+	void _step_space(uint32_t p_space_index, void *p_userdata = nullptr);
 
 	RID _shape_create(ShapeType p_shape);
 
@@ -32,6 +32,7 @@
 
 #include "godot_collision_solver_2d.h"
 #include "godot_physics_server_2d.h"
+#include "godot_step_2d.h"
 
 #include "core/os/os.h"
 #include "core/templates/pair.h"
@@ -1232,9 +1233,12 @@ GodotSpace2D::GodotSpace2D() {
 
 	direct_access = memnew(GodotPhysicsDirectSpaceState2D);
 	direct_access->space = this;
+
+	stepper = memnew(GodotStep2D);
 }
 
 GodotSpace2D::~GodotSpace2D() {
 	memdelete(broadphase);
 	memdelete(direct_access);
+	memdelete(stepper);
 }
@@ -42,6 +42,8 @@
 #include "core/templates/hash_map.h"
 #include "core/typedefs.h"
 
+class GodotStep2D;
+
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
@@ -62,10 +64,13 @@ class GodotSpace2D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_UPDATE_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
+		ELAPSED_TIME_PRE_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_CHECK_SLEEP,
 		ELAPSED_TIME_MAX
 
 	};
@@ -128,12 +133,17 @@ private:
 	Vector<Vector2> contact_debug;
 	int contact_debug_count = 0;
 
+	// Owned per space, so independent spaces can be stepped concurrently.
+	GodotStep2D *stepper = nullptr;
+
 	friend class GodotPhysicsDirectSpaceState2D;
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
+	_FORCE_INLINE_ GodotStep2D *get_stepper() const { return stepper; }
+
 	void set_default_area(GodotArea2D *p_area) { area = p_area; }
 	GodotArea2D *get_default_area() const { return area; }
 
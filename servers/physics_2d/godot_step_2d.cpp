@@ -39,6 +39,8 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+SafeNumeric<uint64_t> GodotStep2D::step_counter;
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -101,33 +103,58 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep2D::_sleep_test_island(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
-
-		if (!body->sleep_test(delta)) {
+		// Every body must be tested, as the test also accumulates its still time.
+		if (!body_island[body_index]->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep2D::_check_suspend(const LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody2D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
 
+void GodotStep2D::_gather_active_bodies(const SelfList<GodotBody2D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
+	_step = step_counter.increment();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -142,23 +169,30 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(body_list);
+	uint32_t active_body_count = active_bodies.size();
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	_run_phase(&GodotStep2D::_integrate_forces, active_body_count, SNAME("Physics2DIntegrateForces"));
+
+	// The broadphase isn't thread-safe, update it in list order so pairs are always created in the same order.
+	for (uint32_t body_index = 0; body_index < active_body_count; ++body_index) {
+		active_bodies[body_index]->finish_integrate_forces();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects(active_body_count);
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_UPDATE_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -192,12 +226,16 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
-
+	// Islands are discovered serially: the traversal stamps bodies and constraints shared between islands,
+	// and its order is the order constraints get solved in, which must stay deterministic.
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	// New area pairs may have activated kinematic bodies during the broadphase update.
+	_gather_active_bodies(body_list);
+	active_body_count = active_bodies.size();
+
+	for (uint32_t body_index = 0; body_index < active_body_count; ++body_index) {
+		GodotBody2D *body = active_bodies[body_index];
 
 		if (body->get_island_step() != _step) {
 			++body_island_count;
@@ -226,7 +264,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -240,8 +277,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_phase(&GodotStep2D::_setup_constraint, total_constraint_count, SNAME("Physics2DConstraintSetup"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -256,12 +292,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		_pre_solve_island(constraint_islands[island_index]);
 	}
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_PRE_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_phase(&GodotStep2D::_solve_island, island_count, SNAME("Physics2DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -271,29 +312,41 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Bodies may have been woken up since the forces were integrated.
+	_gather_active_bodies(body_list);
+	active_body_count = active_bodies.size();
+
+	_run_phase(&GodotStep2D::_integrate_velocities, active_body_count, SNAME("Physics2DIntegrateVelocities"));
+
+	// Kinematic bodies can leave the active list here, and the broadphase isn't thread-safe.
+	for (uint32_t body_index = 0; body_index < active_body_count; ++body_index) {
+		active_bodies[body_index]->finish_integrate_velocities();
+	}
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	_run_phase(&GodotStep2D::_sleep_test_island, body_island_count, SNAME("Physics2DSleepTest"));
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_CHECK_SLEEP, profile_endtime - profile_begtime);
 		//profile_begtime=profile_endtime;
 	}
 
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep2D::GodotStep2D() {
@@ -663,22 +663,24 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	integrated_motion = motion;
+	integrated_motion_pending = do_motion;
 
 	contact_count = 0;
 }
 
+void GodotBody3D::finish_integrate_forces() {
+	if (integrated_motion_pending) { //shapes temporarily extend for raycast
+		_update_shapes_with_motion(integrated_motion);
+		integrated_motion_pending = false;
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -698,10 +700,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
-		}
-
 		return;
 	}
 
@@ -728,12 +726,31 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::finish_integrate_velocities() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
+			set_active(false); //stopped moving, deactivate
+		}
+		return;
+	}
+
+	_update_shapes();
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -146,6 +146,10 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Shape motion computed by integrate_forces(), sent to the broadphase by finish_integrate_forces().
+	Vector3 integrated_motion;
+	bool integrated_motion_pending = false;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
@@ -316,8 +320,12 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// These only touch the body itself and may run in parallel for all bodies of a space.
+	// The matching finish_*() call must then be made serially, as it updates the broadphase and space lists.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -161,6 +161,38 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+bool GodotBodyPair3D::_can_reuse_contacts(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const Transform3D &p_relative_xform) const {
+	if (!cache_valid || p_shape_A != cache_shape_A || p_shape_B != cache_shape_B) {
+		return false;
+	}
+
+	if (p_shape_A->get_version() != cache_version_A || p_shape_B->get_version() != cache_version_B) {
+		return false;
+	}
+
+	if (cache_collided && contact_count == 0) {
+		// All cached contacts were discarded by validate_contacts(), the manifold must be rebuilt.
+		return false;
+	}
+
+	// Drift is measured against the transform the contacts were generated with, so slow motion still refreshes them eventually.
+	real_t linear_threshold = space->get_persistent_contacts_linear_threshold();
+	if (p_relative_xform.origin.distance_squared_to(cache_relative_xform.origin) > linear_threshold * linear_threshold) {
+		return false;
+	}
+
+	// For small rotations, the chord length between basis columns approximates the angle in radians.
+	real_t angular_threshold = space->get_persistent_contacts_angular_threshold();
+	real_t angular_threshold2 = angular_threshold * angular_threshold;
+	for (int i = 0; i < 3; i++) {
+		if (p_relative_xform.basis.get_column(i).distance_squared_to(cache_relative_xform.basis.get_column(i)) > angular_threshold2) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // _test_ccd prevents tunneling by slowing down a high velocity body that is about to collide so that next frame it will be at an appropriate location to collide (i.e. slight overlap)
 // Warning: the way velocity is adjusted down to cause a collision means the momentum will be weaker than it should for a bounce!
 // Process: only proceed if body A's motion is high relative to its size.
@@ -260,9 +292,11 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
+	cache_result = CONTACT_CACHE_NONE;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		cache_valid = false;
 		return false;
 	}
 
@@ -275,6 +309,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			cache_valid = false;
 			return false;
 		}
 	}
@@ -294,7 +329,30 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	if (space->is_using_persistent_contacts()) {
+		Transform3D relative_xform = xform_A.affine_inverse() * xform_B;
+		if (_can_reuse_contacts(shape_A_ptr, shape_B_ptr, relative_xform)) {
+			// Bodies barely moved relative to each other, keep the manifold and its accumulated impulses.
+			for (int i = 0; i < contact_count; i++) {
+				contacts[i].used = true;
+			}
+			collided = cache_collided;
+			cache_result = CONTACT_CACHE_HIT;
+		} else {
+			collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+
+			cache_valid = true;
+			cache_collided = collided;
+			cache_relative_xform = relative_xform;
+			cache_shape_A = shape_A_ptr;
+			cache_shape_B = shape_B_ptr;
+			cache_version_A = shape_A_ptr->get_version();
+			cache_version_B = shape_B_ptr->get_version();
+			cache_result = CONTACT_CACHE_MISS;
+		}
+	} else {
+		collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	}
 
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
@@ -314,6 +372,11 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 }
 
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
+	if (cache_result != CONTACT_CACHE_NONE) {
+		space->add_contact_cache_result(cache_result == CONTACT_CACHE_HIT);
+		cache_result = CONTACT_CACHE_NONE;
+	}
+
 	if (!collided) {
 		if (check_ccd) {
 			const Vector3 &offset_A = A->get_transform().get_origin();
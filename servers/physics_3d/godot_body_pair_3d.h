@@ -97,11 +97,28 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Persistent contacts: narrowphase inputs of the last time the collision solver ran.
+	enum ContactCacheResult {
+		CONTACT_CACHE_NONE,
+		CONTACT_CACHE_HIT,
+		CONTACT_CACHE_MISS,
+	};
+
+	bool cache_valid = false;
+	bool cache_collided = false;
+	Transform3D cache_relative_xform; // Shape B relative to shape A.
+	GodotShape3D *cache_shape_A = nullptr;
+	GodotShape3D *cache_shape_B = nullptr;
+	uint32_t cache_version_A = 0;
+	uint32_t cache_version_B = 0;
+	ContactCacheResult cache_result = CONTACT_CACHE_NONE;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _can_reuse_contacts(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const Transform3D &p_relative_xform) const;
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
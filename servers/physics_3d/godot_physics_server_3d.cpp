@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1625,7 +1627,15 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 }
 
 void GodotPhysicsServer3D::init() {
-	stepper = memnew(GodotStep3D);
+	step_spaces_in_parallel = GLOBAL_GET("physics/3d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer3D::_step_space(uint32_t p_space_index, void *p_userdata) {
+	GodotSpace3D *space = spaces_to_step[p_space_index];
+	// Already on a pool thread, the step phases run inline. With as many spaces as threads,
+	// waiting on nested group tasks would leave no thread to run them.
+	space->get_stepper()->set_use_thread_pool(false);
+	space->get_stepper()->step(space, space_step);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1640,11 +1650,32 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	contact_cache_hits = 0;
+	contact_cache_misses = 0;
+	if (step_spaces_in_parallel && active_spaces.size() > 1) {
+		// Spaces never interact, so each can be stepped on its own thread with its own stepper.
+		spaces_to_step.clear();
+		for (const GodotSpace3D *E : active_spaces) {
+			spaces_to_step.push_back(const_cast<GodotSpace3D *>(E));
+		}
+		space_step = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, nullptr, spaces_to_step.size(), -1, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const GodotSpace3D *E : active_spaces) {
+			GodotSpace3D *space = const_cast<GodotSpace3D *>(E);
+			space->get_stepper()->set_use_thread_pool(true);
+			space->get_stepper()->step(space, p_step);
+		}
+	}
+
 	for (const GodotSpace3D *E : active_spaces) {
-		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		contact_cache_hits += E->get_contact_cache_hits();
+		contact_cache_misses += E->get_contact_cache_misses();
 	}
 #endif
 }
@@ -1675,10 +1706,13 @@ void GodotPhysicsServer3D::flush_queries() {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"update_broadphase",
 			"generate_islands",
 			"setup_constraints",
+			"pre_solve_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"check_sleep"
 		};
 
 		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
@@ -1711,7 +1745,6 @@ void GodotPhysicsServer3D::end_sync() {
 }
 
 void GodotPhysicsServer3D::finish() {
-	memdelete(stepper);
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -1725,6 +1758,12 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_CONTACT_CACHE_HITS: {
+			return contact_cache_hits;
+		} break;
+		case INFO_CONTACT_CACHE_MISSES: {
+			return contact_cache_misses;
+		} break;
 	}
 
 	return 0;
@@ -48,12 +48,16 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int contact_cache_hits = 0;
+	int contact_cache_misses = 0;
 
 	bool using_threads = false;
 	bool doing_sync = false;
 	bool flushing_queries = false;
 
-	GodotStep3D *stepper = nullptr;
+	bool step_spaces_in_parallel = false;
+	LocalVector<GodotSpace3D *> spaces_to_step;
+	real_t space_step = 0.0;
 	HashSet<const GodotSpace3D *> active_spaces;
 
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
@@ -67,6 +71,7 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	friend class GodotCollisionObject3D;
 	SelfList<GodotCollisionObject3D>::List pending_shape_update_list;
 	void _update_shapes();
+	void _step_space(uint32_t p_space_index, void *p_userdata = nullptr);
 
 	static GodotPhysicsServer3D *godot_singleton;
 
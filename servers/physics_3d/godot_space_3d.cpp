@@ -32,6 +32,7 @@
 
 #include "godot_collision_solver_3d.h"
 #include "godot_physics_server_3d.h"
+#include "godot_step_3d.h"
 
 #include "core/config/project_settings.h"
 
@@ -1176,6 +1177,8 @@ void GodotSpace3D::call_queries() {
 
 void GodotSpace3D::setup() {
 	contact_debug_count = 0;
+	contact_cache_hits = 0;
+	contact_cache_misses = 0;
 	while (mass_properties_update_list.first()) {
 		mass_properties_update_list.first()->self()->update_mass_properties();
 		mass_properties_update_list.remove(mass_properties_update_list.first());
@@ -1262,6 +1265,9 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	persistent_contacts = GLOBAL_GET("physics/3d/solver/persistent_contacts");
+	persistent_contacts_linear_threshold = GLOBAL_GET("physics/3d/solver/persistent_contacts_linear_threshold");
+	persistent_contacts_angular_threshold = GLOBAL_GET("physics/3d/solver/persistent_contacts_angular_threshold");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -1269,9 +1275,12 @@ GodotSpace3D::GodotSpace3D() {
 
 	direct_access = memnew(GodotPhysicsDirectSpaceState3D);
 	direct_access->space = this;
+
+	stepper = memnew(GodotStep3D);
 }
 
 GodotSpace3D::~GodotSpace3D() {
 	memdelete(broadphase);
 	memdelete(direct_access);
+	memdelete(stepper);
 }
@@ -43,6 +43,8 @@
 #include "core/templates/hash_map.h"
 #include "core/typedefs.h"
 
+class GodotStep3D;
+
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
@@ -64,10 +66,13 @@ class GodotSpace3D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_UPDATE_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
+		ELAPSED_TIME_PRE_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_CHECK_SLEEP,
 		ELAPSED_TIME_MAX
 
 	};
@@ -100,6 +105,10 @@ private:
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
 
+	bool persistent_contacts = false;
+	real_t persistent_contacts_linear_threshold = 0.0;
+	real_t persistent_contacts_angular_threshold = 0.0;
+
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
 	};
@@ -118,12 +127,17 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int contact_cache_hits = 0;
+	int contact_cache_misses = 0;
 
 	RID static_global_body;
 
 	Vector<Vector3> contact_debug;
 	int contact_debug_count = 0;
 
+	// Owned per space, so independent spaces can be stepped concurrently.
+	GodotStep3D *stepper = nullptr;
+
 	friend class GodotPhysicsDirectSpaceState3D;
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
@@ -132,6 +146,8 @@ public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
+	_FORCE_INLINE_ GodotStep3D *get_stepper() const { return stepper; }
+
 	void set_default_area(GodotArea3D *p_area) { area = p_area; }
 	GodotArea3D *get_default_area() const { return area; }
 
@@ -165,6 +181,9 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ bool is_using_persistent_contacts() const { return persistent_contacts; }
+	_FORCE_INLINE_ real_t get_persistent_contacts_linear_threshold() const { return persistent_contacts_linear_threshold; }
+	_FORCE_INLINE_ real_t get_persistent_contacts_angular_threshold() const { return persistent_contacts_angular_threshold; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
@@ -191,6 +210,17 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	// Only called from the serial pre-solve phase, no need for atomics.
+	_FORCE_INLINE_ void add_contact_cache_result(bool p_hit) {
+		if (p_hit) {
+			contact_cache_hits++;
+		} else {
+			contact_cache_misses++;
+		}
+	}
+	int get_contact_cache_hits() const { return contact_cache_hits; }
+	int get_contact_cache_misses() const { return contact_cache_misses; }
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
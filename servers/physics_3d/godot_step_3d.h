@@ -33,26 +33,54 @@
 
 #include "godot_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
-	uint64_t _step = 1;
+	// Shared by the steppers of all spaces, so island stamps stay unique when objects change space.
+	static SafeNumeric<uint64_t> step_counter;
+	uint64_t _step = 0;
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool use_thread_pool = true;
 
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies; // Snapshot of the active list, so bodies can be processed by index on threads.
+	LocalVector<uint8_t> body_island_can_sleep;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _sleep_test_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island, bool p_can_sleep) const;
+	void _gather_active_bodies(const SelfList<GodotBody3D>::List *p_body_list);
+
+	// Runs a phase as a WorkerThreadPool group task, or inline when the stepper itself runs on the pool.
+	template <typename M>
+	void _run_phase(M p_method, uint32_t p_count, const String &p_description) {
+		if (!use_thread_pool) {
+			for (uint32_t index = 0; index < p_count; ++index) {
+				(this->*p_method)(index, nullptr);
+			}
+			return;
+		}
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_count, -1, true, p_description);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 public:
+	// Must be disabled when stepping from a WorkerThreadPool task, waiting for nested tasks could deadlock the pool.
+	void set_use_thread_pool(bool p_enable) { use_thread_pool = p_enable; }
+	bool is_using_thread_pool() const { return use_thread_pool; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
@@ -1099,6 +1099,8 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_CONTACT_CACHE_HITS);
+	BIND_ENUM_CONSTANT(INFO_CONTACT_CACHE_MISSES);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
@@ -1137,6 +1139,10 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/persistent_contacts", false);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/persistent_contacts_linear_threshold", PROPERTY_HINT_RANGE, "0,0.01,0.0001,or_greater"), 0.001);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/persistent_contacts_angular_threshold", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater,radians_as_degrees"), 0.001);
+	GLOBAL_DEF_RST("physics/3d/step_spaces_in_parallel", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
@@ -807,7 +807,9 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_CONTACT_CACHE_HITS,
+		INFO_CONTACT_CACHE_MISSES
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -107,6 +107,38 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Memory-mapped read") {
+	const String path = TestUtils::get_data_path("line_endings_lf.test.txt");
+	Error err = OK;
+	Ref<FileAccess> fm = FileAccess::open_mapped(path, &err);
+	if (err == ERR_UNAVAILABLE) {
+		// Not supported on this platform.
+		return;
+	}
+	REQUIRE(fm.is_valid());
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(fm->get_length() == f->get_length());
+	CHECK(fm->get_as_utf8_string() == f->get_as_utf8_string());
+
+	fm->seek(0);
+	CHECK(fm->get_32() == 0x6c6c6548); // "Hell"
+	const uint8_t *view = fm->get_buffer_view(10);
+	REQUIRE(view != nullptr);
+	CHECK(memcmp(view, "o darkness", 10) == 0);
+	CHECK(fm->get_position() == 14);
+
+	CHECK_MESSAGE(fm->get_buffer_view(fm->get_length()) == nullptr, "Views past the end of the file should be rejected.");
+	CHECK(fm->get_position() == 14);
+
+	fm->seek_end(-1);
+	CHECK(fm->get_8() == '\n');
+	CHECK_FALSE(fm->eof_reached());
+	fm->get_8();
+	CHECK(fm->eof_reached());
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/bvh_leaf_cull.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+// Small deterministic generator, so failures can be reproduced.
+static uint32_t _random_state = 1;
+static real_t _random(real_t p_from, real_t p_to) {
+	_random_state = _random_state * 1664525u + 1013904223u;
+	return p_from + (p_to - p_from) * real_t(_random_state >> 8) / real_t(1 << 24);
+}
+
+template <int AXIS_COUNT>
+static void _check_leaf_cull(uint32_t p_count, bool p_with_nan) {
+	const uint32_t stride = ((p_count + BVH_LEAF_CULL_PADDING - 1) / BVH_LEAF_CULL_PADDING) * BVH_LEAF_CULL_PADDING;
+	LocalVector<real_t> mins;
+	LocalVector<real_t> neg_maxs;
+	mins.resize(AXIS_COUNT * stride);
+	neg_maxs.resize(AXIS_COUNT * stride);
+	for (uint32_t i = 0; i < AXIS_COUNT * stride; i++) {
+		real_t min = _random(-10, 10);
+		mins[i] = min;
+		neg_maxs[i] = -(min + _random(0, 4));
+	}
+	if (p_with_nan && p_count) {
+		mins[p_count / 2] = NAN;
+	}
+
+	LocalVector<uint32_t> hits;
+	LocalVector<uint32_t> expected_hits;
+	hits.resize(p_count);
+	expected_hits.resize(p_count);
+
+	bool all_match = true;
+	for (int query = 0; query < 64; query++) {
+		real_t query_max[AXIS_COUNT];
+		real_t query_neg_min[AXIS_COUNT];
+		for (int axis = 0; axis < AXIS_COUNT; axis++) {
+			real_t min = _random(-12, 12);
+			query_max[axis] = min + _random(0, 6);
+			query_neg_min[axis] = -min;
+		}
+		if (query == 0 && p_count) {
+			// Touching boxes count as intersecting.
+			for (int axis = 0; axis < AXIS_COUNT; axis++) {
+				query_max[axis] = mins[axis * stride];
+				query_neg_min[axis] = -mins[axis * stride] - 100;
+			}
+		}
+
+		uint32_t num_hits = BVH_LeafCull<AXIS_COUNT>::cull(mins.ptr(), neg_maxs.ptr(), stride, p_count, query_max, query_neg_min, hits.ptr());
+		uint32_t num_expected_hits = BVH_LeafCull<AXIS_COUNT>::cull_scalar(mins.ptr(), neg_maxs.ptr(), stride, p_count, query_max, query_neg_min, expected_hits.ptr());
+		if (num_hits != num_expected_hits) {
+			all_match = false;
+			continue;
+		}
+		for (uint32_t i = 0; i < num_hits; i++) {
+			all_match &= hits[i] == expected_hits[i];
+		}
+	}
+	CHECK_MESSAGE(all_match, vformat("Leaf cull with %d axes and %d items should match the scalar reference.", AXIS_COUNT, p_count));
+}
+
+TEST_CASE("[BVH] Leaf cull matches the scalar reference") {
+	_random_state = 1;
+	for (uint32_t count : { 0u, 1u, 3u, 4u, 5u, 8u, 13u, 32u, 127u, 128u }) {
+		_check_leaf_cull<3>(count, false);
+		_check_leaf_cull<2>(count, false);
+	}
+	_check_leaf_cull<3>(32, true);
+	_check_leaf_cull<2>(32, true);
+}
+
+struct TestUserFunctions {
+	static bool user_pair_check(const int *p_a, const int *p_b) { return true; }
+	static bool user_cull_check(const int *p_a, const int *p_b) { return true; }
+};
+
+TEST_CASE("[BVH] AABB cull finds every item a brute force test finds") {
+	_random_state = 2;
+	const int count = 2000;
+
+	BVH_Manager<int, 1, false, 128, TestUserFunctions, TestUserFunctions> bvh;
+	LocalVector<int> items;
+	LocalVector<AABB> aabbs;
+	LocalVector<BVHHandle> handles;
+	items.resize(count);
+	aabbs.resize(count);
+	handles.resize(count);
+	for (int i = 0; i < count; i++) {
+		items[i] = i;
+		aabbs[i] = AABB(Vector3(_random(-100, 100), _random(-100, 100), _random(-100, 100)), Vector3(_random(0, 5), _random(0, 5), _random(0, 5)));
+		handles[i] = bvh.create(&items[i], true, 0, 1, aabbs[i]);
+	}
+	// Move some items around, so leaves get items removed and replaced.
+	for (int i = 0; i < count; i += 3) {
+		aabbs[i].position += Vector3(_random(-20, 20), _random(-20, 20), _random(-20, 20));
+		bvh.move(handles[i], aabbs[i]);
+	}
+	bvh.update();
+
+	LocalVector<int *> results;
+	results.resize(count);
+	bool all_match = true;
+	for (int query = 0; query < 50; query++) {
+		AABB query_aabb(Vector3(_random(-100, 100), _random(-100, 100), _random(-100, 100)), Vector3(_random(5, 40), _random(5, 40), _random(5, 40)));
+		int num_results = bvh.cull_aabb(query_aabb, results.ptr(), count, nullptr);
+
+		HashSet<int> found;
+		for (int i = 0; i < num_results; i++) {
+			found.insert(*results[i]);
+		}
+		// Leaves may keep slightly expanded bounds for moved items, so extra hits are allowed, misses are not.
+		BVH_ABB<> query_abb;
+		query_abb.from(query_aabb);
+		for (int i = 0; i < count; i++) {
+			BVH_ABB<> item_abb;
+			item_abb.from(aabbs[i]);
+			if (item_abb.intersects(query_abb)) {
+				all_match &= found.has(i);
+			}
+		}
+		all_match &= found.size() == uint32_t(num_results);
+	}
+	CHECK_MESSAGE(all_match, "Culling the BVH should return every item whose AABB intersects the query, once.");
+
+	for (int i = 0; i < count; i++) {
+		bvh.erase(handles[i]);
+	}
+}
+
+TEST_CASE_BENCHMARK("[BVH] Leaf cull benchmark") {
+	_random_state = 3;
+	const uint32_t stride = 128;
+	const uint32_t leaves = 1024;
+	LocalVector<real_t> mins;
+	LocalVector<real_t> neg_maxs;
+	mins.resize(3 * stride * leaves);
+	neg_maxs.resize(3 * stride * leaves);
+	for (uint32_t i = 0; i < mins.size(); i++) {
+		real_t min = _random(-100, 100);
+		mins[i] = min;
+		neg_maxs[i] = -(min + _random(0, 4));
+	}
+	const real_t query_max[3] = { 10, 10, 10 };
+	const real_t query_neg_min[3] = { 10, 10, 10 };
+	uint32_t hits[stride];
+
+	uint64_t total_hits = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t leaf = 0; leaf < leaves; leaf++) {
+		total_hits += BVH_LeafCull<3>::cull_scalar(&mins[3 * stride * leaf], &neg_maxs[3 * stride * leaf], stride, stride, query_max, query_neg_min, hits);
+	}
+	uint64_t scalar_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t leaf = 0; leaf < leaves; leaf++) {
+		total_hits -= BVH_LeafCull<3>::cull(&mins[3 * stride * leaf], &neg_maxs[3 * stride * leaf], stride, stride, query_max, query_neg_min, hits);
+	}
+	uint64_t simd_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(total_hits == 0);
+	MESSAGE(vformat("Culling %d leaves of %d items: %d usec scalar, %d usec %d wide.", leaves, stride, scalar_time, simd_time, BVH_LeafCull<3>::get_width()));
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -511,6 +511,57 @@ TEST_CASE("[Geometry2D] Merge polygons") {
 	}
 }
 
+static real_t _polygon_area(const Vector<Point2> &p_polygon) {
+	real_t area = 0.0;
+	for (int i = 0; i < p_polygon.size(); i++) {
+		area += p_polygon[i].cross(p_polygon[(i + 1) % p_polygon.size()]);
+	}
+	return area * 0.5;
+}
+
+TEST_CASE("[Geometry2D] Merge and decompose polygons in convex") {
+	Vector<Vector<Point2>> polygons;
+	Vector<Vector<Point2>> r;
+
+	SUBCASE("[Geometry2D] No polygons") {
+		r = Geometry2D::merge_and_decompose_polygons_in_convex(polygons);
+		CHECK_MESSAGE(r.is_empty(), "There are no polygons. The result should be empty.");
+	}
+
+	SUBCASE("[Geometry2D] Grid of adjacent squares") {
+		for (int x = 0; x < 4; x++) {
+			for (int y = 0; y < 4; y++) {
+				polygons.push_back({ Point2(x, y), Point2(x + 1, y), Point2(x + 1, y + 1), Point2(x, y + 1) });
+			}
+		}
+		r = Geometry2D::merge_and_decompose_polygons_in_convex(polygons);
+		REQUIRE_MESSAGE(r.size() == 1, "Adjacent squares should be merged into a single convex polygon.");
+		CHECK_MESSAGE(r[0].size() == 4, "Collinear vertices should be removed from the merged polygon.");
+		CHECK(Math::is_equal_approx(ABS(_polygon_area(r[0])), (real_t)16.0));
+	}
+
+	SUBCASE("[Geometry2D] Ring of squares around a hole") {
+		for (int x = 0; x < 3; x++) {
+			for (int y = 0; y < 3; y++) {
+				if (x == 1 && y == 1) {
+					continue;
+				}
+				polygons.push_back({ Point2(x, y), Point2(x + 1, y), Point2(x + 1, y + 1), Point2(x, y + 1) });
+			}
+		}
+		r = Geometry2D::merge_and_decompose_polygons_in_convex(polygons);
+		REQUIRE_MESSAGE(r.size() > 1, "A polygon with a hole cannot be a single convex polygon.");
+		REQUIRE_MESSAGE(r.size() < 8, "The ring should use fewer convex polygons than the input squares.");
+
+		real_t total_area = 0.0;
+		for (const Vector<Point2> &polygon : r) {
+			total_area += ABS(_polygon_area(polygon));
+			CHECK_FALSE_MESSAGE(Geometry2D::is_point_in_polygon(Point2(1.5, 1.5), polygon), "The hole should not be covered.");
+		}
+		CHECK(Math::is_equal_approx(total_area, (real_t)8.0));
+	}
+}
+
 TEST_CASE("[Geometry2D] Clip polygons") {
 	Vector<Point2> a;
 	Vector<Point2> b;
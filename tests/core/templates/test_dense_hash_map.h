@@ -0,0 +1,211 @@
+/**************************************************************************/
+/*  test_dense_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DENSE_HASH_MAP_H
+#define TEST_DENSE_HASH_MAP_H
+
+#include "core/templates/dense_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDenseHashMap {
+
+TEST_CASE("[DenseHashMap] Insert element") {
+	DenseHashMap<int, int> map;
+	DenseHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Overwrite element") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[DenseHashMap] Erase via key") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(43, 85);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map[43] == 85);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[DenseHashMap] Iteration keeps insertion order across erase") {
+	DenseHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i * 7, i);
+	}
+	for (int i = 0; i < 100; i += 3) {
+		map.erase(i * 7);
+	}
+	map.insert(1000, 1000);
+
+	int previous = -1;
+	uint32_t count = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.value > previous);
+		CHECK(E.value % 3 != 0);
+		previous = E.value;
+		count++;
+	}
+	CHECK(count == map.size());
+	CHECK(previous == 1000);
+}
+
+TEST_CASE("[DenseHashMap] Indexed access") {
+	DenseHashMap<int, int> map;
+	for (int i = 0; i < 50; i++) {
+		map.insert(i, i * 2);
+	}
+	map.erase(10);
+	map.erase(0);
+	map.erase(49);
+
+	CHECK(map.size() == 47);
+	CHECK(map.get_by_index(0).key == 1);
+	CHECK(map.get_by_index(9).key == 11);
+	CHECK(map.get_by_index(46).key == 48);
+	CHECK(map.get_by_index(46).value == 96);
+	CHECK(map[20] == 40);
+}
+
+TEST_CASE("[DenseHashMap] Indexed access doesn't move entries") {
+	DenseHashMap<int, int> map;
+	for (int i = 0; i < 50; i++) {
+		map.insert(i, i * 2);
+	}
+	map.erase(20);
+	int *value = map.getptr(30);
+
+	const DenseHashMap<int, int> &const_map = map;
+	CHECK(const_map.get_by_index(0).key == 0);
+	CHECK(const_map.get_by_index(20).key == 21);
+	CHECK(const_map.get_by_index(48).key == 49);
+	CHECK(map.get_by_index(29).key == 30);
+	CHECK_MESSAGE(value == map.getptr(30), "Reading by index should not compact the entries.");
+	CHECK(&map.get_by_index(29).value == value);
+}
+
+TEST_CASE("[DenseHashMap] Indexed access after erasing from the middle") {
+	DenseHashMap<int, int> map;
+	LocalVector<int> keys;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i);
+		keys.push_back(i);
+	}
+	// Few enough erasures to keep the tombstones around.
+	for (int i = 100; i < 900; i += 7) {
+		map.erase(i);
+		keys.erase(i);
+	}
+	// Grow the entries past their capacity, and erase from the back, with tombstones pending.
+	for (int i = 1000; i < 1200; i++) {
+		map.insert(i, i);
+		keys.push_back(i);
+	}
+	map.erase(1199);
+	keys.erase(1199);
+
+	REQUIRE(map.size() == keys.size());
+	bool matches = true;
+	for (uint32_t i = 0; i < keys.size(); i++) {
+		if (map.get_by_index(i).key != keys[i]) {
+			matches = false;
+			break;
+		}
+	}
+	CHECK(matches);
+	CHECK(map.get_by_index(100).key == 101);
+	CHECK(map.get_by_index(map.size() - 1).key == 1198);
+}
+
+TEST_CASE("[DenseHashMap] Pointers survive growth") {
+	DenseHashMap<int, int> map;
+	int *value = &map[0];
+	*value = 1;
+	for (int i = 1; i < 1000; i++) {
+		map[i] = i;
+	}
+	CHECK(value == map.getptr(0));
+	CHECK(*value == 1);
+}
+
+TEST_CASE("[DenseHashMap] Insert and erase many times") {
+	DenseHashMap<int, int> map;
+	// Use as a queue, so tombstones keep being created at the front.
+	for (int i = 0; i < 10000; i++) {
+		map.insert(i, i);
+		if (i >= 16) {
+			CHECK(map.erase(i - 16));
+		}
+	}
+	CHECK(map.size() == 16);
+	CHECK(map.get_by_index(0).key == 10000 - 16);
+	for (int i = 10000 - 16; i < 10000; i++) {
+		CHECK(map.has(i));
+	}
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(map.begin() == map.end());
+}
+
+TEST_CASE("[DenseHashMap] Copy") {
+	DenseHashMap<int, int> map;
+	map.insert(3, 30);
+	map.insert(1, 10);
+	map.insert(2, 20);
+	map.erase(1);
+
+	const DenseHashMap<int, int> copy = map;
+	CHECK(copy.size() == 2);
+	DenseHashMap<int, int>::ConstIterator it = copy.begin();
+	CHECK(it->key == 3);
+	++it;
+	CHECK(it->key == 2);
+	++it;
+	CHECK(it == copy.end());
+}
+
+} // namespace TestDenseHashMap
+
+#endif // TEST_DENSE_HASH_MAP_H
@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops newest, thieves steal oldest") {
+	WorkStealingDeque<int, 8> deque;
+	CHECK(deque.is_empty());
+
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.is_empty());
+
+	int value = -1;
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+	CHECK(deque.pop(value));
+	CHECK(value == 2);
+
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+	CHECK(deque.is_empty());
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<int, 4> deque;
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	int value = -1;
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.push(4));
+
+	for (int i = 4; i >= 1; i--) {
+		CHECK(deque.pop(value));
+		CHECK(value == i);
+	}
+	CHECK(deque.is_empty());
+}
+
+struct StressState {
+	static constexpr uint32_t ITEM_COUNT = 200000;
+	static constexpr uint32_t THIEF_COUNT = 3;
+
+	WorkStealingDeque<uint32_t, 64> deque;
+	LocalVector<SafeNumeric<uint32_t>> taken;
+	SafeFlag owner_done;
+	SafeNumeric<uint32_t> stolen;
+
+	void take(uint32_t p_value) {
+		taken[p_value].increment();
+	}
+
+	static void owner_loop(void *p_state) {
+		StressState *state = (StressState *)p_state;
+		uint32_t value;
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			while (!state->deque.push(i)) {
+				// Full, make room like a pool thread running its own tasks would.
+				if (state->deque.pop(value)) {
+					state->take(value);
+				}
+			}
+			// Pop now and then, so the owner races the thieves for the last elements too.
+			if (i % 3 == 0 && state->deque.pop(value)) {
+				state->take(value);
+			}
+		}
+		while (state->deque.pop(value)) {
+			state->take(value);
+		}
+		state->owner_done.set();
+	}
+
+	static void thief_loop(void *p_state) {
+		StressState *state = (StressState *)p_state;
+		uint32_t value;
+		while (!state->owner_done.is_set() || !state->deque.is_empty()) {
+			if (state->deque.steal(value)) {
+				state->take(value);
+				state->stolen.increment();
+			}
+		}
+	}
+};
+
+TEST_CASE("[WorkStealingDeque] Concurrent push, pop and steal take every element exactly once") {
+	StressState state;
+	state.taken.resize(StressState::ITEM_COUNT);
+
+	Thread thieves[StressState::THIEF_COUNT];
+	for (uint32_t i = 0; i < StressState::THIEF_COUNT; i++) {
+		thieves[i].start(&StressState::thief_loop, &state);
+	}
+	Thread owner;
+	owner.start(&StressState::owner_loop, &state);
+
+	owner.wait_to_finish();
+	for (uint32_t i = 0; i < StressState::THIEF_COUNT; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	uint32_t missing = 0;
+	uint32_t duplicated = 0;
+	for (uint32_t i = 0; i < StressState::ITEM_COUNT; i++) {
+		const uint32_t count = state.taken[i].get();
+		missing += count == 0 ? 1 : 0;
+		duplicated += count > 1 ? 1 : 0;
+	}
+	CHECK_MESSAGE(missing == 0, "Every pushed element should be popped or stolen.");
+	CHECK_MESSAGE(duplicated == 0, "No element should be popped or stolen twice.");
+	CHECK(state.deque.is_empty());
+	MESSAGE(vformat("%d of %d elements were stolen.", state.stolen.get(), StressState::ITEM_COUNT));
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
@@ -173,6 +173,69 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_tiny_subtask(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_spawning_task(void *p_arg) {
+	// Pool threads posting and waiting on many tiny tasks is the case the per-thread deques are for.
+	const int subtask_count = (int)(uint64_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> subtasks;
+	subtasks.resize(subtask_count);
+	for (int i = 0; i < subtask_count; i++) {
+		subtasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_tiny_subtask, nullptr, true);
+	}
+	for (int i = 0; i < subtask_count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(subtasks[i]);
+	}
+	counter[1].increment();
+}
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool] Contention benchmark with tasks spawning many tiny subtasks") {
+	counter.clear();
+	counter.resize(2);
+
+	const int spawner_count = MAX(2, WorkerThreadPool::get_singleton()->get_thread_count() * 2);
+	const int subtask_count = 512;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	LocalVector<WorkerThreadPool::TaskID> spawners;
+	spawners.resize(spawner_count);
+	for (int i = 0; i < spawner_count; i++) {
+		spawners[i] = WorkerThreadPool::get_singleton()->add_native_task(static_spawning_task, (void *)(uint64_t)subtask_count, true);
+	}
+	for (int i = 0; i < spawner_count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(spawners[i]);
+	}
+
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(counter[1].get() == spawner_count);
+	CHECK(counter[0].get() == spawner_count * subtask_count);
+	MESSAGE(vformat("%d tasks over %d threads took %d usec.", spawner_count * (subtask_count + 1), WorkerThreadPool::get_singleton()->get_thread_count(), elapsed));
+}
+
+static void static_batched_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Process every element of a large group exactly once") {
+	// Large groups are claimed in batches; none must be skipped or repeated.
+	const int count = 100003;
+	counter.clear();
+	counter.resize(count);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_batched_group_test, nullptr, count, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_run_once = true;
+	for (int i = 0; i < count; i++) {
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -31,6 +31,8 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
 #include "tests/test_macros.h"
 
@@ -537,6 +539,131 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Order and indexed access after erase") {
+	Dictionary d;
+	for (int i = 0; i < 64; i++) {
+		d[i] = i * 10;
+	}
+	for (int i = 0; i < 64; i += 2) {
+		d.erase(i);
+	}
+	d[0] = "zero";
+
+	CHECK(d.size() == 33);
+	CHECK(int(d.get_key_at_index(0)) == 1);
+	CHECK(int(d.get_value_at_index(0)) == 10);
+	CHECK(int(d.get_key_at_index(31)) == 63);
+	CHECK(int(d.get_key_at_index(32)) == 0);
+	CHECK(String(d.get_value_at_index(32)) == "zero");
+	CHECK(d.get_key_at_index(33) == Variant());
+	CHECK(d.get_key_at_index(-1) == Variant());
+
+	int count = 0;
+	int previous = -1;
+	for (const Variant *key = d.next(nullptr); key; key = d.next(key)) {
+		if (count < 32) {
+			CHECK(int(*key) > previous);
+			previous = *key;
+		}
+		count++;
+	}
+	CHECK(count == 33);
+}
+
+TEST_CASE_BENCHMARK("[Dictionary] Insertion, lookup, iteration and erase benchmark") {
+	// Compares against the linked HashMap layout dictionaries used to be backed by.
+	typedef HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> LinkedMap;
+	const int count = 20000;
+	const int indexed_count = 2000;
+	LocalVector<Variant> keys;
+	keys.resize(count);
+	for (int i = 0; i < count; i++) {
+		keys[i] = (i & 1) ? Variant(i) : Variant(itos(i));
+	}
+
+	uint64_t times[2][5] = {};
+	int64_t checksum = 0;
+
+	{
+		LinkedMap map;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			map[keys[i]] = i;
+		}
+		times[0][0] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			checksum += int(map[keys[i]]);
+		}
+		times[0][1] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const KeyValue<Variant, Variant> &E : map) {
+			checksum += int(E.value);
+		}
+		times[0][2] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < indexed_count; i++) {
+			int index = 0;
+			for (const KeyValue<Variant, Variant> &E : map) {
+				if (index++ == i) {
+					checksum -= int(E.value);
+					break;
+				}
+			}
+		}
+		times[0][3] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			map.erase(keys[i]);
+		}
+		times[0][4] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	{
+		Dictionary d;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			d[keys[i]] = i;
+		}
+		times[1][0] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			checksum -= int(d[keys[i]]);
+		}
+		times[1][1] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const Variant *key = d.next(nullptr); key; key = d.next(key)) {
+			checksum -= int(*d.getptr(*key));
+		}
+		times[1][2] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < indexed_count; i++) {
+			checksum += int(d.get_value_at_index(i));
+		}
+		times[1][3] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			d.erase(keys[i]);
+		}
+		times[1][4] = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(d.is_empty());
+	}
+
+	CHECK(checksum == 0);
+	const char *names[5] = { "insert", "lookup", "iterate", "index", "erase" };
+	for (int i = 0; i < 5; i++) {
+		MESSAGE(vformat("Dictionary %s: %d usec, previous layout: %d usec.", names[i], times[1][i], times[0][i]));
+	}
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
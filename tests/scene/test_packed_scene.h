@@ -215,6 +215,134 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node *_make_plan_test_scene(int p_child_count) {
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	scene->set_process_priority(3);
+	scene->set_process_mode(Node::PROCESS_MODE_ALWAYS);
+	scene->add_to_group("enemies", true);
+
+	for (int i = 0; i < p_child_count; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child" + itos(i));
+		child->set_editor_description("Child number " + itos(i));
+		child->set_physics_process_priority(i);
+		scene->add_child(child);
+		child->set_owner(scene);
+		child->set_unique_name_in_owner(i == 0);
+		child->connect("renamed", Callable(scene, "update_configuration_warnings"), Object::CONNECT_PERSIST);
+	}
+
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Instantiation plan matches regular instantiation") {
+	Node *scene = _make_plan_test_scene(2);
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	for (int plans = 0; plans < 2; plans++) {
+		SceneState::set_instantiation_plans_enabled(plans);
+		Node *instance = packed_scene.instantiate();
+		REQUIRE(instance != nullptr);
+
+		CHECK(instance->get_name() == "TestScene");
+		CHECK(instance->get_process_priority() == 3);
+		CHECK(instance->get_process_mode() == Node::PROCESS_MODE_ALWAYS);
+		CHECK(instance->is_in_group("enemies"));
+
+		REQUIRE(instance->get_child_count() == 2);
+		for (int i = 0; i < 2; i++) {
+			Node *child = instance->get_child(i);
+			CHECK(child->get_name() == "Child" + itos(i));
+			CHECK(child->get_editor_description() == "Child number " + itos(i));
+			CHECK(child->get_physics_process_priority() == i);
+			CHECK(child->get_owner() == instance);
+			CHECK(child->is_connected("renamed", Callable(instance, "update_configuration_warnings")));
+		}
+		CHECK(instance->get_node_or_null(NodePath("%Child0")) == instance->get_child(0));
+
+		memdelete(instance);
+	}
+
+	SceneState::set_instantiation_plans_enabled(true);
+	memdelete(scene);
+}
+
+TEST_CASE("[PackedScene] Instance pool") {
+	Node *scene = _make_plan_test_scene(1);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	packed_scene->set_instance_pool_size(2);
+
+	Node *first = packed_scene->instantiate_pooled();
+	Node *second = packed_scene->instantiate_pooled();
+	REQUIRE(first != nullptr);
+	REQUIRE(second != nullptr);
+	CHECK(first != second);
+	CHECK(packed_scene->get_pooled_instance_count() == 0);
+
+	Node *parent = memnew(Node);
+	parent->add_child(first);
+	packed_scene->release_instance(first);
+	CHECK(first->get_parent() == nullptr);
+	packed_scene->release_instance(second);
+	CHECK(packed_scene->get_pooled_instance_count() == 2);
+
+	// Releasing an instance twice must not pool it twice, nor free it when the pool is full.
+	ERR_PRINT_OFF;
+	packed_scene->release_instance(second);
+	ERR_PRINT_ON;
+	CHECK(packed_scene->get_pooled_instance_count() == 2);
+	CHECK_FALSE(second->is_queued_for_deletion());
+
+	// The most recently released instance is reused first.
+	CHECK(packed_scene->instantiate_pooled() == second);
+	CHECK(packed_scene->get_pooled_instance_count() == 1);
+
+	// Instances freed while in the pool are skipped.
+	packed_scene->release_instance(second);
+	memdelete(second);
+	CHECK(packed_scene->instantiate_pooled() == first);
+
+	packed_scene->release_instance(first);
+	packed_scene->clear_instance_pool();
+	CHECK(packed_scene->get_pooled_instance_count() == 0);
+
+	memdelete(parent);
+	memdelete(scene);
+}
+
+TEST_CASE_BENCHMARK("[PackedScene] Instantiation plan benchmark") {
+	const int count = 2000;
+	Node *scene = _make_plan_test_scene(8);
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	uint64_t times[2] = {};
+	for (int plans = 0; plans < 2; plans++) {
+		SceneState::set_instantiation_plans_enabled(plans);
+		LocalVector<Node *> instances;
+		instances.reserve(count);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			instances.push_back(packed_scene.instantiate());
+		}
+		times[plans] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		for (Node *instance : instances) {
+			CHECK(instance->get_child_count() == 8);
+			memdelete(instance);
+		}
+	}
+
+	SceneState::set_instantiation_plans_enabled(true);
+	memdelete(scene);
+	MESSAGE(vformat("Instantiated %d scenes in %d usec with instantiation plans, %d usec without.", count, times[1], times[0]));
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,224 @@
+/**************************************************************************/
+/*  test_tile_map_layer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TILE_MAP_LAYER_H
+#define TEST_TILE_MAP_LAYER_H
+
+#include "core/object/message_queue.h"
+#include "scene/2d/tile_map_layer.h"
+#include "scene/main/window.h"
+#include "scene/resources/image_texture.h"
+
+#include "tests/test_macros.h"
+
+class TestTileMapLayerInternalsAccessor {
+public:
+	static int get_body_count(const TileMapLayer *p_layer) {
+		return p_layer->bodies_coords.size();
+	}
+	static int get_physics_quadrant_count(const TileMapLayer *p_layer) {
+		return p_layer->physics_quadrant_map.size();
+	}
+};
+
+namespace TestTileMapLayer {
+
+// A tile set with a single 16x16 tile, fully covered by a collision polygon.
+inline Ref<TileSet> create_collision_tile_set() {
+	Ref<TileSet> tile_set;
+	tile_set.instantiate();
+	tile_set->set_tile_size(Size2i(16, 16));
+	tile_set->add_physics_layer();
+
+	Ref<TileSetAtlasSource> atlas_source;
+	atlas_source.instantiate();
+	Ref<Image> image = memnew(Image(16, 16, false, Image::FORMAT_RGBA8));
+	atlas_source->set_texture(ImageTexture::create_from_image(image));
+	atlas_source->set_texture_region_size(Vector2i(16, 16));
+	atlas_source->create_tile(Vector2i());
+
+	TileData *tile_data = atlas_source->get_tile_data(Vector2i(), 0);
+	tile_data->add_collision_polygon(0);
+	Vector<Vector2> polygon = { Vector2(-8, -8), Vector2(8, -8), Vector2(8, 8), Vector2(-8, 8) };
+	tile_data->set_collision_polygon_points(0, 0, polygon);
+
+	tile_set->add_source(atlas_source, 0);
+	return tile_set;
+}
+
+inline void fill_cells(TileMapLayer *p_layer, const Rect2i &p_region) {
+	for (int y = p_region.position.y; y < p_region.get_end().y; y++) {
+		for (int x = p_region.position.x; x < p_region.get_end().x; x++) {
+			p_layer->set_cell(Vector2i(x, y), 0, Vector2i());
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Physics quadrants") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_collision_tile_set());
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	fill_cells(layer, Rect2i(0, 0, 8, 8));
+	layer->update_internals();
+	CHECK_MESSAGE(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 64, "Without physics quadrants, each cell should have its own body.");
+
+	layer->set_physics_quadrant_size(4);
+	layer->update_internals();
+	CHECK_MESSAGE(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 4, "Cells should be merged into one body per physics quadrant.");
+	CHECK(TestTileMapLayerInternalsAccessor::get_physics_quadrant_count(layer) == 4);
+
+	SUBCASE("Changing the quadrant size rebuilds every quadrant") {
+		layer->set_physics_quadrant_size(2);
+		layer->update_internals();
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 16);
+		CHECK(TestTileMapLayerInternalsAccessor::get_physics_quadrant_count(layer) == 16);
+
+		layer->set_physics_quadrant_size(4);
+		layer->update_internals();
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 4);
+		CHECK(TestTileMapLayerInternalsAccessor::get_physics_quadrant_count(layer) == 4);
+
+		layer->set_collision_enabled(false);
+		layer->update_internals();
+		CHECK_MESSAGE(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 0, "Disabling collisions should free the bodies of every quadrant.");
+	}
+
+	SUBCASE("Editing a quadrant") {
+		layer->erase_cell(Vector2i(0, 0));
+		layer->update_internals();
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 4);
+
+		for (int y = 0; y < 4; y++) {
+			for (int x = 0; x < 4; x++) {
+				layer->erase_cell(Vector2i(x, y));
+			}
+		}
+		layer->update_internals();
+		CHECK_MESSAGE(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 3, "Emptied quadrants should be freed.");
+		CHECK(TestTileMapLayerInternalsAccessor::get_physics_quadrant_count(layer) == 3);
+	}
+
+	SUBCASE("Leaving the tree frees the bodies") {
+		layer->set_physics_quadrant_size(2);
+		layer->update_internals();
+		SceneTree::get_singleton()->get_root()->remove_child(layer);
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 0);
+		SceneTree::get_singleton()->get_root()->add_child(layer);
+	}
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Update time budget") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_collision_tile_set());
+	layer->set_rendering_quadrant_size(16);
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	// A budget this small lets a single rendering quadrant (256 cells) be updated per frame.
+	layer->set_update_time_budget_usec(1);
+	fill_cells(layer, Rect2i(0, 0, 32, 32));
+	CHECK(layer->has_pending_updates());
+
+	SUBCASE("Modified cells are updated over several frames") {
+		// The end of the frame the cells were modified in.
+		MessageQueue::get_singleton()->flush();
+		int body_count = TestTileMapLayerInternalsAccessor::get_body_count(layer);
+		CHECK_MESSAGE(body_count > 0, "Some cells should be updated in the frame they were modified in.");
+		CHECK_MESSAGE(body_count < 1024, "The update should not be done in a single frame.");
+		CHECK(layer->has_pending_updates());
+
+		int frames = 0;
+		while (layer->has_pending_updates() && frames < 100) {
+			SceneTree::get_singleton()->process(1.0 / 60.0);
+			int new_body_count = TestTileMapLayerInternalsAccessor::get_body_count(layer);
+			CHECK_MESSAGE(new_body_count > body_count, "Each frame should update more cells.");
+			body_count = new_body_count;
+			frames++;
+		}
+		CHECK_FALSE(layer->has_pending_updates());
+		CHECK(frames > 0);
+		CHECK(frames <= 3);
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 1024);
+	}
+
+	SUBCASE("update_internals() ignores the budget") {
+		MessageQueue::get_singleton()->flush();
+		CHECK(layer->has_pending_updates());
+		layer->update_internals();
+		CHECK_FALSE(layer->has_pending_updates());
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 1024);
+	}
+
+	SUBCASE("Leaving the tree discards the pending updates") {
+		MessageQueue::get_singleton()->flush();
+		SceneTree::get_singleton()->get_root()->remove_child(layer);
+		CHECK_FALSE(layer->has_pending_updates());
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 0);
+		SceneTree::get_singleton()->get_root()->add_child(layer);
+	}
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Erase region") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_collision_tile_set());
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	fill_cells(layer, Rect2i(0, 0, 8, 8));
+	layer->update_internals();
+	CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 64);
+
+	SUBCASE("Region smaller than the used cells") {
+		layer->erase_region(Rect2i(2, 2, 4, 4));
+		layer->update_internals();
+		CHECK(layer->get_used_cells().size() == 48);
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 48);
+		CHECK(layer->get_cell_source_id(Vector2i(3, 3)) == TileSet::INVALID_SOURCE);
+		CHECK(layer->get_cell_source_id(Vector2i(1, 1)) == 0);
+	}
+
+	SUBCASE("Region larger than the used cells") {
+		layer->erase_region(Rect2i(-100, 4, 200, 100));
+		layer->update_internals();
+		CHECK(layer->get_used_cells().size() == 32);
+		CHECK(TestTileMapLayerInternalsAccessor::get_body_count(layer) == 32);
+		CHECK(layer->get_cell_source_id(Vector2i(0, 4)) == TileSet::INVALID_SOURCE);
+		CHECK(layer->get_cell_source_id(Vector2i(7, 3)) == 0);
+	}
+
+	memdelete(layer);
+}
+
+} // namespace TestTileMapLayer
+
+#endif // TEST_TILE_MAP_LAYER_H
@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_audio_mix_kernels.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_MIX_KERNELS_H
+#define TEST_AUDIO_MIX_KERNELS_H
+
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "servers/audio/audio_filter_sw.h"
+#include "servers/audio/audio_mix_kernels.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioMixKernels {
+
+// Odd, so the scalar tail of the vectorized loops is covered too.
+constexpr uint32_t FRAME_COUNT = 509;
+
+inline Vector<AudioFrame> make_frames(uint32_t p_count, uint64_t p_seed) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(p_seed);
+
+	Vector<AudioFrame> frames;
+	frames.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		frames.write[i] = AudioFrame(rng->randf_range(-1, 1), rng->randf_range(-1, 1));
+	}
+	return frames;
+}
+
+// The scalar path may be compiled to fused multiply-adds while the vectorized one is not, so allow for rounding differences.
+inline bool frames_match(const Vector<AudioFrame> &p_a, const Vector<AudioFrame> &p_b, float p_tolerance = 1e-5) {
+	for (int i = 0; i < p_a.size(); i++) {
+		if (!Math::is_equal_approx(p_a[i].left, p_b[i].left, p_tolerance) || !Math::is_equal_approx(p_a[i].right, p_b[i].right, p_tolerance)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[AudioMixKernels] Kernels match the scalar path") {
+	const Vector<AudioFrame> src = make_frames(FRAME_COUNT, 1);
+	const AudioFrame vol_start = AudioFrame(0.25, 0.75);
+	const AudioFrame vol_final = AudioFrame(1.0, 0.0);
+
+	Vector<AudioFrame> expected = make_frames(FRAME_COUNT, 2);
+	Vector<AudioFrame> result = expected;
+
+	AudioMixKernels::accumulate_scalar(expected.ptrw(), src.ptr(), FRAME_COUNT);
+	AudioMixKernels::accumulate(result.ptrw(), src.ptr(), FRAME_COUNT);
+	CHECK_MESSAGE(frames_match(expected, result), "Accumulating should match the scalar path.");
+
+	AudioMixKernels::mix_ramp_scalar(expected.ptrw(), src.ptr(), vol_start, vol_final, FRAME_COUNT);
+	AudioMixKernels::mix_ramp(result.ptrw(), src.ptr(), vol_start, vol_final, FRAME_COUNT);
+	CHECK_MESSAGE(frames_match(expected, result), "Mixing with a volume ramp should match the scalar path.");
+
+	AudioMixKernels::apply_ramp_scalar(expected.ptrw(), src.ptr(), vol_start, vol_final, FRAME_COUNT);
+	AudioMixKernels::apply_ramp(result.ptrw(), src.ptr(), vol_start, vol_final, FRAME_COUNT);
+	CHECK_MESSAGE(frames_match(expected, result), "Applying a volume ramp should match the scalar path.");
+
+	CHECK_MESSAGE(result[0].left == src[0].left * vol_start.left, "The ramp should start at the initial volume.");
+	CHECK_MESSAGE(result[0].right == src[0].right * vol_start.right, "The ramp should start at the initial volume.");
+}
+
+TEST_CASE("[AudioMixKernels] Stereo filter matches per-channel processing") {
+	AudioFilterSW filter;
+	filter.set_mode(AudioFilterSW::HIGHSHELF);
+	filter.set_sampling_rate(44100);
+	filter.set_resonance(1);
+	filter.set_gain(-12);
+
+	AudioFilterSW::Processor expected_l, expected_r, result_l, result_r;
+	expected_l.set_filter(&filter);
+	expected_r.set_filter(&filter);
+	result_l.set_filter(&filter);
+	result_r.set_filter(&filter);
+
+	// Several blocks with changing cutoff, so history and coefficient interpolation carry across calls.
+	for (int block = 0; block < 3; block++) {
+		filter.set_cutoff(1000 + block * 2000);
+		expected_l.update_coeffs(FRAME_COUNT);
+		expected_r.update_coeffs(FRAME_COUNT);
+		result_l.update_coeffs(FRAME_COUNT);
+		result_r.update_coeffs(FRAME_COUNT);
+
+		Vector<AudioFrame> expected = make_frames(FRAME_COUNT, 3 + block);
+		Vector<AudioFrame> result = expected;
+
+		expected_l.process(&expected.ptrw()->left, FRAME_COUNT, 2, true);
+		expected_r.process(&expected.ptrw()->right, FRAME_COUNT, 2, true);
+		AudioFilterSW::Processor::process_stereo(&result_l, &result_r, result.ptrw(), FRAME_COUNT, true);
+
+		// Rounding differences accumulate through the filter history.
+		CHECK_MESSAGE(frames_match(expected, result, 1e-4), vformat("Block %d should match per-channel filtering.", block));
+	}
+}
+
+TEST_CASE_BENCHMARK("[AudioMixKernels][Benchmark] Compare vectorized and scalar paths") {
+	const int iterations = 2000;
+	const Vector<AudioFrame> src = make_frames(512, 4);
+	Vector<AudioFrame> dst = make_frames(512, 5);
+	const AudioFrame vol_start = AudioFrame(0.25, 0.75);
+	const AudioFrame vol_final = AudioFrame(1.0, 0.0);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		AudioMixKernels::mix_ramp_scalar(dst.ptrw(), src.ptr(), vol_start, vol_final, 512);
+	}
+	uint64_t scalar_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		AudioMixKernels::mix_ramp(dst.ptrw(), src.ptr(), vol_start, vol_final, 512);
+	}
+	uint64_t kernel_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Ramped mix of %d blocks: scalar %d usec, kernel %d usec (SIMD: %s).", iterations, scalar_time, kernel_time, AudioMixKernels::has_simd() ? "yes" : "no"));
+
+	AudioFilterSW filter;
+	filter.set_mode(AudioFilterSW::HIGHSHELF);
+	filter.set_sampling_rate(44100);
+	filter.set_cutoff(2000);
+	filter.set_resonance(1);
+	filter.set_gain(-12);
+
+	AudioFilterSW::Processor left, right;
+	left.set_filter(&filter);
+	right.set_filter(&filter);
+	left.update_coeffs();
+	right.update_coeffs();
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		left.process(&dst.ptrw()->left, 512, 2);
+		right.process(&dst.ptrw()->right, 512, 2);
+	}
+	scalar_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		AudioFilterSW::Processor::process_stereo(&left, &right, dst.ptrw(), 512);
+	}
+	kernel_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Stereo biquad of %d blocks: per-channel %d usec, stereo kernel %d usec.", iterations, scalar_time, kernel_time));
+}
+
+} // namespace TestAudioMixKernels
+
+#endif // TEST_AUDIO_MIX_KERNELS_H
@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  test_audio_resampler_polyphase.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_RESAMPLER_POLYPHASE_H
+#define TEST_AUDIO_RESAMPLER_POLYPHASE_H
+
+#include "servers/audio/audio_resampler_polyphase.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioResamplerPolyphase {
+
+TEST_CASE("[AudioResamplerPolyphase] Unity gain at DC") {
+	AudioResamplerPolyphase::initialize();
+
+	AudioFrame frames[AudioResamplerPolyphase::TAPS];
+	for (int i = 0; i < AudioResamplerPolyphase::TAPS; i++) {
+		frames[i] = AudioFrame(1.0, -0.5);
+	}
+
+	for (float phase : { 0.0f, 0.25f, 0.5f, 0.999f }) {
+		AudioFrame result = AudioResamplerPolyphase::interpolate(frames, phase);
+		CHECK(result.left == doctest::Approx(1.0));
+		CHECK(result.right == doctest::Approx(-0.5));
+	}
+}
+
+TEST_CASE("[AudioResamplerPolyphase] Resampling a sine wave") {
+	AudioResamplerPolyphase::initialize();
+
+	const double src_rate = 44100.0;
+	const double dst_rate = 48000.0;
+	LocalVector<AudioFrame> src;
+	src.resize(2048);
+	for (uint32_t i = 0; i < src.size(); i++) {
+		src[i] = AudioFrame(Math::sin(Math_TAU * 1000.0 * i / src_rate), Math::sin(Math_TAU * 8000.0 * i / src_rate));
+	}
+
+	double max_error = 0.0;
+	double max_scalar_difference = 0.0;
+	for (int i = 0; i < 1500; i++) {
+		// Interpolated position is between frames TAPS / 2 - 1 and TAPS / 2 of the window.
+		double time = 100.0 + i * src_rate / dst_rate;
+		int frame = int(time);
+		float phase = time - frame;
+		const AudioFrame *window = &src[frame - (AudioResamplerPolyphase::TAPS / 2 - 1)];
+
+		AudioFrame result = AudioResamplerPolyphase::interpolate(window, phase);
+		AudioFrame scalar = AudioResamplerPolyphase::interpolate_scalar(window, phase);
+
+		max_error = MAX(max_error, Math::abs(result.left - Math::sin(Math_TAU * 1000.0 * time / src_rate)));
+		max_error = MAX(max_error, Math::abs(result.right - Math::sin(Math_TAU * 8000.0 * time / src_rate)));
+		max_scalar_difference = MAX(max_scalar_difference, Math::abs(result.left - scalar.left));
+		max_scalar_difference = MAX(max_scalar_difference, Math::abs(result.right - scalar.right));
+	}
+
+	CHECK_MESSAGE(max_error < 0.001, "Resampled sine waves should closely match the analytic signal.");
+	CHECK_MESSAGE(max_scalar_difference < 0.00001, "The vectorized filter should match the scalar filter.");
+}
+
+} // namespace TestAudioResamplerPolyphase
+
+#endif // TEST_AUDIO_RESAMPLER_POLYPHASE_H
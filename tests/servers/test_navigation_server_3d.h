@@ -764,6 +764,55 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find closest points on a large map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+
+		// A flat 32x32 grid of unit quads, enough polygons for the spatial index to have a few levels.
+		const int grid_size = 32;
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				const int i = z * (grid_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(i);
+				polygon.push_back(i + 1);
+				polygon.push_back(i + grid_size + 2);
+				polygon.push_back(i + grid_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(3.5, 5.0, 7.25)).is_equal_approx(Vector3(3.5, 0.0, 7.25)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(30.75, -2.0, 0.5)).is_equal_approx(Vector3(30.75, 0.0, 0.5)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(-5.0, 0.0, 8.5)).is_equal_approx(Vector3(0.0, 0.0, 8.5)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(40.0, 1.0, 40.0)).is_equal_approx(Vector3(32.0, 0.0, 32.0)));
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(16.5, 1.0, 16.5)), region);
+		CHECK(Math::is_equal_approx(Math::abs(navigation_server->map_get_closest_point_normal(map, Vector3(16.5, 1.0, 16.5)).y), (real_t)1.0));
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 1.0, 0.5), Vector3(31.5, 1.0, 31.5), true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[0].is_equal_approx(Vector3(0.5, 0.0, 0.5)));
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(31.5, 0.0, 31.5)));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+static void _set_step_spaces_in_parallel(bool p_enabled) {
+	ProjectSettings::get_singleton()->set_setting("physics/2d/step_spaces_in_parallel", p_enabled);
+	PhysicsServer2D::get_singleton()->init(); // Reads the setting again.
+}
+
+static RID _create_space() {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	return space;
+}
+
+static RID _create_rectangle(RID p_space, PhysicsServer2D::BodyMode p_mode, const Vector2 &p_position, const Vector2 &p_half_extents) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID shape = ps->rectangle_shape_create();
+	ps->shape_set_data(shape, p_half_extents);
+	RID body = ps->body_create();
+	ps->body_set_mode(body, p_mode);
+	ps->body_add_shape(body, shape);
+	ps->body_set_space(body, p_space);
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, p_position));
+	return body;
+}
+
+static void _free_body(RID p_body) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID shape = ps->body_get_shape(p_body, 0);
+	ps->free(p_body);
+	ps->free(shape);
+}
+
+static Vector2 _get_position(RID p_body) {
+	return Transform2D(PhysicsServer2D::get_singleton()->body_get_state(p_body, PhysicsServer2D::BODY_STATE_TRANSFORM)).get_origin();
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Step more spaces in parallel than there are threads") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	_set_step_spaces_in_parallel(true);
+
+	// Each space is stepped on a pool thread, its own phases must not wait on the pool.
+	const int space_count = WorkerThreadPool::get_singleton()->get_thread_count() + 2;
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	for (int i = 0; i < space_count; i++) {
+		RID space = _create_space();
+		spaces.push_back(space);
+		bodies.push_back(_create_rectangle(space, PhysicsServer2D::BODY_MODE_STATIC, Vector2(), Vector2(10, 0.5)));
+		bodies.push_back(_create_rectangle(space, PhysicsServer2D::BODY_MODE_RIGID, Vector2(0, 2), Vector2(0.5, 0.5)));
+	}
+
+	for (int i = 0; i < 60; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	for (uint32_t i = 1; i < bodies.size(); i += 2) {
+		const real_t height = _get_position(bodies[i]).y;
+		CHECK_MESSAGE(height == doctest::Approx(1.0).epsilon(0.05), "Every space should have been stepped, the rectangle falls on the floor.");
+	}
+
+	for (const RID &body : bodies) {
+		_free_body(body);
+	}
+	for (const RID &space : spaces) {
+		ps->free(space);
+	}
+	_set_step_spaces_in_parallel(false);
+}
+
+// Drops rectangles on a floor in a few identical spaces, and returns the state of the rectangles once they came to rest.
+static void _simulate_falling_rectangles(bool p_spaces_in_parallel, LocalVector<Transform2D> &r_transforms, LocalVector<bool> &r_sleeping) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	_set_step_spaces_in_parallel(p_spaces_in_parallel);
+
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 3; i++) {
+		RID space = _create_space();
+		spaces.push_back(space);
+		bodies.push_back(_create_rectangle(space, PhysicsServer2D::BODY_MODE_STATIC, Vector2(), Vector2(20, 0.5)));
+		// Separate islands, so the phases of each step have several elements to process.
+		for (int j = 0; j < 4; j++) {
+			bodies.push_back(_create_rectangle(space, PhysicsServer2D::BODY_MODE_RIGID, Vector2(j * 4 - 12, 2 + j * 0.5), Vector2(0.5, 0.5)));
+		}
+		// A small stack, with rotated rectangles so they tumble before settling.
+		for (int j = 0; j < 3; j++) {
+			RID rectangle = _create_rectangle(space, PhysicsServer2D::BODY_MODE_RIGID, Vector2(), Vector2(0.5, 0.5));
+			ps->body_set_state(rectangle, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(j * 0.3, Vector2(6, 1.5 + j * 1.2)));
+			bodies.push_back(rectangle);
+		}
+	}
+
+	for (int i = 0; i < 240; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	r_transforms.clear();
+	r_sleeping.clear();
+	for (const RID &body : bodies) {
+		r_transforms.push_back(ps->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM));
+		r_sleeping.push_back(ps->body_get_state(body, PhysicsServer2D::BODY_STATE_SLEEPING));
+	}
+
+	for (const RID &body : bodies) {
+		_free_body(body);
+	}
+	for (const RID &space : spaces) {
+		ps->free(space);
+	}
+	_set_step_spaces_in_parallel(false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Stepping spaces in parallel gives the same results as stepping them serially") {
+	// Serially stepped spaces run the phases of each step on the thread pool, spaces stepped in parallel run them inline.
+	LocalVector<Transform2D> serial_transforms;
+	LocalVector<bool> serial_sleeping;
+	_simulate_falling_rectangles(false, serial_transforms, serial_sleeping);
+	LocalVector<Transform2D> parallel_transforms;
+	LocalVector<bool> parallel_sleeping;
+	_simulate_falling_rectangles(true, parallel_transforms, parallel_sleeping);
+
+	REQUIRE(serial_transforms.size() == parallel_transforms.size());
+	for (uint32_t i = 0; i < serial_transforms.size(); i++) {
+		CHECK_MESSAGE(serial_transforms[i].is_equal_approx(parallel_transforms[i]), vformat("Body %d should end up at the same place.", i));
+		CHECK_MESSAGE(serial_sleeping[i] == parallel_sleeping[i], vformat("Body %d should have the same sleep state.", i));
+	}
+	for (uint32_t i = 1; i < 5; i++) {
+		CHECK_MESSAGE(serial_sleeping[i], "Rectangles resting on the floor should fall asleep.");
+	}
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,238 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+static void _set_step_spaces_in_parallel(bool p_enabled) {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/step_spaces_in_parallel", p_enabled);
+	PhysicsServer3D::get_singleton()->init(); // Reads the setting again.
+}
+
+static RID _create_space() {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	return space;
+}
+
+static RID _create_box(RID p_space, PhysicsServer3D::BodyMode p_mode, const Vector3 &p_position, const Vector3 &p_half_extents) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID shape = ps->box_shape_create();
+	ps->shape_set_data(shape, p_half_extents);
+	RID body = ps->body_create();
+	ps->body_set_mode(body, p_mode);
+	ps->body_add_shape(body, shape);
+	ps->body_set_space(body, p_space);
+	ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	return body;
+}
+
+static void _free_body(RID p_body) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID shape = ps->body_get_shape(p_body, 0);
+	ps->free(p_body);
+	ps->free(shape);
+}
+
+static Vector3 _get_position(RID p_body) {
+	return Transform3D(PhysicsServer3D::get_singleton()->body_get_state(p_body, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Step more spaces in parallel than there are threads") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	_set_step_spaces_in_parallel(true);
+
+	// Each space is stepped on a pool thread, its own phases must not wait on the pool.
+	const int space_count = WorkerThreadPool::get_singleton()->get_thread_count() + 2;
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	for (int i = 0; i < space_count; i++) {
+		RID space = _create_space();
+		spaces.push_back(space);
+		bodies.push_back(_create_box(space, PhysicsServer3D::BODY_MODE_STATIC, Vector3(), Vector3(10, 0.5, 10)));
+		bodies.push_back(_create_box(space, PhysicsServer3D::BODY_MODE_RIGID, Vector3(0, 2, 0), Vector3(0.5, 0.5, 0.5)));
+	}
+
+	for (int i = 0; i < 60; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	for (uint32_t i = 1; i < bodies.size(); i += 2) {
+		const real_t height = _get_position(bodies[i]).y;
+		CHECK_MESSAGE(height == doctest::Approx(1.0).epsilon(0.05), "Every space should have been stepped, the box falls on the floor.");
+	}
+
+	for (const RID &body : bodies) {
+		_free_body(body);
+	}
+	for (const RID &space : spaces) {
+		ps->free(space);
+	}
+	_set_step_spaces_in_parallel(false);
+}
+
+// Drops boxes on a floor in a few identical spaces, and returns the state of the boxes once they came to rest.
+static void _simulate_falling_boxes(bool p_spaces_in_parallel, LocalVector<Transform3D> &r_transforms, LocalVector<bool> &r_sleeping) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	_set_step_spaces_in_parallel(p_spaces_in_parallel);
+
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 3; i++) {
+		RID space = _create_space();
+		spaces.push_back(space);
+		bodies.push_back(_create_box(space, PhysicsServer3D::BODY_MODE_STATIC, Vector3(), Vector3(20, 0.5, 20)));
+		// Separate islands, so the phases of each step have several elements to process.
+		for (int j = 0; j < 4; j++) {
+			bodies.push_back(_create_box(space, PhysicsServer3D::BODY_MODE_RIGID, Vector3(j * 4 - 6, 2 + j * 0.5, 0), Vector3(0.5, 0.5, 0.5)));
+		}
+		// A small stack, with rotated boxes so they tumble before settling.
+		for (int j = 0; j < 3; j++) {
+			RID box = _create_box(space, PhysicsServer3D::BODY_MODE_RIGID, Vector3(), Vector3(0.5, 0.5, 0.5));
+			ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), j * 0.3), Vector3(0, 1.5 + j * 1.2, 6)));
+			bodies.push_back(box);
+		}
+	}
+
+	for (int i = 0; i < 240; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	r_transforms.clear();
+	r_sleeping.clear();
+	for (const RID &body : bodies) {
+		r_transforms.push_back(ps->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		r_sleeping.push_back(ps->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING));
+	}
+
+	for (const RID &body : bodies) {
+		_free_body(body);
+	}
+	for (const RID &space : spaces) {
+		ps->free(space);
+	}
+	_set_step_spaces_in_parallel(false);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Stepping spaces in parallel gives the same results as stepping them serially") {
+	// Serially stepped spaces run the phases of each step on the thread pool, spaces stepped in parallel run them inline.
+	LocalVector<Transform3D> serial_transforms;
+	LocalVector<bool> serial_sleeping;
+	_simulate_falling_boxes(false, serial_transforms, serial_sleeping);
+	LocalVector<Transform3D> parallel_transforms;
+	LocalVector<bool> parallel_sleeping;
+	_simulate_falling_boxes(true, parallel_transforms, parallel_sleeping);
+
+	REQUIRE(serial_transforms.size() == parallel_transforms.size());
+	for (uint32_t i = 0; i < serial_transforms.size(); i++) {
+		CHECK_MESSAGE(serial_transforms[i].is_equal_approx(parallel_transforms[i]), vformat("Body %d should end up at the same place.", i));
+		CHECK_MESSAGE(serial_sleeping[i] == parallel_sleeping[i], vformat("Body %d should have the same sleep state.", i));
+	}
+	for (uint32_t i = 1; i < 5; i++) {
+		CHECK_MESSAGE(serial_sleeping[i], "Boxes resting on the floor should fall asleep.");
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Persistent contacts") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	// Read when spaces are created.
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/persistent_contacts", true);
+	RID space = _create_space();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/persistent_contacts", false);
+
+	LocalVector<RID> bodies;
+	bodies.push_back(_create_box(space, PhysicsServer3D::BODY_MODE_STATIC, Vector3(), Vector3(2, 0.5, 2)));
+
+	SUBCASE("A resting stack stays stable") {
+		for (int i = 0; i < 3; i++) {
+			RID box = _create_box(space, PhysicsServer3D::BODY_MODE_RIGID, Vector3(0, 1 + i, 0), Vector3(0.5, 0.5, 0.5));
+			// Keep the stack awake, so it relies on the cached contacts for the whole test.
+			ps->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			bodies.push_back(box);
+		}
+
+		int hits = 0;
+		for (int i = 0; i < 300; i++) {
+			ps->step(1.0 / 60.0);
+			hits += ps->get_process_info(PhysicsServer3D::INFO_CONTACT_CACHE_HITS);
+		}
+		CHECK_MESSAGE(hits > 0, "The contacts of the resting stack should be reused.");
+
+		for (int i = 0; i < 3; i++) {
+			const Vector3 position = _get_position(bodies[i + 1]);
+			CHECK_MESSAGE(position.distance_to(Vector3(0, 1 + i, 0)) < 0.05, vformat("Box %d of the stack should not drift.", i));
+		}
+	}
+
+	SUBCASE("Contacts are dropped once the bodies moved past the thresholds") {
+		RID box = _create_box(space, PhysicsServer3D::BODY_MODE_RIGID, Vector3(0, 1, 0), Vector3(0.5, 0.5, 0.5));
+		ps->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+		bodies.push_back(box);
+
+		for (int i = 0; i < 60; i++) {
+			ps->step(1.0 / 60.0);
+		}
+		CHECK(ps->get_process_info(PhysicsServer3D::INFO_CONTACT_CACHE_HITS) == 1);
+		CHECK(ps->get_process_info(PhysicsServer3D::INFO_CONTACT_CACHE_MISSES) == 0);
+
+		// Slide the box off the floor, the contacts must follow it and eventually disappear.
+		int misses = 0;
+		for (int i = 0; i < 90; i++) {
+			ps->body_set_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(3, 0, 0));
+			ps->step(1.0 / 60.0);
+			if (i < 30) {
+				misses += ps->get_process_info(PhysicsServer3D::INFO_CONTACT_CACHE_MISSES);
+			}
+		}
+		// Contacts are generated before the bodies move, the first step still reuses them.
+		CHECK_MESSAGE(misses >= 29, "Moving faster than the linear threshold should refresh the contacts every step.");
+		const Vector3 position = _get_position(box);
+		CHECK(position.x > 2.5);
+		CHECK_MESSAGE(position.y < 0.5, "The box should fall once it left the floor, instead of resting on stale contacts.");
+	}
+
+	for (const RID &body : bodies) {
+		_free_body(body);
+	}
+	ps->free(space);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H